@@ -0,0 +1,155 @@
+// ADCT0ATrigger.c
+// Runs on LM4F120/TM4C123
+// Provide functions that initialize TIMER0A to trigger ADC0 SS3
+// conversions and request an interrupt when each conversion is done,
+// or let the uDMA move the samples into two blocks of RAM in ping-pong
+// mode, so the sample instant is set by the timer and no time is spent waiting
+// Based on ADCT0ATrigger.c by Daniel Valvano
+// October 17, 2026
+
+#include "tm4c123gh6pm.h"
+#include "Debug.h"
+#include "uDMA.h"
+#include "ADCT0ATrigger.h"
+
+#define SEQ3_DMA_CHANNEL 17           // ADC0 SS3 request, encoding 0
+#define SEQ3_DMA_CONTROL (UDMA_CHCTL_DSTINC_16 | UDMA_CHCTL_DSTSIZE_16 | UDMA_CHCTL_SRCINC_NONE | \
+                          UDMA_CHCTL_SRCSIZE_16 | UDMA_CHCTL_ARBSIZE_1 | UDMA_CHCTL_XFERMODE_PINGPONG)
+
+void (*SampleTask)(unsigned long sample);              // user function of the sample mode
+void (*BlockTask)(const volatile unsigned short *block); // user function of the block mode, 0 in the sample mode
+volatile unsigned short *Blocks;      // the RAM of both blocks
+unsigned long BlockCount;             // the amount of samples of each block
+
+// Configure PE2 (Ain1), ADC0 SS3 and TIMER0A as its trigger, leaving TIMER0A stopped
+// Inputs:  period in units (1/clockfreq)
+//          mask is the ADC0_IM SS3 bit, 0 when only the uDMA requests the interrupt
+// Outputs: none
+void InitTimer0ATriggerSeq3(unsigned long period, unsigned long mask){ volatile unsigned long delay;
+    SYSCTL_RCGC2_R |= 0x00000010;   // 1) activate clock for Port E
+    delay = SYSCTL_RCGC2_R;         //    allow time for clock to stabilize
+    GPIO_PORTE_DIR_R &= ~0x04;      // 2) make PE2 input
+    GPIO_PORTE_AFSEL_R |= 0x04;     // 3) enable alternate function on PE2
+    GPIO_PORTE_DEN_R &= ~0x04;      // 4) disable digital I/O on PE2
+    GPIO_PORTE_AMSEL_R |= 0x04;     // 5) enable analog function on PE2
+    SYSCTL_RCGC0_R |= 0x00010000;   // 6) activate ADC0
+    SYSCTL_RCGCTIMER_R |= 0x01;     //    activate TIMER0
+    delay = SYSCTL_RCGC2_R;
+    SYSCTL_RCGC0_R &= ~0x00000300;  // 7) configure for 125K
+    TIMER0_CTL_R = 0x00000000;      // 8) disable TIMER0A during setup
+    TIMER0_CTL_R |= 0x00000020;     // 9) enable TIMER0A trigger to ADC
+    TIMER0_CFG_R = 0x00000000;      // 10) configure for 32-bit mode
+    TIMER0_TAMR_R = 0x00000002;     // 11) configure for periodic mode, default down-count settings
+    TIMER0_TAILR_R = period-1;      // 12) reload value
+    TIMER0_TAPR_R = 0;              // 13) bus clock resolution
+    TIMER0_IMR_R = 0x00000000;      // 14) no TIMER0 interrupts, the timeout only triggers the ADC
+    ADC0_SSPRI_R = 0x0123;          // 15) Sequencer 3 is highest priority
+    ADC0_ACTSS_R &= ~0x0008;        // 16) disable sample sequencer 3
+    ADC0_EMUX_R = (ADC0_EMUX_R&0xFFFF0FFF)+0x5000; // 17) seq3 is timer trigger
+    ADC0_SSMUX3_R = (ADC0_SSMUX3_R&0xFFFFFFF0)+1; // 18) channel Ain1 (PE2)
+    ADC0_SSCTL3_R = 0x0006;         // 19) no TS0 D0, yes IE0 END0
+    ADC0_ISC_R = 0x0008;            // 20) clear a completion left by the software trigger
+    ADC0_IM_R = (ADC0_IM_R&~0x0008)|mask; // 21) SS3 interrupts per sample or not
+    ADC0_ACTSS_R |= 0x0008;         // 22) enable sample sequencer 3
+    NVIC_PRI4_R = (NVIC_PRI4_R&0xFFFF00FF)|0x00008000; // 23) priority 4
+    // interrupts enabled in the main program after all devices initialized
+    // vector number 33, interrupt number 17
+    NVIC_EN0_R = 1<<17;             // 24) enable IRQ 17 in NVIC
+}
+
+// This initialization function sets up the ADC according to the
+// following parameters.  Any parameters not explicitly listed
+// below are not modified:
+// Max sample rate: <=125,000 samples/second
+// Sequencer 3 priority: 1st (highest)
+// SS3 triggering event: TIMER0A timeout
+// SS3 1st sample source: Ain1 (PE2)
+// SS3 interrupts: enabled and promoted to controller, priority 4
+// TIMER0 is taken as the trigger, Timer0_Init can't be used with it
+// Inputs:  task is a pointer to a user function, called with each sample
+//          period in units (1/clockfreq)
+// Outputs: none
+void ADC0_InitTimer0ATriggerSeq3_Ch1(void(*task)(unsigned long sample), unsigned long period){
+    SampleTask = task;              // user function
+    BlockTask = 0;
+    InitTimer0ATriggerSeq3(period, 0x0008);
+    TIMER0_CTL_R |= 0x00000001;     // enable TIMER0A
+}
+
+// This initialization function sets up the ADC as the one above, but
+// the samples are moved by the uDMA channel 17 in ping-pong mode
+// Inputs:  task is a pointer to a user function, called with each block
+//          period in units (1/clockfreq)
+//          blocks is the RAM of both blocks, 2*count samples {0 to 4095}
+//          count is the amount of samples of each block {1 to 1024}
+// Outputs: none
+void ADC0_InitTimer0ATriggerSeq3DMA_Ch1(void(*task)(const volatile unsigned short *block), unsigned long period,
+                                        volatile unsigned short *blocks, unsigned long count){
+    BlockTask = task;               // user function
+    Blocks = blocks;
+    BlockCount = count;
+    InitTimer0ATriggerSeq3(period, 0);
+    uDMA_Init();
+    uDMA_AssignChannel(SEQ3_DMA_CHANNEL, 0);
+    uDMA_SetTransfer(SEQ3_DMA_CHANNEL, UDMA_PRIMARY, &ADC0_SSFIFO3_R, &Blocks[0], BlockCount, SEQ3_DMA_CONTROL);
+    uDMA_SetTransfer(SEQ3_DMA_CHANNEL, UDMA_ALTERNATE, &ADC0_SSFIFO3_R, &Blocks[BlockCount], BlockCount, SEQ3_DMA_CONTROL);
+    uDMA_EnableChannel(SEQ3_DMA_CHANNEL);
+    TIMER0_CTL_R |= 0x00000001;     // enable TIMER0A
+}
+
+// ***************** ADC0_SetSeq3Trigger ****************
+// Select the event that triggers the SS3 conversions
+// Inputs:  trigger is one of the ADC_TRIGGER events
+// Outputs: none
+void ADC0_SetSeq3Trigger(unsigned long trigger){
+    ADC0_ACTSS_R &= ~0x0008;        // 1) disable sample sequencer 3
+    ADC0_TSSEL_R &= ~(ADC_TSSEL_PS0_M|ADC_TSSEL_PS1_M); // 2) generators 0 and 1 of PWM0
+    ADC0_EMUX_R = (ADC0_EMUX_R&0xFFFF0FFF)+(trigger<<12); // 3) seq3 trigger event
+    if(trigger == ADC_TRIGGER_TIMER){
+        TIMER0_CTL_R |= 0x00000001; // 4) TIMER0A runs only as the trigger
+    } else{
+        TIMER0_CTL_R &= ~0x00000001;
+    }
+    ADC0_ACTSS_R |= 0x0008;         // 5) enable sample sequencer 3
+}
+
+// ***************** ADC0_SetAveraging ****************
+// Select the hardware averager of ADC0
+// Inputs:  factor is the conversions per sample {1, 2, 4, 8, 16, 32 or 64}
+// Outputs: none
+void ADC0_SetAveraging(unsigned long factor){
+    unsigned long code = 0;
+    unsigned long rate = 0x00000300;    // the rate of ADC0
+    while((code < 6) && ((1UL<<code) < factor)) code++; // log2 of the factor
+    if((SYSCTL_RCGC0_R&0x00020000) && (ADC1_ACTSS_R&0x0001)){
+        rate = 0x00000F00;              // the ADC1 SS0 converts along the ADC0 one,
+        ADC1_SAC_R = code;              //  it is averaged the same to keep the pace
+    }
+    if(code > 0){
+        SYSCTL_RCGC0_R |= rate;         // 1) configure for 1M
+    } else{
+        SYSCTL_RCGC0_R &= ~rate;        // 1) configure for 125K
+    }
+    ADC0_SAC_R = code;              // 2) average 2^code conversions
+}
+
+void ADC0Seq3_Handler(void){
+    unsigned long sample;
+    bool alternate;
+    Debug_TooglePin_2();
+    if(BlockTask != 0){
+        // the structure that finished is the one the uDMA just left, arm it again
+        // right away, the other block lasts longer than any task
+        alternate = uDMA_IsUsingAlternate(SEQ3_DMA_CHANNEL);
+        uDMA_AcknowledgeDone(SEQ3_DMA_CHANNEL);
+        ADC0_ISC_R = 0x0008;        // acknowledge ADC sequence 3 completion
+        uDMA_SetTransfer(SEQ3_DMA_CHANNEL, !alternate, &ADC0_SSFIFO3_R,
+                         alternate ? &Blocks[0] : &Blocks[BlockCount], BlockCount, SEQ3_DMA_CONTROL);
+        (*BlockTask)(alternate ? &Blocks[0] : &Blocks[BlockCount]); // execute user task
+    } else{
+        ADC0_ISC_R = 0x0008;        // acknowledge ADC sequence 3 completion
+        sample = ADC0_SSFIFO3_R&0xFFF; // 12-bit result
+        (*SampleTask)(sample);      // execute user task
+    }
+    Debug_TooglePin_2();
+}
@@ -0,0 +1,69 @@
+// ADCT0ATrigger.h
+// Runs on LM4F120/TM4C123
+// Provide functions that initialize TIMER0A to trigger ADC0 SS3
+// conversions and request an interrupt when each conversion is done,
+// or let the uDMA move the samples into two blocks of RAM in ping-pong
+// mode, so the sample instant is set by the timer and no time is spent waiting
+// Based on ADCT0ATrigger.h by Daniel Valvano
+// October 17, 2026
+
+#ifndef __ADCT0ATRIGGER_H__ // do not include more than once
+#define __ADCT0ATRIGGER_H__
+
+// The ADC_EMUX events that may trigger the SS3 conversions
+#define ADC_TRIGGER_PROCESSOR 0x0     // software, written into ADC0_PSSI_R
+#define ADC_TRIGGER_TIMER     0x5     // TIMER0A timeout
+#define ADC_TRIGGER_PWM0      0x6     // PWM0 generator 0 trigger output
+#define ADC_TRIGGER_PWM1      0x7     // PWM0 generator 1 trigger output
+
+// This initialization function sets up the ADC according to the
+// following parameters.  Any parameters not explicitly listed
+// below are not modified:
+// Max sample rate: <=125,000 samples/second
+// Sequencer 3 priority: 1st (highest)
+// SS3 triggering event: TIMER0A timeout
+// SS3 1st sample source: Ain1 (PE2)
+// SS3 interrupts: enabled and promoted to controller, priority 4
+// TIMER0 is taken as the trigger, Timer0_Init can't be used with it
+// Inputs:  task is a pointer to a user function, called with each sample
+//          period in units (1/clockfreq)
+// Outputs: none
+void ADC0_InitTimer0ATriggerSeq3_Ch1(void(*task)(unsigned long sample), unsigned long period);
+
+// This initialization function sets up the ADC as the one above, but
+// the samples are moved by the uDMA channel 17 in ping-pong mode: the
+// primary structure fills the first block while the alternate one waits
+// with the second, and they swap at every block. The SS3 interrupt is
+// only requested by the uDMA done, once per block, the finished block
+// is passed to the task and stays untouched for the duration of one block.
+// TIMER0 is taken as the trigger, Timer0_Init can't be used with it
+// Inputs:  task is a pointer to a user function, called with each block
+//          period in units (1/clockfreq)
+//          blocks is the RAM of both blocks, 2*count samples {0 to 4095}
+//          count is the amount of samples of each block {1 to 1024}
+// Outputs: none
+void ADC0_InitTimer0ATriggerSeq3DMA_Ch1(void(*task)(const volatile unsigned short *block), unsigned long period,
+                                        volatile unsigned short *blocks, unsigned long count);
+
+// ***************** ADC0_SetSeq3Trigger ****************
+// Select the event that triggers the SS3 conversions, after any of the
+// initializations above. The PWM triggers come from the PWM0 module and
+// TIMER0A only runs while it is the trigger.
+// Inputs:  trigger is one of the ADC_TRIGGER events
+// Outputs: none
+void ADC0_SetSeq3Trigger(unsigned long trigger);
+
+// ***************** ADC0_SetAveraging ****************
+// Select the hardware averager of ADC0 (ADC0_SAC), every sample
+// returned is then the average of factor conversions in a row, one
+// more bit of resolution every 4x. ADC0 runs at 1M while averaging,
+// to keep up with the trigger, and back at 125K without it. It applies
+// to all the ADC0 sequencers, so it must be selected after the other
+// ADC0 initializations, which configure 125K again. While the ADC1
+// SS0 converts along the ADC0 one (ADCT3ATrigger) ADC1 is averaged
+// the same, so the steps of both sequences keep the same pace.
+// Inputs:  factor is the conversions per sample {1, 2, 4, 8, 16, 32 or 64}
+// Outputs: none
+void ADC0_SetAveraging(unsigned long factor);
+
+#endif // __ADCT0ATRIGGER_H__
@@ -0,0 +1,175 @@
+// ADCT3ATrigger.c
+// Runs on LM4F120/TM4C123
+// Provide a function that initializes TIMER3A to trigger the SS0 of
+// both ADC0 and ADC1 at the same time, so the n-th steps of the two
+// sequences start converting together, and requests an interrupt from
+// each sequence, the one that completes the period hands all its samples
+// Based on ADCT0ATrigger.c by Daniel Valvano
+// October 17, 2026
+
+#include "tm4c123gh6pm.h"
+#include "ADCT3ATrigger.h"
+
+// The port of each analog input Ain0 to Ain11 and its pin
+static const unsigned char AinPort[ADC_CHANNEL_TEMP] = {'E', 'E', 'E', 'E', 'D', 'D', 'D', 'D', 'E', 'E', 'B', 'B'};
+static const unsigned char AinPin[ADC_CHANNEL_TEMP]  = {0x08, 0x04, 0x02, 0x01, 0x08, 0x04, 0x02, 0x01, 0x20, 0x10, 0x10, 0x20};
+
+void (*PeriodTask)(const unsigned short *samples); // user function
+unsigned long Count0;                 // the amount of ADC0 steps
+unsigned long Count1;                 // the amount of ADC1 steps
+unsigned short Samples[2*ADC_SEQ0_STEPS]; // the samples of the last period
+unsigned long Expected;               // the sequences of a period, bit 0 ADC0 and bit 1 ADC1
+unsigned long Done;                   // the sequences of the period done so far
+
+// Make the pin of an analog input an analog input, the temperature sensor has none
+// Inputs:  channel is Ain0 to Ain11 or ADC_CHANNEL_TEMP
+// Outputs: none
+void InitAnalogInput(unsigned long channel){ volatile unsigned long delay;
+    unsigned long pin;
+    if(channel >= ADC_CHANNEL_TEMP) return;
+    pin = AinPin[channel];
+    switch(AinPort[channel]){
+        case 'B':
+            SYSCTL_RCGC2_R |= 0x00000002; // 1) activate clock for Port B
+            delay = SYSCTL_RCGC2_R;       //    allow time for clock to stabilize
+            GPIO_PORTB_DIR_R &= ~pin;     // 2) make the pin input
+            GPIO_PORTB_AFSEL_R |= pin;    // 3) enable alternate function on the pin
+            GPIO_PORTB_DEN_R &= ~pin;     // 4) disable digital I/O on the pin
+            GPIO_PORTB_AMSEL_R |= pin;    // 5) enable analog function on the pin
+            break;
+        case 'D':
+            SYSCTL_RCGC2_R |= 0x00000008; // 1) activate clock for Port D
+            delay = SYSCTL_RCGC2_R;       //    allow time for clock to stabilize
+            GPIO_PORTD_DIR_R &= ~pin;     // 2) make the pin input
+            GPIO_PORTD_AFSEL_R |= pin;    // 3) enable alternate function on the pin
+            GPIO_PORTD_DEN_R &= ~pin;     // 4) disable digital I/O on the pin
+            GPIO_PORTD_AMSEL_R |= pin;    // 5) enable analog function on the pin
+            break;
+        default:
+            SYSCTL_RCGC2_R |= 0x00000010; // 1) activate clock for Port E
+            delay = SYSCTL_RCGC2_R;       //    allow time for clock to stabilize
+            GPIO_PORTE_DIR_R &= ~pin;     // 2) make the pin input
+            GPIO_PORTE_AFSEL_R |= pin;    // 3) enable alternate function on the pin
+            GPIO_PORTE_DEN_R &= ~pin;     // 4) disable digital I/O on the pin
+            GPIO_PORTE_AMSEL_R |= pin;    // 5) enable analog function on the pin
+            break;
+    }
+}
+
+// The SSMUX0 and SSCTL0 values of a list of channels, the last step
+// ends the sequence and sets the raw interrupt flag
+// Inputs:  channels is the list of channels
+//          count is the amount of channels {1 to 8}
+//          ctl receives the SSCTL0 value
+// Outputs: the SSMUX0 value
+unsigned long Seq0Steps(const unsigned char *channels, unsigned long count, unsigned long *ctl){
+    unsigned long mux = 0;
+    unsigned long i;
+    *ctl = 0;
+    for(i=0; i<count; i++){
+        InitAnalogInput(channels[i]);
+        if(channels[i] >= ADC_CHANNEL_TEMP){
+            *ctl |= ADC_SSCTL0_TS0<<(4*i); // temperature sensor, the mux is ignored
+        } else{
+            mux |= (unsigned long)channels[i]<<(4*i);
+        }
+    }
+    *ctl |= (ADC_SSCTL0_IE0|ADC_SSCTL0_END0)<<(4*(count-1)); // yes IEn ENDn on the last step
+    return mux;
+}
+
+// This initialization function sets up the SS0 of both ADCs, triggered
+// together by TIMER3A
+// Inputs:  task is a pointer to a user function, called with the samples of each period
+//          period in units (1/clockfreq)
+//          channels0, count0 are the ADC0 channels {1 to 8}
+//          channels1, count1 are the ADC1 channels {0 to 8}
+// Outputs: none
+void ADC01_InitTimer3ATriggerSeq0(void(*task)(const unsigned short *samples), unsigned long period,
+                                  const unsigned char *channels0, unsigned long count0,
+                                  const unsigned char *channels1, unsigned long count1){ volatile unsigned long delay;
+    unsigned long mux0, ctl0, mux1, ctl1;
+    PeriodTask = task;              // user function
+    Count0 = count0;
+    Count1 = count1;
+    Expected = (count1 > 0) ? 0x03 : 0x01;
+    Done = 0;
+    SYSCTL_RCGC0_R |= 0x00030000;   // 1) activate ADC0 and ADC1
+    SYSCTL_RCGCTIMER_R |= 0x08;     //    activate TIMER3
+    delay = SYSCTL_RCGC2_R;
+    if(ADC0_SAC_R&0x07){
+        SYSCTL_RCGC0_R |= 0x00000F00;   // 2) configure both for 1M, ADC0 is averaging
+    } else{
+        SYSCTL_RCGC0_R &= ~0x00000F00;  // 2) configure both for 125K
+    }
+    ADC1_SAC_R = ADC0_SAC_R&0x07;   //    ADC1 averages as ADC0, the steps keep the same pace
+    mux0 = Seq0Steps(channels0, count0, &ctl0); // 3) analog inputs and steps
+    if(count1 > 0) mux1 = Seq0Steps(channels1, count1, &ctl1);
+    TIMER3_CTL_R = 0x00000000;      // 4) disable TIMER3A during setup
+    TIMER3_CTL_R |= 0x00000020;     // 5) enable TIMER3A trigger to ADC
+    TIMER3_CFG_R = 0x00000000;      // 6) configure for 32-bit mode
+    TIMER3_TAMR_R = 0x00000002;     // 7) configure for periodic mode, default down-count settings
+    TIMER3_TAILR_R = period-1;      // 8) reload value
+    TIMER3_TAPR_R = 0;              // 9) bus clock resolution
+    TIMER3_IMR_R = 0x00000000;      // 10) no TIMER3 interrupts, the timeout only triggers the ADCs
+    ADC0_ACTSS_R &= ~0x0001;        // 11) disable ADC0 sample sequencer 0
+    ADC0_EMUX_R = (ADC0_EMUX_R&0xFFFFFFF0)+0x0005; // 12) seq0 is timer trigger
+    ADC0_SSMUX0_R = mux0;           // 13) ADC0 channels
+    ADC0_SSCTL0_R = ctl0;           // 14) ADC0 steps
+    ADC0_ISC_R = 0x0001;            // 15) clear a stale completion
+    ADC0_IM_R |= 0x0001;            // 16) enable SS0 interrupts
+    ADC0_ACTSS_R |= 0x0001;         // 17) enable ADC0 sample sequencer 0
+    if(count1 > 0){
+        ADC1_SSPRI_R = 0x3210;      // 18) ADC1 sequencer 0 is highest priority
+        ADC1_ACTSS_R &= ~0x0001;    // 19) disable ADC1 sample sequencer 0
+        ADC1_EMUX_R = (ADC1_EMUX_R&0xFFFFFFF0)+0x0005; // 20) seq0 is timer trigger
+        ADC1_SSMUX0_R = mux1;       // 21) ADC1 channels
+        ADC1_SSCTL0_R = ctl1;       // 22) ADC1 steps
+        ADC1_ISC_R = 0x0001;        // 23) clear a stale completion
+        ADC1_IM_R |= 0x0001;        // 24) enable SS0 interrupts
+        ADC1_ACTSS_R |= 0x0001;     // 25) enable ADC1 sample sequencer 0
+        NVIC_PRI12_R = (NVIC_PRI12_R&0xFFFFFF00)|0x00000060; // 26) priority 3, as ADC0 SS0
+        // vector number 64, interrupt number 48
+        NVIC_EN1_R = 1<<16;         // 27) enable IRQ 48 in NVIC
+    }
+    NVIC_PRI3_R = (NVIC_PRI3_R&0xFF00FFFF)|0x00600000; // 28) priority 3
+    // interrupts enabled in the main program after all devices initialized
+    // vector number 30, interrupt number 14
+    NVIC_EN0_R = 1<<14;             // 29) enable IRQ 14 in NVIC
+    TIMER3_CTL_R |= 0x00000001;     // 30) enable TIMER3A
+}
+
+// Mark one sequence of the period done, the one that completes the
+// period executes the task. Both SS0 interrupts have the same priority,
+// so neither preempts the other in between. A sequence done again before
+// the other one, which missed a period, starts the period over.
+// Inputs:  sequence is the bit of the ADC, 0x01 ADC0 or 0x02 ADC1
+// Outputs: none
+void SequenceDone(unsigned long sequence){
+    if(Done&sequence){
+        Done = 0;                   // the other sequence missed this period
+    }
+    Done |= sequence;
+    if(Done == Expected){
+        Done = 0;
+        (*PeriodTask)(Samples);     // execute user task
+    }
+}
+
+void ADC0Seq0_Handler(void){
+    unsigned long i;
+    ADC0_ISC_R = 0x0001;            // acknowledge ADC0 sequence 0 completion
+    for(i=0; i<Count0; i++){
+        Samples[i] = ADC0_SSFIFO0_R&0xFFF; // 12-bit results, in the step order
+    }
+    SequenceDone(0x01);
+}
+
+void ADC1Seq0_Handler(void){
+    unsigned long i;
+    ADC1_ISC_R = 0x0001;            // acknowledge ADC1 sequence 0 completion
+    for(i=0; i<Count1; i++){
+        Samples[Count0+i] = ADC1_SSFIFO0_R&0xFFF; // after the ADC0 ones
+    }
+    SequenceDone(0x02);
+}
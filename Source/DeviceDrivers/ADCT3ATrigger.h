@@ -0,0 +1,45 @@
+// ADCT3ATrigger.h
+// Runs on LM4F120/TM4C123
+// Provide a function that initializes TIMER3A to trigger the SS0 of
+// both ADC0 and ADC1 at the same time, so the n-th steps of the two
+// sequences start converting together, and requests an interrupt from
+// each sequence, the one that completes the period hands all its samples
+// Based on ADCT0ATrigger.h by Daniel Valvano
+// October 17, 2026
+
+#ifndef __ADCT3ATRIGGER_H__ // do not include more than once
+#define __ADCT3ATRIGGER_H__
+
+#define ADC_SEQ0_STEPS   8            // the depth of the SS0 of each ADC
+#define ADC_CHANNEL_TEMP 12           // the internal temperature sensor, in place of an Ain
+
+// This initialization function sets up both ADCs according to the
+// following parameters.  Any parameters not explicitly listed
+// below are not modified:
+// Max sample rate: <=125,000 samples/second, 1M while ADC0 averages
+// ADC1 averaging: the same as ADC0, see ADC0_SetAveraging
+// Sequencer 0 priority: 1st (highest) of ADC1, unchanged on ADC0
+// SS0 triggering event: TIMER3A timeout, on both ADCs
+// SS0 sample sources: the lists of channels, Ain0 to Ain11 or ADC_CHANNEL_TEMP
+// SS0 interrupts: both enabled and promoted to controller, priority 3
+// The samples are not simultaneous: each ADC converts its steps one
+// after the other, 8 us apart at 125K, and only the n-th steps of both
+// start together. ADC0 still busy with a conversion of another
+// sequencer when the timer triggers starts its steps that conversion
+// later.
+// Neither interrupt waits for the other ADC, the task is executed by
+// the interrupt of the sequence that ends last.
+// Inputs:  task is a pointer to a user function, called with the samples
+//          of each period, first the count0 of ADC0 and then the count1
+//          of ADC1, each in the order of its list {0 to 4095}
+//          period in units (1/clockfreq)
+//          channels0 is the list of the ADC0 channels
+//          count0 is the amount of the ADC0 channels {1 to 8}
+//          channels1 is the list of the ADC1 channels
+//          count1 is the amount of the ADC1 channels {0 to 8}
+// Outputs: none
+void ADC01_InitTimer3ATriggerSeq0(void(*task)(const unsigned short *samples), unsigned long period,
+                                  const unsigned char *channels0, unsigned long count0,
+                                  const unsigned char *channels1, unsigned long count1);
+
+#endif // __ADCT3ATRIGGER_H__
@@ -8,6 +8,12 @@
 #include "tm4c123gh6pm.h"
 #include "Debug.h"
 
+/* Data Watchpoint and Trace unit registers, used to count core clock cycles */
+#define DWT_CTRL_R              (*((volatile unsigned long *)0xE0001000))
+#define DWT_CYCCNT_R            (*((volatile unsigned long *)0xE0001004))
+#define NVIC_DBG_INT_TRCENA     0x01000000  // Enable the DWT and ITM units
+#define DWT_CTRL_CYCCNTENA      0x00000001  // Enable the cycle counter
+
 /* ***************Debug_Init******************
  * This function performs the pins initialization
  * Input: none
@@ -26,13 +32,46 @@ void Debug_Init(void)
     GPIO_PORTB_DEN_R |= 0x0C;         // enable digital I/O on PB2-3
 }
 
-
+/* ***************Debug_TooglePin_1******************
+ * Toogle PB2 through its masked data address, so the read and the write
+ *  only cover PB2 and a pin written meanwhile by an interrupt is kept
+ * Input: none
+ * Output: none
+ */
 void Debug_TooglePin_1(void)
 {
-    GPIO_PORTB_DATA_R =  (GPIO_PORTB_DATA_R ^ 0x04);
+    GPIO_PORTB_DATA_BITS_R[0x04] ^= 0x04;
 }
 
+/* ***************Debug_TooglePin_2******************
+ * Toogle PB3 through its masked data address
+ * Input: none
+ * Output: none
+ */
 void Debug_TooglePin_2(void)
 {
-    GPIO_PORTB_DATA_R =  (GPIO_PORTB_DATA_R ^ 0x08);
+    GPIO_PORTB_DATA_BITS_R[0x08] ^= 0x08;
+}
+
+/* ***************Debug_CycleCounterInit******************
+ * Start the free running core clock cycle counter (DWT CYCCNT),
+ * used to measure how long a code section takes to execute
+ * Input: none
+ * Output: none
+ */
+void Debug_CycleCounterInit(void)
+{
+    NVIC_DBG_INT_R |= NVIC_DBG_INT_TRCENA; // enable the trace units
+    DWT_CYCCNT_R = 0;                      // restart the count
+    DWT_CTRL_R |= DWT_CTRL_CYCCNTENA;      // start counting core clocks
+}
+
+/* ***************Debug_CycleCounterRead******************
+ * Read the cycle counter, it wraps around every 2^32 clocks (~53s at 80MHz)
+ * Input: none
+ * Output: the current amount of core clock cycles
+ */
+unsigned long Debug_CycleCounterRead(void)
+{
+    return DWT_CYCCNT_R;
 }
@@ -11,6 +11,8 @@
 void Debug_Init(void);
 void Debug_TooglePin_1(void);
 void Debug_TooglePin_2(void);
+void Debug_CycleCounterInit(void);
+unsigned long Debug_CycleCounterRead(void);
 
 
 #endif /* SOURCE_DEVICEDRIVERS_DEBUG_H_ */
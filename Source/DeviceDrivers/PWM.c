@@ -0,0 +1,407 @@
+/*
+ * PWM.c
+ * Runs on TM4C123
+ * Provide functions that drive the PWM0 module generator 0, whose
+ *  A and B outputs are M0PWM0 (PB6) and M0PWM1 (PB7), or the generators
+ *  0, 1 and 2 together as the three legs of a three-phase inverter
+ *
+ * The generator counts down from LOAD to 0. Each output is driven HI
+ *  when the counter is reloaded and LOW when it reaches its comparator,
+ *  so the HI time is (LOAD - CMP) clocks at the start of every period.
+ * The two edge cases that the comparator can't represent (always LOW and
+ *  always HI) are produced by changing the generator actions instead.
+ *
+ * The LOAD and comparator update mode bits select, when set, the globally
+ *  synchronized update: the values written are only applied after a request
+ *  into PWM0_CTL_R. Cleared, they are applied when the counter reaches 0.
+ *
+ * In three-phase mode the generators count up/down, so the pulses are centered
+ *  into the period. Each output A (high side) is HI while the counter is below
+ *  its comparator, and the dead-band generator outputs on B (low side) its
+ *  complement, with a dead time at both edges. The three legs have their
+ *  counters reset together and their updates globally synchronized, so the
+ *  values of a period are applied to the three legs at the very same clock.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "tm4c123gh6pm.h"
+#include "PWM.h"
+
+/* Generator actions: HI on LOAD, LOW on comparator A/B down */
+#define GEN_PULSE_A       0x0000008C
+#define GEN_PULSE_B       0x0000080C
+/* Generator actions: LOW on LOAD, HI on comparator A/B down */
+#define GEN_STREAM_A      0x000000C8
+#define GEN_STREAM_B      0x00000C08
+/* Generator actions: LOW/HI on LOAD, comparators ignored */
+#define GEN_CONSTANT_LOW  0x00000008
+#define GEN_CONSTANT_HI   0x0000000C
+/* Generator actions: HI on zero, LOW on comparator A up, HI on comparator A down */
+#define GEN_CENTERED_A    0x000000E3
+/* Generator actions: LOW/HI on zero and LOAD, comparators ignored */
+#define GEN_LEG_LOW       0x0000000A
+#define GEN_LEG_HI        0x0000000F
+/* The outputs M0PWM0-5 of the three-phase legs */
+#define THREE_PHASE_OUTPUTS 0x3F
+/* The longest dead time the 12 bits dead-band generator can insert, in PWM clocks */
+#define MAX_DEAD_TIME 0x0FFF
+
+void (*PwmPeriodTask)(void);          // user function
+static unsigned short _period = 2;    // the current period in PWM clocks
+static unsigned short _triggerPhase = 0; // the three-phase ADC trigger from the counter = 0 {1/65536 period}
+
+/* Route PB6-7 to the PWM0 generator 0 and run it from the system clock */
+static void PWM0Gen0_PinsInit(void)
+{
+    unsigned long volatile delay;
+    SYSCTL_RCGCPWM_R |= 0x01;             // activate PWM0
+    SYSCTL_RCGCGPIO_R |= 0x02;            // activate port B
+    delay = SYSCTL_RCGCGPIO_R;            // execute some delay
+    GPIO_PORTB_AFSEL_R |= 0xC0;           // enable alt funct on PB6-7
+    GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R&0x00FFFFFF)+0x44000000; // M0PWM0-1 on PB6-7
+    GPIO_PORTB_AMSEL_R &= ~0xC0;          // no analog in PB6-7
+    GPIO_PORTB_DEN_R |= 0xC0;             // enable digital I/O on PB6-7
+    SYSCTL_RCC_R &= ~SYSCTL_RCC_USEPWMDIV;// PWM clock is the system clock
+}
+
+/* ***************PWM0Gen0_Init******************
+ * Initialize the PWM0 generator 0 in count-down mode with the
+ *  PWM clock equal to the system clock (80 MHz). Both outputs start LOW.
+ * Input: task - pointer to the function executed once per period
+ *        period - the period in PWM clocks {2 to 65535}
+ * Output: none
+ */
+void PWM0Gen0_Init(void(*task)(void), unsigned short period)
+{
+    PWM0Gen0_PinsInit();                  // 1) PB6-7 driven by the generator
+    PwmPeriodTask = task;                 //    user function
+    _period = period;
+    PWM0_0_CTL_R = 0;                     // 2) disable and count-down mode
+    PWM0_0_GENA_R = GEN_CONSTANT_LOW;     // 3) both outputs start LOW
+    PWM0_0_GENB_R = GEN_CONSTANT_LOW;
+    PWM0_0_LOAD_R = period - 1;           // 4) reload value
+    PWM0_0_CMPA_R = 0;
+    PWM0_0_CMPB_R = 0;
+    PWM0_0_ISC_R = PWM_0_ISC_INTCNTLOAD;  // 5) clear and arm the counter = LOAD interrupt
+    PWM0_0_INTEN_R = PWM_0_INTEN_INTCNTLOAD;
+    PWM0_INTEN_R |= PWM_INTEN_INTPWM0;
+    NVIC_PRI2_R = NVIC_PRI2_R&0xFF1FFFFF; // 6) priority 0
+    // vector number 26, interrupt number 10
+    NVIC_EN0_R = 1<<10;                   // 7) enable IRQ 10 in NVIC
+    PWM0_0_CTL_R = PWM_0_CTL_GENBUPD_LS   // 8) locally synchronized updates
+                 | PWM_0_CTL_GENAUPD_LS
+                 | PWM_0_CTL_ENABLE;      //     and start PWM0 generator 0
+    PWM0_ENABLE_R |= 0x03;                // 9) enable M0PWM0-1 outputs
+}
+
+/* ***************PWM0Gen0_InitStreamed******************
+ * Initialize the PWM0 generator 0 to have its comparators written by the uDMA.
+ * Each output is LOW from the period start until the counter reaches its
+ *  comparator and HI from there to the period end.
+ * Input: period - the period in PWM clocks {2 to 65535}
+ * Output: none
+ */
+void PWM0Gen0_InitStreamed(unsigned short period)
+{
+    PWM0Gen0_PinsInit();                  // 1) PB6-7 driven by the generator
+    _period = period;
+    PWM0_0_CTL_R = 0;                     // 2) disable and count-down mode
+    PWM0_0_GENA_R = GEN_STREAM_A;         // 3) LOW on LOAD, HI on comparator down
+    PWM0_0_GENB_R = GEN_STREAM_B;
+    PWM0_0_LOAD_R = period - 1;           // 4) reload value
+    PWM0_0_CMPA_R = PWM_STREAM_OFF;       // 5) both outputs start LOW
+    PWM0_0_CMPB_R = PWM_STREAM_OFF;
+    PWM0_0_INTEN_R = 0;                   // 6) no interrupts
+    PWM0_0_CTL_R = PWM_0_CTL_ENABLE;      // 7) start PWM0 generator 0, the update mode bits left
+                                          //    cleared apply LOAD and CMPA/B at counter = 0
+    PWM0_ENABLE_R |= 0x03;                // 8) enable M0PWM0-1 outputs
+}
+
+/* ***************PWM0Gen0_Restart******************
+ * Restart the generator counter from its period
+ * Input: none
+ * Output: none
+ */
+void PWM0Gen0_Restart(void)
+{
+    PWM0_SYNC_R = PWM_SYNC_SYNC0;
+}
+
+/* ***************PWM0Gen0_SetPeriod******************
+ * Update the period, applied at the next period start
+ * Input: period - the period in PWM clocks {2 to 65535}
+ * Output: none
+ */
+void PWM0Gen0_SetPeriod(unsigned short period)
+{
+    _period = period;
+    PWM0_0_LOAD_R = period - 1;
+}
+
+/* ***************PWM0Gen0_SetDutyA******************
+ * Update the HI time of the output A (PB6), applied at the next period start.
+ * Input: width - the HI time in PWM clocks
+ * Output: none
+ */
+void PWM0Gen0_SetDutyA(unsigned short width)
+{
+    if(width == 0)
+    {
+        PWM0_0_GENA_R = GEN_CONSTANT_LOW;
+    }
+    else if(width >= _period)
+    {
+        PWM0_0_GENA_R = GEN_CONSTANT_HI;
+    }
+    else
+    {
+        PWM0_0_CMPA_R = _period - 1 - width;
+        PWM0_0_GENA_R = GEN_PULSE_A;
+    }
+}
+
+/* ***************PWM0Gen0_SetDutyB******************
+ * Update the HI time of the output B (PB7), applied at the next period start.
+ * Input: width - the HI time in PWM clocks
+ * Output: none
+ */
+void PWM0Gen0_SetDutyB(unsigned short width)
+{
+    if(width == 0)
+    {
+        PWM0_0_GENB_R = GEN_CONSTANT_LOW;
+    }
+    else if(width >= _period)
+    {
+        PWM0_0_GENB_R = GEN_CONSTANT_HI;
+    }
+    else
+    {
+        PWM0_0_CMPB_R = _period - 1 - width;
+        PWM0_0_GENB_R = GEN_PULSE_B;
+    }
+}
+
+/* ***************PWM0Gen1_InitTrigger******************
+ * Initialize the PWM0 generator 1 as the ADC trigger of the generator 0,
+ *  in count-down mode without outputs
+ * Input: period - the period in PWM clocks {2 to 65535}
+ * Output: none
+ */
+void PWM0Gen1_InitTrigger(unsigned short period)
+{
+    SYSCTL_RCGCPWM_R |= 0x01;             // 1) activate PWM0
+    PWM0_1_CTL_R = 0;                     // 2) disable and count-down mode
+    PWM0_1_GENA_R = 0;                    // 3) no outputs
+    PWM0_1_GENB_R = 0;
+    PWM0_1_LOAD_R = period - 1;           // 4) reload value
+    PWM0_1_CMPA_R = period - 1;           //    trigger at the period start
+    PWM0_1_INTEN_R = PWM_1_INTEN_TRCMPAD; // 5) trigger the ADC on comparator A down
+    PWM0_1_CTL_R = PWM_1_CTL_ENABLE;      // 6) locally synchronized updates
+                                          //    and start PWM0 generator 1
+    PWM0_SYNC_R = PWM_SYNC_SYNC0 | PWM_SYNC_SYNC1; // 7) counters aligned with the generator 0
+}
+
+/* ***************PWM0Gen1_SetTrigger******************
+ * Update the period and the trigger point, applied at the next period start
+ * Input: period - the period in PWM clocks {2 to 65535}
+ *        point - the ADC trigger from the period start {0 to period - 1 PWM clocks}
+ * Output: none
+ */
+void PWM0Gen1_SetTrigger(unsigned short period, unsigned short point)
+{
+    if(point >= period) point = period - 1;
+    PWM0_1_LOAD_R = period - 1;
+    PWM0_1_CMPA_R = period - 1 - point;   // the counter goes down from the LOAD
+}
+
+/* Route PB4-5 and PE4-5 to the PWM0 generators 1 and 2 */
+static void PWM0_LegPinsInit(void)
+{
+    unsigned long volatile delay;
+    SYSCTL_RCGCGPIO_R |= 0x12;            // activate ports B and E
+    delay = SYSCTL_RCGCGPIO_R;            // execute some delay
+    GPIO_PORTB_AFSEL_R |= 0x30;           // enable alt funct on PB4-5
+    GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R&0xFF00FFFF)+0x00440000; // M0PWM2-3 on PB4-5
+    GPIO_PORTB_AMSEL_R &= ~0x30;          // no analog in PB4-5
+    GPIO_PORTB_DEN_R |= 0x30;             // enable digital I/O on PB4-5
+    GPIO_PORTE_AFSEL_R |= 0x30;           // enable alt funct on PE4-5
+    GPIO_PORTE_PCTL_R = (GPIO_PORTE_PCTL_R&0xFF00FFFF)+0x00440000; // M0PWM4-5 on PE4-5
+    GPIO_PORTE_AMSEL_R &= ~0x30;          // no analog in PE4-5
+    GPIO_PORTE_DEN_R |= 0x30;             // enable digital I/O on PE4-5
+}
+
+/* The generator actions of a leg: a comparator at 0 or at LOAD would coincide with the
+ *  zero or the LOAD event, so a leg LOW or HI for the whole period (the six-step) is
+ *  held by the actions on both events instead */
+static unsigned long PWM0_LegActions(unsigned short cmp, unsigned short load)
+{
+    if(cmp == 0) return GEN_LEG_LOW;
+    if(cmp >= load) return GEN_LEG_HI;
+    return GEN_CENTERED_A;
+}
+
+/* ***************PWM0_InitThreePhase******************
+ * Initialize the PWM0 generators 0, 1 and 2 as the legs U, V and W of a
+ *  three-phase inverter, in count up/down mode with the PWM clock equal to
+ *  the system clock (80 MHz). The outputs stay disabled (LOW) until
+ *  PWM0_EnableThreePhase is called.
+ * Input: task - pointer to the function executed once per period
+ *        period - the period in PWM clocks {4 to 65535}
+ *        deadTime - the delay of every rising edge of both leg outputs {PWM clocks}
+ * Output: none
+ */
+void PWM0_InitThreePhase(void(*task)(void), unsigned short period, unsigned short deadTime)
+{
+    PWM0Gen0_PinsInit();                  // 1) PB6-7, PB4-5 and PE4-5 driven by the generators
+    PWM0_LegPinsInit();
+    PwmPeriodTask = task;                 //    user function
+    PWM0_ENABLE_R &= ~THREE_PHASE_OUTPUTS;// 2) outputs disabled
+    PWM0_0_CTL_R = 0;                     // 3) disable the generators
+    PWM0_1_CTL_R = 0;
+    PWM0_2_CTL_R = 0;
+    PWM0_0_GENA_R = GEN_CENTERED_A;       // 4) HI while the counter is below the comparator
+    PWM0_1_GENA_R = GEN_CENTERED_A;
+    PWM0_2_GENA_R = GEN_CENTERED_A;
+    PWM0_0_LOAD_R = period / 2;           // 5) half of the period and 50% duty
+    PWM0_1_LOAD_R = period / 2;
+    PWM0_2_LOAD_R = period / 2;
+    PWM0_0_CMPA_R = period / 4;
+    PWM0_1_CMPA_R = period / 4;
+    PWM0_2_CMPA_R = period / 4;
+    PWM0_SetThreePhaseDeadTime(deadTime); // 6) B is the complement of A, with dead time
+    PWM0_0_DBCTL_R = PWM_0_DBCTL_ENABLE;
+    PWM0_1_DBCTL_R = PWM_0_DBCTL_ENABLE;
+    PWM0_2_DBCTL_R = PWM_0_DBCTL_ENABLE;
+    PWM0_0_ISC_R = PWM_0_ISC_INTCNTZERO;  // 7) clear and arm the counter = 0 interrupt of the leg U
+    PWM0_0_INTEN_R = PWM_0_INTEN_INTCNTZERO;
+    PWM0_INTEN_R |= PWM_INTEN_INTPWM0;
+    NVIC_PRI2_R = NVIC_PRI2_R&0xFF1FFFFF; // 8) priority 0
+    // vector number 26, interrupt number 10
+    NVIC_EN0_R = 1<<10;                   // 9) enable IRQ 10 in NVIC
+    PWM0_0_CTL_R = PWM_0_CTL_CMPAUPD      // 10) globally synchronized updates,
+                 | PWM_0_CTL_GENAUPD_GS   //     the actions of the six-step and
+                 | PWM_0_CTL_CMPBUPD      //     the ADC trigger among them,
+                 | PWM_0_CTL_LOADUPD      //     locally synchronized dead time,
+                 | PWM_0_CTL_DBRISEUPD_LS //     up/down mode
+                 | PWM_0_CTL_DBFALLUPD_LS
+                 | PWM_0_CTL_MODE
+                 | PWM_0_CTL_ENABLE;      //     and start the generators
+    PWM0_1_CTL_R = PWM_0_CTL_CMPAUPD
+                 | PWM_0_CTL_GENAUPD_GS
+                 | PWM_0_CTL_LOADUPD
+                 | PWM_0_CTL_DBRISEUPD_LS
+                 | PWM_0_CTL_DBFALLUPD_LS
+                 | PWM_0_CTL_MODE
+                 | PWM_0_CTL_ENABLE;
+    PWM0_2_CTL_R = PWM_0_CTL_CMPAUPD
+                 | PWM_0_CTL_GENAUPD_GS
+                 | PWM_0_CTL_LOADUPD
+                 | PWM_0_CTL_DBRISEUPD_LS
+                 | PWM_0_CTL_DBFALLUPD_LS
+                 | PWM_0_CTL_MODE
+                 | PWM_0_CTL_ENABLE;
+    PWM0_SYNC_R = PWM_SYNC_SYNC0 | PWM_SYNC_SYNC1 | PWM_SYNC_SYNC2; // 11) counters aligned
+}
+
+/* ***************PWM0_SetThreePhase******************
+ * Update the period and the HI time of the high side of the three legs.
+ * The values are applied to all the legs together, at the next period start.
+ * A HI time of 0 or of the whole period holds the leg LOW or HI, for the six-step.
+ * Input: period - the period in PWM clocks {4 to 65535}
+ *        widthU, widthV, widthW - the HI time of each high side in PWM clocks
+ * Output: none
+ */
+void PWM0_SetThreePhase(unsigned short period, unsigned short widthU, unsigned short widthV, unsigned short widthW)
+{
+    unsigned short load = period / 2;
+    unsigned short cmpU = widthU / 2;
+    unsigned short cmpV = widthV / 2;
+    unsigned short cmpW = widthW / 2;
+
+    if(cmpU > load) cmpU = load;
+    if(cmpV > load) cmpV = load;
+    if(cmpW > load) cmpW = load;
+
+    /* The ADC trigger between the counter = 0 and LOAD, counting up or down */
+    if(_triggerPhase < 0x8000) PWM0_0_CMPB_R = ((unsigned long)_triggerPhase * load) >> 15;
+    else PWM0_0_CMPB_R = ((0x10000UL - _triggerPhase) * load) >> 15;
+
+    PWM0_0_LOAD_R = load;
+    PWM0_1_LOAD_R = load;
+    PWM0_2_LOAD_R = load;
+    PWM0_0_CMPA_R = cmpU;
+    PWM0_1_CMPA_R = cmpV;
+    PWM0_2_CMPA_R = cmpW;
+    PWM0_0_GENA_R = PWM0_LegActions(cmpU, load);
+    PWM0_1_GENA_R = PWM0_LegActions(cmpV, load);
+    PWM0_2_GENA_R = PWM0_LegActions(cmpW, load);
+    PWM0_CTL_R = PWM_CTL_GLOBALSYNC0 | PWM_CTL_GLOBALSYNC1 | PWM_CTL_GLOBALSYNC2;
+}
+
+/* ***************PWM0_SetThreePhaseDeadTime******************
+ * Update the dead time of the three legs, applied at the next period start
+ * Input: deadTime - the delay of every rising edge of both leg outputs {0 to 4095 PWM clocks}
+ * Output: none
+ */
+void PWM0_SetThreePhaseDeadTime(unsigned short deadTime)
+{
+    if(deadTime > MAX_DEAD_TIME) deadTime = MAX_DEAD_TIME;
+    PWM0_0_DBRISE_R = deadTime;
+    PWM0_0_DBFALL_R = deadTime;
+    PWM0_1_DBRISE_R = deadTime;
+    PWM0_1_DBFALL_R = deadTime;
+    PWM0_2_DBRISE_R = deadTime;
+    PWM0_2_DBFALL_R = deadTime;
+}
+
+/* ***************PWM0_SetThreePhaseTrigger******************
+ * Enable or disable the ADC trigger of the three legs, from the generator 0.
+ *  The counter = 0 and LOAD events are exact, any other phase is matched by
+ *  the comparator B, counting up in the first half of the period and down in
+ *  the second one. It is loaded by PWM0_SetThreePhase with the next period.
+ * Input: enable - true to trigger the ADC once per period
+ *        phase - the trigger from the counter = 0 {1/65536 period}
+ * Output: none
+ */
+void PWM0_SetThreePhaseTrigger(bool enable, unsigned short phase)
+{
+    unsigned long trigger;
+
+    _triggerPhase = phase;
+    if(!enable) trigger = 0;
+    else if(phase == 0) trigger = PWM_0_INTEN_TRCNTZERO;
+    else if(phase == 0x8000) trigger = PWM_0_INTEN_TRCNTLOAD;
+    else if(phase < 0x8000) trigger = PWM_0_INTEN_TRCMPBU;
+    else trigger = PWM_0_INTEN_TRCMPBD;
+
+    PWM0_0_INTEN_R = PWM_0_INTEN_INTCNTZERO | trigger;
+}
+
+/* ***************PWM0_EnableThreePhase******************
+ * Enable the six outputs of the three legs
+ * Input: none
+ * Output: none
+ */
+void PWM0_EnableThreePhase(void)
+{
+    PWM0_ENABLE_R |= THREE_PHASE_OUTPUTS;
+}
+
+/* ***************PWM0_DisableThreePhase******************
+ * Disable the six outputs of the three legs, they are held LOW
+ * Input: none
+ * Output: none
+ */
+void PWM0_DisableThreePhase(void)
+{
+    PWM0_ENABLE_R &= ~THREE_PHASE_OUTPUTS;
+}
+
+void PWM0Gen0_Handler(void){
+    PWM0_0_ISC_R = PWM_0_ISC_INTCNTLOAD   // acknowledge counter = LOAD
+                 | PWM_0_ISC_INTCNTZERO;  //  or counter = 0
+    (*PwmPeriodTask)();                   // execute user task
+}
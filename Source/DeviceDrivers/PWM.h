@@ -0,0 +1,148 @@
+/*
+ * PWM.h
+ * Runs on TM4C123
+ * Provide functions that drive the PWM0 module generator 0, whose
+ *  A and B outputs are M0PWM0 (PB6) and M0PWM1 (PB7), or the generators
+ *  0, 1 and 2 together as the three legs of a three-phase inverter:
+ *  U on PB6/PB7, V on PB4/PB5 and W on PE4/PE5 (high side/low side)
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#ifndef SOURCE_DEVICEDRIVERS_PWM_H_
+#define SOURCE_DEVICEDRIVERS_PWM_H_
+
+#include <stdbool.h>
+
+/* A streamed comparator value above any period, that keeps the output LOW */
+#define PWM_STREAM_OFF 0xFFFF
+
+/* ***************PWM0Gen0_Init******************
+ * Initialize the PWM0 generator 0 in count-down mode with the
+ *  PWM clock equal to the system clock (80 MHz). Both outputs start LOW.
+ * LOAD, comparator and generator action updates are locally synchronized,
+ *  so everything written during a period is applied at the start of the next.
+ * The user task is executed at the start of every period (counter = LOAD).
+ * Input: task - pointer to the function executed once per period
+ *        period - the period in PWM clocks {2 to 65535}
+ * Output: none
+ */
+void PWM0Gen0_Init(void(*task)(void), unsigned short period);
+
+/* ***************PWM0Gen0_InitStreamed******************
+ * Initialize the PWM0 generator 0 to have its comparators written by the uDMA.
+ * Each output is LOW from the period start until the counter reaches its
+ *  comparator and HI from there to the period end, so a comparator value of
+ *  (width - 1) outputs width clocks HI and PWM_STREAM_OFF keeps it LOW.
+ * No interrupt is requested and both comparators start as PWM_STREAM_OFF.
+ * Input: period - the period in PWM clocks {2 to 65535}
+ * Output: none
+ */
+void PWM0Gen0_InitStreamed(unsigned short period);
+
+/* ***************PWM0Gen0_Restart******************
+ * Restart the generator counter from its period
+ * Input: none
+ * Output: none
+ */
+void PWM0Gen0_Restart(void);
+
+/* ***************PWM0Gen0_SetPeriod******************
+ * Update the period, applied at the next period start
+ * Input: period - the period in PWM clocks {2 to 65535}
+ * Output: none
+ */
+void PWM0Gen0_SetPeriod(unsigned short period);
+
+/* ***************PWM0Gen0_SetDutyA******************
+ * Update the HI time of the output A (PB6), applied at the next period start.
+ * A width of 0 holds the pin LOW and a width >= period holds it HI.
+ * Input: width - the HI time in PWM clocks
+ * Output: none
+ */
+void PWM0Gen0_SetDutyA(unsigned short width);
+
+/* ***************PWM0Gen0_SetDutyB******************
+ * Update the HI time of the output B (PB7), applied at the next period start.
+ * A width of 0 holds the pin LOW and a width >= period holds it HI.
+ * Input: width - the HI time in PWM clocks
+ * Output: none
+ */
+void PWM0Gen0_SetDutyB(unsigned short width);
+
+/* ***************PWM0Gen1_InitTrigger******************
+ * Initialize the PWM0 generator 1 as the ADC trigger of the generator 0, without
+ *  outputs. Both count down from the same LOAD and their counters are restarted
+ *  together, so as long as they get the same periods they stay aligned. The ADC
+ *  is triggered when the counter reaches the comparator A.
+ * Input: period - the period in PWM clocks {2 to 65535}
+ * Output: none
+ */
+void PWM0Gen1_InitTrigger(unsigned short period);
+
+/* ***************PWM0Gen1_SetTrigger******************
+ * Update the period and the trigger point, applied at the next period start
+ * Input: period - the period in PWM clocks {2 to 65535}
+ *        point - the ADC trigger from the period start {0 to period - 1 PWM clocks}
+ * Output: none
+ */
+void PWM0Gen1_SetTrigger(unsigned short period, unsigned short point);
+
+/* ***************PWM0_InitThreePhase******************
+ * Initialize the PWM0 generators 0, 1 and 2 as the legs U, V and W of a
+ *  three-phase inverter, in count up/down mode with the PWM clock equal to
+ *  the system clock (80 MHz). The low side of each leg is the complement of
+ *  its high side, with a dead time at both edges. The outputs stay disabled
+ *  (LOW) until PWM0_EnableThreePhase is called.
+ * The user task is executed at the start of every period (counter = 0).
+ * Input: task - pointer to the function executed once per period
+ *        period - the period in PWM clocks {4 to 65535}
+ *        deadTime - the delay of every rising edge of both leg outputs {PWM clocks}
+ * Output: none
+ */
+void PWM0_InitThreePhase(void(*task)(void), unsigned short period, unsigned short deadTime);
+
+/* ***************PWM0_SetThreePhase******************
+ * Update the period and the HI time of the high side of the three legs.
+ * The values are applied to all the legs together, at the next period start.
+ * A HI time of 0 or of the whole period holds the leg LOW or HI, for the six-step.
+ * Input: period - the period in PWM clocks {4 to 65535}
+ *        widthU, widthV, widthW - the HI time of each high side in PWM clocks
+ * Output: none
+ */
+void PWM0_SetThreePhase(unsigned short period, unsigned short widthU, unsigned short widthV, unsigned short widthW);
+
+/* ***************PWM0_SetThreePhaseDeadTime******************
+ * Update the dead time of the three legs, applied at the next period start
+ * Input: deadTime - the delay of every rising edge of both leg outputs {0 to 4095 PWM clocks}
+ * Output: none
+ */
+void PWM0_SetThreePhaseDeadTime(unsigned short deadTime);
+
+/* ***************PWM0_SetThreePhaseTrigger******************
+ * Enable or disable the ADC trigger of the three legs, from the generator 0.
+ *  The phase is taken from the counter = 0, the middle of the HI time of the
+ *  high sides, so 0x8000 is the counter = LOAD, the middle of their LOW time.
+ *  Any other phase uses the comparator B, recalculated with every period.
+ * Input: enable - true to trigger the ADC once per period
+ *        phase - the trigger from the counter = 0 {1/65536 period}
+ * Output: none
+ */
+void PWM0_SetThreePhaseTrigger(bool enable, unsigned short phase);
+
+/* ***************PWM0_EnableThreePhase******************
+ * Enable the six outputs of the three legs
+ * Input: none
+ * Output: none
+ */
+void PWM0_EnableThreePhase(void);
+
+/* ***************PWM0_DisableThreePhase******************
+ * Disable the six outputs of the three legs, they are held LOW
+ * Input: none
+ * Output: none
+ */
+void PWM0_DisableThreePhase(void);
+
+#endif /* SOURCE_DEVICEDRIVERS_PWM_H_ */
@@ -0,0 +1,38 @@
+// SWInterrupt.c
+// Runs on LM4F120/TM4C123
+// Use the vector of the ADC1 sequencer 3, which is never used by its
+// ADC, as an interrupt requested by software, so an interrupt can hand
+// a longer task over to a lower priority
+// Based on Timer2.c
+// October 17, 2026
+
+#include "tm4c123gh6pm.h"
+#include "SWInterrupt.h"
+
+#define SW_INTERRUPT_NUMBER 51        // the ADC1 SS3 interrupt, its mask stays off
+
+void (*SWInterruptTask)(void);        // user function
+
+// ***************** SWInterrupt_Init ****************
+// Arm the software interrupt to run user task when requested
+// Inputs:  task is a pointer to a user function
+// Outputs: none
+void SWInterrupt_Init(void(*task)(void)){
+    SWInterruptTask = task;       // user function
+    NVIC_PRI12_R = (NVIC_PRI12_R&0x1FFFFFFF)|0xC0000000; // 1) priority 6, below the ramp tick
+    // interrupts enabled in the main program after all devices initialized
+    // vector number 67, interrupt number 51
+    NVIC_EN1_R = 1<<(SW_INTERRUPT_NUMBER-32); // 2) enable IRQ 51 in NVIC
+}
+
+// ***************** SWInterrupt_Trigger ****************
+// Request the software interrupt
+// Inputs:  none
+// Outputs: none
+void SWInterrupt_Trigger(void){
+    NVIC_SW_TRIG_R = SW_INTERRUPT_NUMBER; // pend IRQ 51
+}
+
+void ADC1Seq3_Handler(void){
+    (*SWInterruptTask)();         // execute user task
+}
@@ -0,0 +1,25 @@
+// SWInterrupt.h
+// Runs on LM4F120/TM4C123
+// Use the vector of the ADC1 sequencer 3, which is never used by its
+// ADC, as an interrupt requested by software, so an interrupt can hand
+// a longer task over to a lower priority
+// Based on Timer2.h
+// October 17, 2026
+
+#ifndef __SWINTERRUPT_H__ // do not include more than once
+#define __SWINTERRUPT_H__
+
+// ***************** SWInterrupt_Init ****************
+// Arm the software interrupt to run user task when requested
+// Inputs:  task is a pointer to a user function
+// Outputs: none
+void SWInterrupt_Init(void(*task)(void));
+
+// ***************** SWInterrupt_Trigger ****************
+// Request the software interrupt, it runs once the interrupts of
+// higher priority return, requests meanwhile run it only once
+// Inputs:  none
+// Outputs: none
+void SWInterrupt_Trigger(void);
+
+#endif // __SWINTERRUPT_H__
@@ -0,0 +1,69 @@
+// Timer1.c
+// Runs on LM4F120/TM4C123
+// Use Timer1 as two 16-bit periodic timers (A and B) that pace
+// uDMA transfers, one request per timeout on each timer
+// Based on Timer0.c by Daniel Valvano
+// October 17, 2026
+
+#include "tm4c123gh6pm.h"
+#include "Timer1.h"
+
+void (*DmaDoneTask)(void);   // user function
+
+// ***************** Timer1_Init ****************
+// Configure TIMER1A and TIMER1B as 16-bit periodic timers with the same
+// period, requesting their uDMA channels at every timeout.
+// Inputs:  task is a pointer to the function executed on the uDMA done
+//          period in units (1/clockfreq) {2 to 65536}
+// Outputs: none
+void Timer1_Init(void(*task)(void), unsigned long period){
+    SYSCTL_RCGCTIMER_R |= 0x02;   // 0) activate TIMER1
+    DmaDoneTask = task;           // user function
+    TIMER1_CTL_R = 0x00000000;    // 1) disable TIMER1A and TIMER1B during setup
+    TIMER1_CFG_R = 0x00000004;    // 2) configure for two 16-bit timers
+    TIMER1_TAMR_R = 0x00000102;   // 3) periodic mode, new period loaded at the next timeout
+    TIMER1_TBMR_R = 0x00000102;
+    TIMER1_TAILR_R = period-1;    // 4) reload value
+    TIMER1_TBILR_R = period-1;
+    TIMER1_TAPR_R = 0;            // 5) bus clock resolution
+    TIMER1_TBPR_R = 0;
+    TIMER1_ICR_R = 0x00000101;    // 6) clear TIMER1A and TIMER1B timeout flags
+    TIMER1_IMR_R = 0x00000000;    // 7) timeouts only request the uDMA
+    NVIC_PRI5_R = (NVIC_PRI5_R&0xFF1FFFFF)|0x00200000; // 8) priority 1
+    // vector number 38, interrupt number 22
+    NVIC_EN0_R = 1<<22;           // 9) enable IRQ 22 in NVIC
+}
+
+// ***************** Timer1_SetPeriod ****************
+// Update the period of both timers, applied at their next timeout
+// Inputs:  period in units (1/clockfreq) {2 to 65536}
+// Outputs: none
+void Timer1_SetPeriod(unsigned long period){
+    TIMER1_TAILR_R = period-1;
+    TIMER1_TBILR_R = period-1;
+}
+
+// ***************** Timer1_Start ****************
+// Restart both timers from their period, at the same clock
+// Inputs:  none
+// Outputs: none
+void Timer1_Start(void){
+    TIMER1_TAV_R = TIMER1_TAILR_R;  // restart the counts
+    TIMER1_TBV_R = TIMER1_TBILR_R;
+    TIMER1_CTL_R = 0x00000101;      // enable TIMER1A and TIMER1B together
+}
+
+// ***************** Timer1_Stop ****************
+// Stop both timers
+// Inputs:  none
+// Outputs: none
+void Timer1_Stop(void){
+    TIMER1_CTL_R = 0x00000000;
+}
+
+// Both timers request at the same clock and the uDMA serves the channel 20
+// first, so the done of the channel 21 is the last one of a timeout
+void Timer1B_Handler(void){
+    TIMER1_ICR_R = 0x00000101;    // acknowledge TIMER1A and TIMER1B timeouts
+    (*DmaDoneTask)();             // execute user task
+}
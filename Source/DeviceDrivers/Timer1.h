@@ -0,0 +1,42 @@
+// Timer1.h
+// Runs on LM4F120/TM4C123
+// Use Timer1 as two 16-bit periodic timers (A and B) that pace
+// uDMA transfers, one request per timeout on each timer
+// Based on Timer0.h by Daniel Valvano
+// October 17, 2026
+
+#ifndef __TIMER1INTS_H__ // do not include more than once
+#define __TIMER1INTS_H__
+
+// ***************** Timer1_Init ****************
+// Configure TIMER1A and TIMER1B as 16-bit periodic timers with the same
+// period. Every timeout requests a transfer on the uDMA channel of the
+// timer (channel 20 for A, 21 for B, encoding 0). No timeout interrupt is
+// armed, the task runs when the uDMA channel 21 completes a transfer, after
+// the channel 20 of the same timeout. The timers are left stopped.
+// Inputs:  task is a pointer to the function executed on the uDMA done
+//          period in units (1/clockfreq) {2 to 65536}
+// Outputs: none
+void Timer1_Init(void(*task)(void), unsigned long period);
+
+// ***************** Timer1_SetPeriod ****************
+// Update the period of both timers, applied at their next timeout
+// (the interval load write mode), like the LOAD of a PWM generator
+// is applied at its next counter = 0
+// Inputs:  period in units (1/clockfreq) {2 to 65536}
+// Outputs: none
+void Timer1_SetPeriod(unsigned long period);
+
+// ***************** Timer1_Start ****************
+// Restart both timers from their period, at the same clock
+// Inputs:  none
+// Outputs: none
+void Timer1_Start(void);
+
+// ***************** Timer1_Stop ****************
+// Stop both timers
+// Inputs:  none
+// Outputs: none
+void Timer1_Stop(void);
+
+#endif // __TIMER1INTS_H__
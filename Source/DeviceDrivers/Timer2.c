@@ -0,0 +1,54 @@
+// Timer2.c
+// Runs on LM4F120/TM4C123
+// Use TIMER2 in 32-bit periodic mode to request interrupts at a periodic rate,
+// the interrupt can be masked while the task data is updated
+// Based on Timer0.c by Daniel Valvano
+// October 17, 2026
+
+#include "tm4c123gh6pm.h"
+#include "Timer2.h"
+
+void (*Timer2Task)(void);     // user function
+
+// ***************** Timer2_Init ****************
+// Activate TIMER2 interrupts to run user task periodically
+// Inputs:  task is a pointer to a user function
+//          period in units (1/clockfreq)
+// Outputs: none
+void Timer2_Init(void(*task)(void), unsigned long period){
+    SYSCTL_RCGCTIMER_R |= 0x04;   // 0) activate TIMER2
+    Timer2Task = task;            // user function
+    TIMER2_CTL_R = 0x00000000;    // 1) disable TIMER2A during setup
+    TIMER2_CFG_R = 0x00000000;    // 2) configure for 32-bit mode
+    TIMER2_TAMR_R = 0x00000002;   // 3) configure for periodic mode, default down-count settings
+    TIMER2_TAILR_R = period-1;    // 4) reload value
+    TIMER2_TAPR_R = 0;            // 5) bus clock resolution
+    TIMER2_ICR_R = 0x00000001;    // 6) clear TIMER2A timeout flag
+    TIMER2_IMR_R = 0x00000001;    // 7) arm timeout interrupt
+    NVIC_PRI5_R = (NVIC_PRI5_R&0x00FFFFFF)|0xA0000000; // 8) priority 5, below the pwm output
+    // interrupts enabled in the main program after all devices initialized
+    // vector number 39, interrupt number 23
+    NVIC_EN0_R = 1<<23;           // 9) enable IRQ 23 in NVIC
+    TIMER2_CTL_R = 0x00000001;    // 10) enable TIMER2A
+}
+
+// ***************** Timer2_DisableInterrupt ****************
+// Mask the TIMER2A interrupt, a timeout meanwhile stays pending
+// Inputs:  none
+// Outputs: none
+void Timer2_DisableInterrupt(void){
+    NVIC_DIS0_R = 1<<23;          // disable IRQ 23 in NVIC
+}
+
+// ***************** Timer2_EnableInterrupt ****************
+// Unmask the TIMER2A interrupt
+// Inputs:  none
+// Outputs: none
+void Timer2_EnableInterrupt(void){
+    NVIC_EN0_R = 1<<23;           // enable IRQ 23 in NVIC
+}
+
+void Timer2A_Handler(void){
+    TIMER2_ICR_R = TIMER_ICR_TATOCINT;// acknowledge TIMER2A timeout
+    (*Timer2Task)();                  // execute user task
+}
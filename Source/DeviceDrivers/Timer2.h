@@ -0,0 +1,30 @@
+// Timer2.h
+// Runs on LM4F120/TM4C123
+// Use Timer2 in 32-bit periodic mode to request interrupts at a periodic rate,
+// the interrupt can be masked while the task data is updated
+// Based on Timer0.h by Daniel Valvano
+// October 17, 2026
+
+#ifndef __TIMER2INTS_H__ // do not include more than once
+#define __TIMER2INTS_H__
+
+// ***************** Timer2_Init ****************
+// Activate Timer2 interrupts to run user task periodically
+// Inputs:  task is a pointer to a user function
+//          period in units (1/clockfreq)
+// Outputs: none
+void Timer2_Init(void(*task)(void), unsigned long period);
+
+// ***************** Timer2_DisableInterrupt ****************
+// Mask the TIMER2A interrupt, a timeout meanwhile stays pending
+// Inputs:  none
+// Outputs: none
+void Timer2_DisableInterrupt(void);
+
+// ***************** Timer2_EnableInterrupt ****************
+// Unmask the TIMER2A interrupt
+// Inputs:  none
+// Outputs: none
+void Timer2_EnableInterrupt(void);
+
+#endif // __TIMER2INTS_H__
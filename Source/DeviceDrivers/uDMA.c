@@ -0,0 +1,148 @@
+/*
+ * uDMA.c
+ * Runs on TM4C123
+ * Provide functions that configure the uDMA controller channels
+ *  used to move data between the peripherals and the memory
+ *  without CPU intervention
+ *
+ * Every channel owns two control structures (primary and alternate) of
+ *  four words: source end pointer, destination end pointer, control word
+ *  and one unused word. The primary ones take the first 512 bytes of the
+ *  table and the alternate ones the last 512 bytes.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "tm4c123gh6pm.h"
+#include "uDMA.h"
+
+/* The position of the alternate control structures into the table */
+#define ALTERNATE_OFFSET 128
+
+/* The channel control table, it must be aligned into a 1024 bytes boundary */
+#pragma DATA_ALIGN(_controlTable, 1024)
+static unsigned long _controlTable[256];
+
+/* ***************uDMA_Init******************
+ * Activate the uDMA controller and point it to the channel control table.
+ * Input: none
+ * Output: none
+ */
+void uDMA_Init(void)
+{
+    unsigned long volatile delay;
+
+    /* Only the first call initializes the controller */
+    if(SYSCTL_RCGCDMA_R & SYSCTL_RCGCDMA_R0) return;
+
+    SYSCTL_RCGCDMA_R |= SYSCTL_RCGCDMA_R0;       // 1) activate the uDMA
+    delay = SYSCTL_RCGCDMA_R;                    //    execute some delay
+    UDMA_CFG_R = UDMA_CFG_MASTEN;                // 2) enable the controller
+    UDMA_CTLBASE_R = (unsigned long)_controlTable; // 3) channel control table
+}
+
+/* ***************uDMA_AssignChannel******************
+ * Assign a peripheral request to a channel, with single and burst requests
+ *  enabled and the default priority. The channel is left disabled.
+ * Input: channel - the channel number {0 to 31}
+ *        encoding - the peripheral encoding of the channel {0 to 4}
+ * Output: none
+ */
+void uDMA_AssignChannel(unsigned long channel, unsigned long encoding)
+{
+    volatile unsigned long *chmap = &UDMA_CHMAP0_R + (channel / 8);
+    unsigned long shift = (channel % 8) * 4;
+    unsigned long mask = 1 << channel;
+
+    UDMA_ENACLR_R = mask;                        // disabled during setup
+    *chmap = (*chmap & ~(0x0F << shift)) | (encoding << shift);
+    UDMA_CHASGN_R &= ~mask;                      // primary assignment
+    UDMA_PRIOCLR_R = mask;                       // default priority
+    UDMA_ALTCLR_R = mask;                        // start from the primary structure
+    UDMA_USEBURSTCLR_R = mask;                   // single and burst requests
+    UDMA_REQMASKCLR_R = mask;                    // allow peripheral requests
+}
+
+/* ***************uDMA_SetTransfer******************
+ * Configure one of the control structures of a channel
+ * The uDMA works with end pointers, so they are calculated here from
+ *  the first item address, the amount of items and the increments.
+ * Input: channel - the channel number {0 to 31}
+ *        alternate - UDMA_PRIMARY or UDMA_ALTERNATE
+ *        source - the address of the first item to be read
+ *        destination - the address of the first item to be written
+ *        count - the amount of items to be transfered {1 to 1024}
+ *        control - the UDMA_CHCTL increment, size, arbitration and mode bits
+ * Output: none
+ */
+void uDMA_SetTransfer(unsigned long channel, bool alternate, volatile void *source,
+                      volatile void *destination, unsigned long count, unsigned long control)
+{
+    unsigned long *entry = &_controlTable[(channel * 4) + (alternate ? ALTERNATE_OFFSET : 0)];
+    unsigned long srcInc = (control & UDMA_CHCTL_SRCINC_M) >> 26;
+    unsigned long dstInc = (control & UDMA_CHCTL_DSTINC_M) >> 30;
+    unsigned long srcEnd = (unsigned long)source;
+    unsigned long dstEnd = (unsigned long)destination;
+
+    /* An increment field of 3 means no increment, otherwise it is log2 of the bytes */
+    if(srcInc != 3) srcEnd += (count - 1) << srcInc;
+    if(dstInc != 3) dstEnd += (count - 1) << dstInc;
+
+    entry[0] = srcEnd;
+    entry[1] = dstEnd;
+    entry[2] = (control & ~UDMA_CHCTL_XFERSIZE_M) | ((count - 1) << UDMA_CHCTL_XFERSIZE_S);
+}
+
+/* ***************uDMA_IsTransferDone******************
+ * Evaluate if a control structure finished its transfer and is now stopped
+ * Input: channel - the channel number {0 to 31}
+ *        alternate - UDMA_PRIMARY or UDMA_ALTERNATE
+ * Output: bool - true when the structure must be configured again
+ */
+bool uDMA_IsTransferDone(unsigned long channel, bool alternate)
+{
+    unsigned long control = _controlTable[(channel * 4) + (alternate ? ALTERNATE_OFFSET : 0) + 2];
+    return ((control & UDMA_CHCTL_XFERMODE_M) == UDMA_CHCTL_XFERMODE_STOP);
+}
+
+/* ***************uDMA_IsUsingAlternate******************
+ * Evaluate which control structure a ping-pong channel is streaming
+ * Input: channel - the channel number {0 to 31}
+ * Output: bool - true when the alternate structure is in use
+ */
+bool uDMA_IsUsingAlternate(unsigned long channel)
+{
+    return ((UDMA_ALTSET_R & (1 << channel)) != 0);
+}
+
+/* ***************uDMA_EnableChannel******************
+ * Enable a channel, starting from its primary control structure
+ * Input: channel - the channel number {0 to 31}
+ * Output: none
+ */
+void uDMA_EnableChannel(unsigned long channel)
+{
+    UDMA_ALTCLR_R = 1 << channel;
+    UDMA_ENASET_R = 1 << channel;
+}
+
+/* ***************uDMA_DisableChannel******************
+ * Disable a channel, its pending requests are ignored
+ * Input: channel - the channel number {0 to 31}
+ * Output: none
+ */
+void uDMA_DisableChannel(unsigned long channel)
+{
+    UDMA_ENACLR_R = 1 << channel;
+}
+
+/* ***************uDMA_AcknowledgeDone******************
+ * Clear the transfer done interrupt of a channel
+ * Input: channel - the channel number {0 to 31}
+ * Output: none
+ */
+void uDMA_AcknowledgeDone(unsigned long channel)
+{
+    UDMA_CHIS_R = 1 << channel;
+}
@@ -0,0 +1,88 @@
+/*
+ * uDMA.h
+ * Runs on TM4C123
+ * Provide functions that configure the uDMA controller channels
+ *  used to move data between the peripherals and the memory
+ *  without CPU intervention
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#ifndef SOURCE_DEVICEDRIVERS_UDMA_H_
+#define SOURCE_DEVICEDRIVERS_UDMA_H_
+
+#include <stdbool.h>
+
+/* Select the primary or the alternate control structure of a channel */
+#define UDMA_PRIMARY   false
+#define UDMA_ALTERNATE true
+
+/* ***************uDMA_Init******************
+ * Activate the uDMA controller and point it to the channel control table.
+ *  It can be called by every module that uses a channel, only the first call
+ *  initializes the controller.
+ * Input: none
+ * Output: none
+ */
+void uDMA_Init(void);
+
+/* ***************uDMA_AssignChannel******************
+ * Assign a peripheral request to a channel, with single and burst requests
+ *  enabled and the default priority. The channel is left disabled.
+ * Input: channel - the channel number {0 to 31}
+ *        encoding - the peripheral encoding of the channel {0 to 4}
+ * Output: none
+ */
+void uDMA_AssignChannel(unsigned long channel, unsigned long encoding);
+
+/* ***************uDMA_SetTransfer******************
+ * Configure one of the control structures of a channel
+ * Input: channel - the channel number {0 to 31}
+ *        alternate - UDMA_PRIMARY or UDMA_ALTERNATE
+ *        source - the address of the first item to be read
+ *        destination - the address of the first item to be written
+ *        count - the amount of items to be transfered {1 to 1024}
+ *        control - the UDMA_CHCTL increment, size, arbitration and mode bits
+ * Output: none
+ */
+void uDMA_SetTransfer(unsigned long channel, bool alternate, volatile void *source,
+                      volatile void *destination, unsigned long count, unsigned long control);
+
+/* ***************uDMA_IsTransferDone******************
+ * Evaluate if a control structure finished its transfer and is now stopped
+ * Input: channel - the channel number {0 to 31}
+ *        alternate - UDMA_PRIMARY or UDMA_ALTERNATE
+ * Output: bool - true when the structure must be configured again
+ */
+bool uDMA_IsTransferDone(unsigned long channel, bool alternate);
+
+/* ***************uDMA_IsUsingAlternate******************
+ * Evaluate which control structure a ping-pong channel is streaming
+ * Input: channel - the channel number {0 to 31}
+ * Output: bool - true when the alternate structure is in use
+ */
+bool uDMA_IsUsingAlternate(unsigned long channel);
+
+/* ***************uDMA_EnableChannel******************
+ * Enable a channel, starting from its primary control structure
+ * Input: channel - the channel number {0 to 31}
+ * Output: none
+ */
+void uDMA_EnableChannel(unsigned long channel);
+
+/* ***************uDMA_DisableChannel******************
+ * Disable a channel, its pending requests are ignored
+ * Input: channel - the channel number {0 to 31}
+ * Output: none
+ */
+void uDMA_DisableChannel(unsigned long channel);
+
+/* ***************uDMA_AcknowledgeDone******************
+ * Clear the transfer done interrupt of a channel
+ * Input: channel - the channel number {0 to 31}
+ * Output: none
+ */
+void uDMA_AcknowledgeDone(unsigned long channel);
+
+#endif /* SOURCE_DEVICEDRIVERS_UDMA_H_ */
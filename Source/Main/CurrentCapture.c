@@ -0,0 +1,278 @@
+/*
+ * CurrentCapture.c
+ *
+ * TIMER0A triggers the ADC0 SS3 at CURRENT_SAMPLE_FREQ and the uDMA moves each sample into one of two
+ *  blocks in ping-pong mode, so the CPU is only interrupted once per block instead of once per sample.
+ *  While the uDMA fills one block the other one is measured and handed to the consumer. The decimation, if
+ *  selected, takes the block from a software interrupt of a lower priority. Its filter is never loaded in place:
+ *  a new one is loaded into the instance not in use and then published, at once, as the one in use.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "../DeviceDrivers/ADCT0ATrigger.h"
+#include "../DeviceDrivers/Debug.h"
+#include "../DeviceDrivers/SWInterrupt.h"
+#include "CurrentCapture.h"
+#include "PwmOutputController.h"
+
+//////////////////////////////////////////////////////////////////////////////
+////////////////      LOCAL FUNCTIONS PROTOTYPES    //////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/* Executed by the ADC0 SS3 interrupt with each finished block */
+void CurrentBlockTask(const volatile unsigned short *block);
+
+/* Executed by the software interrupt to decimate the last finished block */
+void DecimationTask(void);
+
+/* The filter instance that isn't in use, the one a new filter is loaded into */
+DecimationFilter *LoadingFilter(void);
+
+/* The square root of a number, rounded to the nearest */
+unsigned long SquareRoot(unsigned long value);
+
+//////////////////////////////////////////////////////////////////////////////
+/////////////////////      GLOBAL VARIABLE    ////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+static volatile unsigned short _blocks[2 * CURRENT_BLOCK_SAMPLES]; // Both blocks written by the uDMA
+static void (*_consumer)(const volatile unsigned short *block) = 0; // Executed with each finished block
+static volatile unsigned int _mean = 0;           // The mean of the last block {0 to 4095}
+static volatile unsigned int _rms = 0;            // The RMS of the last block around its mean {0 to 4095}
+static volatile unsigned int _peak = 0;           // The highest distance of the last block from its mean {0 to 4095}
+static volatile unsigned long _blockCount = 0;    // The blocks captured since the initialization
+static DecimationFilter _filters[2];              // The filter in use and the one loaded meanwhile
+static DecimationFilter * volatile _activeFilter = 0; // The filter in use, 0 without decimation
+static const volatile unsigned short * volatile _pendingBlock = 0; // The block the decimation takes next
+static unsigned short _filtered[2][CURRENT_FILTERED_SAMPLES]; // The decimation of the last two blocks {0 to 65535}
+static volatile unsigned int _filteredLast = 0;   // The decimation the readers get
+static volatile unsigned int _filteredCount = 0;  // The amount of samples of the last decimation
+static volatile unsigned long _filterCycles = 0;  // The core clock cycles per decimated sample
+
+//////////////////////////////////////////////////////////////////////////////
+
+
+/* ***************CurrentCapture_Init******************
+ * Start the capture of the motor current
+ * Input: task - Executed with each finished block, or 0
+ * Output: none
+ */
+void CurrentCapture_Init(void(*task)(const volatile unsigned short *block))
+{
+    _consumer = task;
+    SWInterrupt_Init(&DecimationTask);
+    ADC0_InitTimer0ATriggerSeq3DMA_Ch1(&CurrentBlockTask, SYSTEM_CLOCK_FREQ / CURRENT_SAMPLE_FREQ,
+                                       _blocks, CURRENT_BLOCK_SAMPLES);
+}
+
+/* ***************CurrentCapture_GetMean******************
+ * Returns the mean of the last block
+ * Input: none
+ * Output: unsigned int - the mean {0 to 4095}
+ */
+unsigned int CurrentCapture_GetMean(void)
+{
+    return _mean;
+}
+
+/* ***************CurrentCapture_GetRms******************
+ * Returns the RMS of the last block around its mean
+ * Input: none
+ * Output: unsigned int - the RMS {0 to 4095}
+ */
+unsigned int CurrentCapture_GetRms(void)
+{
+    return _rms;
+}
+
+/* ***************CurrentCapture_GetPeak******************
+ * Returns the highest distance of a sample of the last block from its mean
+ * Input: none
+ * Output: unsigned int - the peak {0 to 4095}
+ */
+unsigned int CurrentCapture_GetPeak(void)
+{
+    return _peak;
+}
+
+/* ***************CurrentCapture_GetBlockCount******************
+ * Returns the amount of blocks captured since the initialization
+ * Input: none
+ * Output: unsigned long - the blocks
+ */
+unsigned long CurrentCapture_GetBlockCount(void)
+{
+    return _blockCount;
+}
+
+/* ***************CurrentCapture_SetOversampling******************
+ * Select the ADC averaging and the CIC decimation of the blocks
+ * Input: averaging - The conversions of each sample {1, 2, 4, 8, 16, 32 or 64}
+ *        order - The stages of the CIC filter {1 to DECIMATION_MAX_CIC_ORDER}, 0 for no decimation
+ *        factor - The samples of each decimated one {2 to DECIMATION_MAX_FACTOR, a power of 2}
+ * Output: bool - false if the filter doesn't fit
+ */
+bool CurrentCapture_SetOversampling(unsigned int averaging, unsigned int order, unsigned int factor)
+{
+    DecimationFilter *filter = LoadingFilter();
+
+    ADC0_SetAveraging(averaging);
+
+    if((order == 0) || !DecimationFilter_InitCic(filter, order, factor))
+    {
+        _activeFilter = 0;
+        _filteredCount = 0;
+        return (order == 0);
+    }
+    _activeFilter = filter;
+    return true;
+}
+
+/* ***************CurrentCapture_SetFirDecimation******************
+ * Decimate every block with a FIR filter instead of the CIC one
+ * Input: taps - The impulse response, with a DC gain of 32768 {Q15}
+ *        count - The amount of taps {1 to DECIMATION_MAX_TAPS}
+ *        factor - The samples of each decimated one {2 to DECIMATION_MAX_FACTOR, a power of 2}
+ * Output: bool - false if the filter doesn't fit
+ */
+bool CurrentCapture_SetFirDecimation(const short *taps, unsigned int count, unsigned int factor)
+{
+    DecimationFilter *filter = LoadingFilter();
+
+    if(!DecimationFilter_InitFir(filter, taps, count, factor))
+    {
+        _activeFilter = 0;
+        _filteredCount = 0;
+        return false;
+    }
+    _activeFilter = filter;
+    return true;
+}
+
+/* ***************CurrentCapture_GetFiltered******************
+ * Returns the decimation of the last block
+ * Input: count - Receives the amount of samples, 0 without decimation
+ * Output: const unsigned short * - the samples {0 to 65535}
+ */
+const unsigned short *CurrentCapture_GetFiltered(unsigned int *count)
+{
+    unsigned int last = _filteredLast;
+
+    *count = _filteredCount;
+    return _filtered[last];
+}
+
+/* ***************CurrentCapture_GetFilterCycles******************
+ * Returns the cost of the decimation of the last block
+ * Input: none
+ * Output: unsigned long - the core clock cycles per decimated sample
+ */
+unsigned long CurrentCapture_GetFilterCycles(void)
+{
+    return _filterCycles;
+}
+
+/* This is the task executed by the ADC0 SS3 interrupt when the uDMA finishes a block.
+ * The block is measured in one pass, the mean square around the mean is taken as
+ *  sum(x^2) / N - mean^2, and then it is handed to the consumer. */
+void CurrentBlockTask(const volatile unsigned short *block)
+{
+    unsigned long sum = 0;
+    unsigned long long squares = 0;
+    unsigned int lowest = 0xFFF;
+    unsigned int highest = 0;
+    unsigned int sample;
+    unsigned long mean;
+    unsigned long long meanSquare;
+    int i = 0;
+
+    for(i=0; i<CURRENT_BLOCK_SAMPLES; i++)
+    {
+        sample = block[i] & 0xFFF;
+        sum += sample;
+        squares += (unsigned long)sample * sample;
+        if(sample < lowest) lowest = sample;
+        if(sample > highest) highest = sample;
+    }
+
+    mean = (sum + (CURRENT_BLOCK_SAMPLES / 2)) / CURRENT_BLOCK_SAMPLES;
+    meanSquare = squares / CURRENT_BLOCK_SAMPLES;
+    meanSquare = (meanSquare > ((unsigned long long)mean * mean)) ? (meanSquare - ((unsigned long long)mean * mean)) : 0;
+
+    _mean = mean;
+    _rms = SquareRoot((unsigned long)meanSquare);
+    _peak = ((highest - mean) > (mean - lowest)) ? (highest - mean) : (mean - lowest);
+    _blockCount++;
+
+    /* The block stays untouched for one block time, the decimation takes it at a lower priority */
+    if(_activeFilter != 0)
+    {
+        _pendingBlock = block;
+        SWInterrupt_Trigger();
+    }
+
+    if(_consumer != 0) (*_consumer)(block);
+}
+
+/* This is the task executed by the software interrupt after each finished block, below the
+ *  ADC0 SS3 interrupt and the ramp tick. The filter is taken once, so a new one published
+ *  meanwhile starts with the next block. The decimation goes into the other buffer, and is
+ *  published once complete. */
+void DecimationTask(void)
+{
+    DecimationFilter *filter = _activeFilter;
+    const volatile unsigned short *block = _pendingBlock;
+    unsigned long start;
+    unsigned int outputs;
+
+    if((filter == 0) || (block == 0)) return;
+
+    start = Debug_CycleCounterRead();
+    outputs = DecimationFilter_Process(filter, block, CURRENT_BLOCK_SAMPLES, _filtered[1 - _filteredLast]);
+    _filterCycles = (Debug_CycleCounterRead() - start) / outputs;
+    _filteredLast = 1 - _filteredLast;
+    _filteredCount = outputs;
+}
+
+/* ***************LoadingFilter******************
+ * The filter instance that isn't in use. The selections run from the main program, below
+ *  the software interrupt, so the decimation is never in the middle of this instance.
+ * Input: none
+ * Output: DecimationFilter * - the instance to load a new filter into
+ */
+DecimationFilter *LoadingFilter(void)
+{
+    return (_activeFilter == &_filters[0]) ? &_filters[1] : &_filters[0];
+}
+
+/* ***************SquareRoot******************
+ * The square root of a number, rounded to the nearest
+ * Input: value - The number
+ * Output: unsigned long - the root
+ */
+unsigned long SquareRoot(unsigned long value)
+{
+    unsigned long root = 0;
+    unsigned long bit = 1UL << 30;
+
+    /* One result bit per iteration, from the highest one down */
+    while(bit > value) bit >>= 2;
+    while(bit != 0)
+    {
+        if(value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    /* The remainder is above the root when the root + 0.5 is below the exact one */
+    return (value > root) ? (root + 1) : root;
+}
@@ -0,0 +1,104 @@
+/*
+ * CurrentCapture.h
+ *
+ * Captures the motor current at CURRENT_SAMPLE_FREQ into blocks of RAM moved by the uDMA,
+ *  the consumers read whole blocks and the statistics of the last one. The samples may
+ *  be triggered by the modulator instead, see PwmOuputController_SetCurrentSampling,
+ *  then there is one per pwm cycle and the block lasts CURRENT_BLOCK_SAMPLES of them.
+ *  An optional oversampling stage, off by default, averages the conversions of each sample in
+ *  the ADC and decimates every block with a CIC or FIR filter, for more resolution at a lower
+ *  rate. The decimation runs from a software interrupt below the ADC0 SS3 and ramp ones.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#ifndef SOURCE_MAIN_CURRENTCAPTURE_H_
+#define SOURCE_MAIN_CURRENTCAPTURE_H_
+
+#include "DecimationFilter.h"
+#include <stdbool.h>
+
+/* The sample rate of the motor current, 80 MHz / 2000 {Hz} */
+#define CURRENT_SAMPLE_FREQ 40000
+/* The amount of samples of each block, 6.4 ms at CURRENT_SAMPLE_FREQ */
+#define CURRENT_BLOCK_SAMPLES 256
+/* The most outputs of the decimation of a block, at the lowest factor */
+#define CURRENT_FILTERED_SAMPLES (CURRENT_BLOCK_SAMPLES / 2)
+
+/* ***************CurrentCapture_Init******************
+ * Start the capture of the motor current on Ain1 (PE2), triggered by TIMER0A.
+ *  Each finished block is measured and then passed to the task, from the ADC0 SS3
+ *  interrupt. The block stays untouched for one block time, 6.4 ms at the timer rate,
+ *  so the task may read it as long as it returns within that time.
+ * Input: task - Executed with each finished block {CURRENT_BLOCK_SAMPLES samples from 0 to 4095}, or 0
+ * Output: none
+ */
+void CurrentCapture_Init(void(*task)(const volatile unsigned short *block));
+
+/* ***************CurrentCapture_GetMean******************
+ * Returns the mean of the last block, the offset of the current sensor
+ * Input: none
+ * Output: unsigned int - the mean {0 to 4095}
+ */
+unsigned int CurrentCapture_GetMean(void);
+
+/* ***************CurrentCapture_GetRms******************
+ * Returns the RMS of the last block around its mean
+ * Input: none
+ * Output: unsigned int - the RMS {0 to 4095}
+ */
+unsigned int CurrentCapture_GetRms(void);
+
+/* ***************CurrentCapture_GetPeak******************
+ * Returns the highest distance of a sample of the last block from its mean,
+ *  for the overcurrent protection
+ * Input: none
+ * Output: unsigned int - the peak {0 to 4095}
+ */
+unsigned int CurrentCapture_GetPeak(void);
+
+/* ***************CurrentCapture_GetBlockCount******************
+ * Returns the amount of blocks captured since the initialization
+ * Input: none
+ * Output: unsigned long - the blocks
+ */
+unsigned long CurrentCapture_GetBlockCount(void);
+
+/* ***************CurrentCapture_SetOversampling******************
+ * Select the oversampling stage: the ADC averages averaging conversions into each sample,
+ *  and a CIC filter of order stages decimates every block by factor. The statistics keep
+ *  coming from the averaged samples, the decimated ones have DECIMATION_EXTRA_BITS more bits.
+ *  It must be selected from the main program, after the initialization of the other users of
+ *  ADC0; the drive acquisition averages the same on ADC1, see ADC0_SetAveraging.
+ * Input: averaging - The conversions of each sample {1, 2, 4, 8, 16, 32 or 64}
+ *        order - The stages of the CIC filter {1 to DECIMATION_MAX_CIC_ORDER}, 0 for no decimation
+ *        factor - The samples of each decimated one {2 to DECIMATION_MAX_FACTOR, a power of 2}
+ * Output: bool - false if the filter doesn't fit, the decimation is off then
+ */
+bool CurrentCapture_SetOversampling(unsigned int averaging, unsigned int order, unsigned int factor);
+
+/* ***************CurrentCapture_SetFirDecimation******************
+ * Decimate every block with a FIR filter instead of the CIC one, from the main program
+ * Input: taps - The impulse response, with a DC gain of 32768 {Q15}
+ *        count - The amount of taps {1 to DECIMATION_MAX_TAPS}
+ *        factor - The samples of each decimated one {2 to DECIMATION_MAX_FACTOR, a power of 2}
+ * Output: bool - false if the filter doesn't fit, the decimation is off then
+ */
+bool CurrentCapture_SetFirDecimation(const short *taps, unsigned int count, unsigned int factor);
+
+/* ***************CurrentCapture_GetFiltered******************
+ * Returns the decimation of the last block, it stays untouched for one block time
+ * Input: count - Receives the amount of samples, 0 without decimation
+ * Output: const unsigned short * - the samples {0 to 65535}
+ */
+const unsigned short *CurrentCapture_GetFiltered(unsigned int *count);
+
+/* ***************CurrentCapture_GetFilterCycles******************
+ * Returns the cost of the decimation of the last block
+ * Input: none
+ * Output: unsigned long - the core clock cycles per decimated sample
+ */
+unsigned long CurrentCapture_GetFilterCycles(void);
+
+#endif /* SOURCE_MAIN_CURRENTCAPTURE_H_ */
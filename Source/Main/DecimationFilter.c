@@ -0,0 +1,179 @@
+/*
+ * DecimationFilter.c
+ *
+ * Each output is the dot product of the reversed taps with the window of inputs that ends at its
+ *  last input. The factor is even and so is the amount of taps, so every window starts at a 16-bit
+ *  pair and the inner loop takes two taps and two inputs per SMLAD. The window keeps the last
+ *  taps - factor inputs of the previous block ahead of the new one, the filter runs across the blocks.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "DecimationFilter.h"
+
+/* The dual 16-bit multiply and accumulate: acc + x.lo * y.lo + x.hi * y.hi. The portable
+ *  version is the reference of the intrinsics, and runs the filter off the target */
+#if defined(__TI_ARM_V7M4__)
+#define SMLAD(x, y, acc) _smlad((x), (y), (acc))
+#elif defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#define SMLAD(x, y, acc) __smlad((x), (y), (acc))
+#else
+#define SMLAD(x, y, acc) ((acc) + ((long)(short)(x) * (short)(y)) + ((long)(short)((x) >> 16) * (short)((y) >> 16)))
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+////////////////      LOCAL FUNCTIONS PROTOTYPES    //////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/* If the factor is a power of 2 within the range */
+bool IsDecimationFactor(unsigned int factor);
+
+/* Load the taps scaled to a DC gain of 32768 and clear the window */
+void LoadTaps(DecimationFilter *filter, const unsigned long *taps, unsigned int count, unsigned long gain, unsigned int factor);
+
+//////////////////////////////////////////////////////////////////////////////
+
+
+/* ***************DecimationFilter_InitFir******************
+ * Load a FIR filter and clear its inputs
+ * Input: filter - The filter
+ *        taps - The impulse response {Q15}
+ *        count - The amount of taps {1 to DECIMATION_MAX_TAPS}
+ *        factor - The inputs of each output {2 to DECIMATION_MAX_FACTOR, a power of 2}
+ * Output: bool - false if the taps or the factor don't fit
+ */
+bool DecimationFilter_InitFir(DecimationFilter *filter, const short *taps, unsigned int count, unsigned int factor)
+{
+    unsigned int i = 0;
+
+    if(!IsDecimationFactor(factor) || (count == 0) || (count > DECIMATION_MAX_TAPS)) return false;
+
+    filter->factor = factor;
+    filter->taps = count + (count & 1);
+    if(filter->taps < factor) filter->taps = factor;
+
+    /* Reversed, the missing taps are the oldest inputs */
+    for(i=0; i<filter->taps; i++) filter->coefficients.values[i] = 0;
+    for(i=0; i<count; i++) filter->coefficients.values[filter->taps - 1 - i] = taps[i];
+    for(i=0; i<(DECIMATION_MAX_TAPS + DECIMATION_MAX_BLOCK); i++) filter->window.values[i] = 0;
+
+    return true;
+}
+
+/* ***************DecimationFilter_InitCic******************
+ * Load a CIC filter as its equivalent FIR, with unity DC gain
+ * Input: filter - The filter
+ *        order - The amount of integrator and comb stages {1 to DECIMATION_MAX_CIC_ORDER}
+ *        factor - The inputs of each output {2 to DECIMATION_MAX_FACTOR, a power of 2}
+ * Output: bool - false if the filter doesn't fit
+ */
+bool DecimationFilter_InitCic(DecimationFilter *filter, unsigned int order, unsigned int factor)
+{
+    unsigned long taps[2][DECIMATION_MAX_TAPS];
+    unsigned long gain = 1;
+    unsigned int count = 1;
+    unsigned int last = 0;
+    unsigned int stage = 0;
+    unsigned int i = 0;
+    unsigned int k = 0;
+
+    if(!IsDecimationFactor(factor) || (order == 0) || (order > DECIMATION_MAX_CIC_ORDER)) return false;
+    if((order * (factor - 1) + 1) > DECIMATION_MAX_TAPS) return false;
+
+    /* Each stage convolves the response with a boxcar of factor ones, the gain grows to factor^order */
+    taps[0][0] = 1;
+    for(stage=0; stage<order; stage++)
+    {
+        for(i=0; i<(count + factor - 1); i++)
+        {
+            taps[1 - last][i] = 0;
+            for(k=0; k<factor; k++) if((i >= k) && ((i - k) < count)) taps[1 - last][i] += taps[last][i - k];
+        }
+        count += factor - 1;
+        gain *= factor;
+        last = 1 - last;
+    }
+
+    LoadTaps(filter, taps[last], count, gain, factor);
+    return true;
+}
+
+/* ***************DecimationFilter_Process******************
+ * Filter a block and keep its last inputs for the next one
+ * Input: filter - The filter
+ *        block - The inputs {count samples from 0 to 4095}
+ *        count - The amount of inputs, a multiple of the factor {up to DECIMATION_MAX_BLOCK}
+ *        output - Receives count / factor outputs {0 to 65535}
+ * Output: unsigned int - the amount of outputs
+ */
+unsigned int DecimationFilter_Process(DecimationFilter *filter, const volatile unsigned short *block,
+                                      unsigned int count, unsigned short *output)
+{
+    unsigned int history = filter->taps - filter->factor;
+    unsigned int pairs = filter->taps / 2;
+    unsigned int outputs = count / filter->factor;
+    const unsigned long *taps = filter->coefficients.pairs;
+    const unsigned long *inputs;
+    long acc;
+    unsigned int i = 0;
+    unsigned int k = 0;
+
+    if(count > DECIMATION_MAX_BLOCK) outputs = DECIMATION_MAX_BLOCK / filter->factor;
+
+    for(i=0; i<(outputs * filter->factor); i++) filter->window.values[history + i] = block[i] & 0xFFF;
+
+    for(i=0; i<outputs; i++)
+    {
+        /* The window of this output starts at a pair, as factor and history are even */
+        inputs = &filter->window.pairs[(i * filter->factor) / 2];
+        acc = 0;
+        for(k=0; k<pairs; k++) acc = SMLAD(inputs[k], taps[k], acc);
+
+        /* Back from Q15 keeping the extra bits, the negative taps may overshoot the range */
+        acc = (acc + (1L << (14 - DECIMATION_EXTRA_BITS))) >> (15 - DECIMATION_EXTRA_BITS);
+        output[i] = (acc < 0) ? 0 : ((acc > 0xFFFF) ? 0xFFFF : acc);
+    }
+
+    /* The newest inputs start the window of the next block */
+    for(i=0; i<history; i++) filter->window.values[i] = filter->window.values[outputs * filter->factor + i];
+
+    return outputs;
+}
+
+/* ***************IsDecimationFactor******************
+ * If the factor is a power of 2 within the range
+ * Input: factor - The inputs of each output
+ * Output: bool - true if it can be used
+ */
+bool IsDecimationFactor(unsigned int factor)
+{
+    return (factor >= 2) && (factor <= DECIMATION_MAX_FACTOR) && ((factor & (factor - 1)) == 0);
+}
+
+/* ***************LoadTaps******************
+ * Load integer taps scaled to a DC gain of 32768 and clear the window. The rounding
+ *  error of the sum is put into the middle tap, so the DC gain is exact
+ * Input: filter - The filter
+ *        taps - The impulse response
+ *        count - The amount of taps {1 to DECIMATION_MAX_TAPS}
+ *        gain - The sum of the taps
+ *        factor - The inputs of each output
+ * Output: none
+ */
+void LoadTaps(DecimationFilter *filter, const unsigned long *taps, unsigned int count, unsigned long gain, unsigned int factor)
+{
+    short scaled[DECIMATION_MAX_TAPS];
+    long sum = 0;
+    unsigned int i = 0;
+
+    for(i=0; i<count; i++)
+    {
+        scaled[i] = (short)((((unsigned long long)taps[i] << 15) + (gain / 2)) / gain);
+        sum += scaled[i];
+    }
+    scaled[count / 2] += 32768 - sum;
+
+    DecimationFilter_InitFir(filter, scaled, count, factor);
+}
@@ -0,0 +1,76 @@
+/*
+ * DecimationFilter.h
+ *
+ * Fixed point FIR decimation of whole blocks of 12-bit samples: every factor inputs give one
+ *  output, with DECIMATION_EXTRA_BITS more bits of resolution. A CIC filter is run through its
+ *  equivalent FIR, the convolution of order boxcars of factor samples, so both share the same
+ *  dual 16-bit multiply and accumulate (SMLAD) inner loop.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#ifndef SOURCE_MAIN_DECIMATIONFILTER_H_
+#define SOURCE_MAIN_DECIMATIONFILTER_H_
+
+#include <stdbool.h>
+
+/* The most taps of a filter */
+#define DECIMATION_MAX_TAPS 64
+/* The most samples of an input block */
+#define DECIMATION_MAX_BLOCK 256
+/* The most decimation factor */
+#define DECIMATION_MAX_FACTOR 64
+/* The highest order of a CIC filter */
+#define DECIMATION_MAX_CIC_ORDER 4
+/* The bits of resolution added to the 12-bit samples, the outputs are {0 to 65535} */
+#define DECIMATION_EXTRA_BITS 4
+
+/* A decimation filter and the inputs it keeps from the previous block.
+ * The taps and the inputs are stored in 16-bit pairs, as the SMLAD takes them */
+typedef struct {
+    unsigned int factor;    // The inputs of each output {2 to DECIMATION_MAX_FACTOR, a power of 2}
+    unsigned int taps;      // The taps, even and not below the factor {2 to DECIMATION_MAX_TAPS}
+    union {
+        short values[DECIMATION_MAX_TAPS];
+        unsigned long pairs[DECIMATION_MAX_TAPS / 2];
+    } coefficients;         // The taps in reverse order {Q15}
+    union {
+        short values[DECIMATION_MAX_TAPS + DECIMATION_MAX_BLOCK];
+        unsigned long pairs[(DECIMATION_MAX_TAPS + DECIMATION_MAX_BLOCK) / 2];
+    } window;               // The last taps - factor inputs of the previous block and then the block
+} DecimationFilter;
+
+/* ***************DecimationFilter_InitFir******************
+ * Load a FIR filter and clear its inputs
+ * Input: filter - The filter
+ *        taps - The impulse response, with a DC gain of 32768 to keep the scale {Q15}
+ *        count - The amount of taps {1 to DECIMATION_MAX_TAPS}
+ *        factor - The inputs of each output {2 to DECIMATION_MAX_FACTOR, a power of 2}
+ * Output: bool - false if the taps or the factor don't fit, the filter is unchanged then
+ */
+bool DecimationFilter_InitFir(DecimationFilter *filter, const short *taps, unsigned int count, unsigned int factor);
+
+/* ***************DecimationFilter_InitCic******************
+ * Load a CIC filter as its equivalent FIR, with unity DC gain. Its first zero is at the
+ *  output rate, and each order adds the rejection of the aliases and the droop of the passband.
+ * Input: filter - The filter
+ *        order - The amount of integrator and comb stages {1 to DECIMATION_MAX_CIC_ORDER}
+ *        factor - The inputs of each output {2 to DECIMATION_MAX_FACTOR, a power of 2},
+ *                 order * (factor - 1) + 1 must not exceed DECIMATION_MAX_TAPS
+ * Output: bool - false if the filter doesn't fit, it is unchanged then
+ */
+bool DecimationFilter_InitCic(DecimationFilter *filter, unsigned int order, unsigned int factor);
+
+/* ***************DecimationFilter_Process******************
+ * Filter a block and keep its last inputs for the next one
+ * Input: filter - The filter
+ *        block - The inputs {count samples from 0 to 4095}
+ *        count - The amount of inputs, a multiple of the factor {up to DECIMATION_MAX_BLOCK}
+ *        output - Receives count / factor outputs {0 to 65535}
+ * Output: unsigned int - the amount of outputs
+ */
+unsigned int DecimationFilter_Process(DecimationFilter *filter, const volatile unsigned short *block,
+                                      unsigned int count, unsigned short *output);
+
+#endif /* SOURCE_MAIN_DECIMATIONFILTER_H_ */
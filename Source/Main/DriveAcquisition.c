@@ -0,0 +1,150 @@
+/*
+ * DriveAcquisition.c
+ *
+ * The channel list is split into the SS0 steps of each ADC keeping its order, and the position
+ *  of each channel into the samples of the driver is kept, so the interrupt only has to put the
+ *  samples back into the order of the list. The frames are double buffered: the interrupt fills
+ *  the one that isn't published and then publishes it, the readers copy the published one again
+ *  if a period completed meanwhile.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "DriveAcquisition.h"
+#include "PwmOutputController.h"
+
+//////////////////////////////////////////////////////////////////////////////
+////////////////      LOCAL FUNCTIONS PROTOTYPES    //////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/* Executed by the SS0 interrupt that ends each control period with its samples */
+void AcquisitionPeriodTask(const unsigned short *samples);
+
+//////////////////////////////////////////////////////////////////////////////
+/////////////////////      GLOBAL VARIABLE    ////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/* The default channels, the phase currents first and then the slow signals */
+static const AcquisitionChannel _defaultChannels[] = {
+    {ACQUISITION_ADC0, 1},                  // ACQUISITION_PHASE_U
+    {ACQUISITION_ADC1, 2},                  // ACQUISITION_PHASE_V
+    {ACQUISITION_ADC0, 0},                  // ACQUISITION_BUS
+    {ACQUISITION_ADC1, ADC_CHANNEL_TEMP}    // ACQUISITION_TEMPERATURE
+};
+
+static volatile AcquisitionFrame _frames[2];      // The frame being filled and the published one
+static volatile unsigned int _published = 0;      // The frame the readers copy
+static volatile unsigned long _periods = 0;       // The control periods acquired
+static unsigned int _count = 0;                   // The amount of channels of the list
+static unsigned char _order[ACQUISITION_MAX_CHANNELS]; // The position of each channel into the samples
+static void (*_consumer)(const AcquisitionFrame *frame) = 0; // Executed with each frame
+
+//////////////////////////////////////////////////////////////////////////////
+
+
+/* ***************DriveAcquisition_Init******************
+ * Start the acquisition of a list of channels at ACQUISITION_FREQ
+ * Input: channels - The list of channels, 0 for the default ones
+ *        count - The amount of channels {1 to ACQUISITION_MAX_CHANNELS}
+ *        task - Executed with each frame, or 0
+ * Output: bool - false if the list doesn't fit into the sequencers
+ */
+bool DriveAcquisition_Init(const AcquisitionChannel *channels, unsigned int count, void(*task)(const AcquisitionFrame *frame))
+{
+    unsigned char inputs[2][ADC_SEQ0_STEPS];
+    unsigned int steps[2] = {0, 0};
+    unsigned int adc;
+    unsigned int i = 0;
+
+    if(channels == 0)
+    {
+        channels = _defaultChannels;
+        count = sizeof(_defaultChannels) / sizeof(_defaultChannels[0]);
+    }
+
+    /* Each ADC takes its channels in the order of the list */
+    for(i=0; i<count; i++)
+    {
+        adc = channels[i].adc;
+        if((adc > ACQUISITION_ADC1) || (steps[adc] >= ADC_SEQ0_STEPS) || (channels[i].input > ADC_CHANNEL_TEMP)) return false;
+        inputs[adc][steps[adc]] = channels[i].input;
+        _order[i] = (adc == ACQUISITION_ADC0) ? steps[adc] : (ADC_SEQ0_STEPS + steps[adc]);
+        steps[adc]++;
+    }
+    if(steps[ACQUISITION_ADC0] == 0) return false;
+
+    /* The driver puts the ADC1 samples right after the ADC0 ones */
+    for(i=0; i<count; i++)
+    {
+        if(_order[i] >= ADC_SEQ0_STEPS) _order[i] = _order[i] - ADC_SEQ0_STEPS + steps[ACQUISITION_ADC0];
+    }
+
+    _count = count;
+    _consumer = task;
+    _frames[0].count = count;
+    _frames[1].count = count;
+    ADC01_InitTimer3ATriggerSeq0(&AcquisitionPeriodTask, SYSTEM_CLOCK_FREQ / ACQUISITION_FREQ,
+                                 inputs[ACQUISITION_ADC0], steps[ACQUISITION_ADC0],
+                                 inputs[ACQUISITION_ADC1], steps[ACQUISITION_ADC1]);
+    return true;
+}
+
+/* ***************DriveAcquisition_GetFrame******************
+ * Copy the last frame, all its values come from the same control period
+ * Input: frame - Receives the frame
+ * Output: none
+ */
+void DriveAcquisition_GetFrame(AcquisitionFrame *frame)
+{
+    unsigned long periods;
+    const volatile AcquisitionFrame *last;
+    unsigned int i = 0;
+
+    /* The copy lasts far less than a period, it's repeated at most once */
+    do
+    {
+        periods = _periods;
+        last = &_frames[_published];
+        frame->period = last->period;
+        frame->count = last->count;
+        for(i=0; i<last->count; i++) frame->values[i] = last->values[i];
+    } while(periods != _periods);
+}
+
+/* ***************DriveAcquisition_GetValue******************
+ * Returns one value of the last frame
+ * Input: position - The position of the channel into the list
+ * Output: unsigned int - the value {0 to 4095}, 0 past the list
+ */
+unsigned int DriveAcquisition_GetValue(unsigned int position)
+{
+    if(position >= _count) return 0;
+    return _frames[_published].values[position];
+}
+
+/* ***************DriveAcquisition_GetPeriods******************
+ * Returns the control periods acquired so far, it changes with every new frame
+ * Input: none
+ * Output: unsigned long - the control periods acquired
+ */
+unsigned long DriveAcquisition_GetPeriods(void)
+{
+    return _periods;
+}
+
+/* This is the task executed by the last SS0 interrupt at the end of every control period.
+ * The samples come in the order of the steps, ADC0 first, and are put back into the order
+ *  of the list into the frame that isn't published, which is then published. */
+void AcquisitionPeriodTask(const unsigned short *samples)
+{
+    unsigned int filling = 1 - _published;
+    unsigned int i = 0;
+
+    for(i=0; i<_count; i++) _frames[filling].values[i] = samples[_order[i]];
+    _frames[filling].period = _periods;
+    _published = filling;
+    _periods++;
+
+    if(_consumer != 0) (*_consumer)((const AcquisitionFrame *)&_frames[filling]);
+}
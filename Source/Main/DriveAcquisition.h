@@ -0,0 +1,84 @@
+/*
+ * DriveAcquisition.h
+ *
+ * Acquires the analog signals of the drive once per control period: TIMER3A triggers the SS0
+ *  of ADC0 and ADC1 together, so the channels listed at the same position of each ADC start
+ *  their conversion together, and every period is handed over as one frame of values.
+ *  They are not simultaneous samples: each ADC converts its channels one after the other, 8 us
+ *  apart or the conversions averaged at 1 MHz, so a pair is as close as it gets only when both
+ *  are the first of their ADC. Both ADCs average the same, see ADC0_SetAveraging.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#ifndef SOURCE_MAIN_DRIVEACQUISITION_H_
+#define SOURCE_MAIN_DRIVEACQUISITION_H_
+
+#include "../DeviceDrivers/ADCT3ATrigger.h"
+#include <stdbool.h>
+
+/* The rate of the control period, 80 MHz / 8000 {Hz} */
+#define ACQUISITION_FREQ 10000
+/* The most channels of a frame, the SS0 of both ADCs */
+#define ACQUISITION_MAX_CHANNELS (2 * ADC_SEQ0_STEPS)
+
+/* The ADC that samples a channel */
+#define ACQUISITION_ADC0 0
+#define ACQUISITION_ADC1 1
+
+/* The positions of the default channels into the frame */
+#define ACQUISITION_PHASE_U     0   // Current of the phase U, ADC0 Ain1 (PE2)
+#define ACQUISITION_PHASE_V     1   // Current of the phase V, ADC1 Ain2 (PE1), along with the phase U
+#define ACQUISITION_BUS         2   // DC bus voltage, ADC0 Ain0 (PE3)
+#define ACQUISITION_TEMPERATURE 3   // Internal temperature sensor, ADC1, along with the DC bus
+
+/* A channel of the acquisition, the n-th channel of an ADC in the list
+ *  starts its conversion along with the n-th channel of the other one */
+typedef struct {
+    unsigned char adc;      // The ADC that samples it {ACQUISITION_ADC0 or ACQUISITION_ADC1}
+    unsigned char input;    // The analog input {0 to 11 or ADC_CHANNEL_TEMP}
+} AcquisitionChannel;
+
+/* The values of one control period */
+typedef struct {
+    unsigned long period;   // The control periods acquired before this one
+    unsigned int count;     // The amount of values
+    unsigned short values[ACQUISITION_MAX_CHANNELS]; // In the order of the channel list {0 to 4095}
+} AcquisitionFrame;
+
+/* ***************DriveAcquisition_Init******************
+ * Start the acquisition of a list of channels at ACQUISITION_FREQ. The list may interleave
+ *  both ADCs in any order, up to ADC_SEQ0_STEPS channels each, and at least one on ADC0.
+ *  ADC0 is shared with the current capture, a conversion of its own in progress delays
+ *  the ADC0 channels by one conversion (8 us) from the ADC1 ones.
+ *  Ain4 to Ain7 (PD0-3) are the keys and Ain8 to Ain11 (PE4-5, PB4-5) the three-phase legs.
+ * Input: channels - The list of channels, 0 for the default phases U and V, DC bus and temperature
+ *        count - The amount of channels {1 to ACQUISITION_MAX_CHANNELS}
+ *        task - Executed with each frame from the SS0 interrupt that ends the period, or 0
+ * Output: bool - false if the list doesn't fit into the sequencers, nothing is started then
+ */
+bool DriveAcquisition_Init(const AcquisitionChannel *channels, unsigned int count, void(*task)(const AcquisitionFrame *frame));
+
+/* ***************DriveAcquisition_GetFrame******************
+ * Copy the last frame, all its values come from the same control period
+ * Input: frame - Receives the frame
+ * Output: none
+ */
+void DriveAcquisition_GetFrame(AcquisitionFrame *frame);
+
+/* ***************DriveAcquisition_GetValue******************
+ * Returns one value of the last frame
+ * Input: position - The position of the channel into the list
+ * Output: unsigned int - the value {0 to 4095}, 0 past the list
+ */
+unsigned int DriveAcquisition_GetValue(unsigned int position);
+
+/* ***************DriveAcquisition_GetPeriods******************
+ * Returns the control periods acquired so far, it changes with every new frame
+ * Input: none
+ * Output: unsigned long - the control periods acquired
+ */
+unsigned long DriveAcquisition_GetPeriods(void);
+
+#endif /* SOURCE_MAIN_DRIVEACQUISITION_H_ */
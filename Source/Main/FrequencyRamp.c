@@ -0,0 +1,475 @@
+/*
+ * FrequencyRamp.c
+ *
+ * TIMER2 interrupts RAMP_TICK_FREQ times per second and each tick moves the frequency towards the
+ *  target by rate * FREQUENCY_FINE_SCALE / RAMP_TICK_FREQ fine units. The remainder of that division is
+ *  carried to the next tick, so any rate in Hz/s is kept exactly on average, and the steps are 0.01 Hz
+ *  fine: the NCO mode outputs each of them, the table mode the nearest whole pwm cycle length.
+ *  The ramp keeps its frequency within the bounds of the pwm output, so it holds what is really output:
+ *  a target beyond them is taken at the bound, and a ramp down to the idle stops there once it goes
+ *  below the lower bound, instead of holding it until the ramp reaches 0.
+ *
+ * The S-curve profile is planned once per command, in whole ticks, from the acceleration A0 the frequency
+ *  already has (0 from rest, kept within the rate): n1 ticks where the acceleration goes from A0 to the peak
+ *  Ap, na ticks at Ap and nj ticks where it falls back to 0. n1 and nj are the times the jerk limit takes
+ *  from A0 to the rate and from the rate to 0, and na covers the rest of the distance D at the rate; a move
+ *  too short to reach the rate is a triangle peaking at sqrt(jerk * D + A0^2 / 2). The peak is then set to
+ *  Ap = (2 * D - n1 * A0) / (n1 + 2 * na + nj), which is within both limits and makes the area under the
+ *  acceleration exactly D, so each tick k only evaluates the closed form of its segment with integers:
+ *   first   : A0 * k + (Ap - A0) * k^2 / (2 * n1)
+ *   peak    : (A0 + Ap) * n1 / 2 + Ap * (k - n1)
+ *   last    : D - Ap * (N - k)^2 / (2 * nj), with N = n1 + na + nj
+ *  The segments join with the same frequency and the same acceleration, which is zero at the end, so a
+ *  command in the middle of an S-curve keeps the acceleration continuous. When the frequency moves away
+ *  from the new target, or too fast to stop before it, the plan first takes the acceleration down to 0
+ *  at the jerk limit and the move is planned again from rest where it stops.
+ *
+ * The ramp doesn't depend on the main loop nor on the compiler optimization, and the main loop only
+ *  publishes commands. As the tick writes the frequency from the interrupt, the commands mask TIMER2
+ *  while they change the ramp state, so the tick never sees half of a command.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "../DeviceDrivers/Timer2.h"
+#include "FrequencyRamp.h"
+#include "PwmOutputController.h"
+#include <stdbool.h>
+
+/* The fraction bits of the S-curve accelerations {fine units per tick} */
+#define SCURVE_FRACTION_BITS 16
+
+//////////////////////////////////////////////////////////////////////////////
+////////////////      LOCAL FUNCTIONS PROTOTYPES    //////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/* Executed by TIMER2 to move the frequency one step towards the target */
+void RampTick(void);
+
+/* Output a frequency through the pwm output */
+void ApplyFrequency(unsigned long freq);
+
+/* Keep a frequency within the bounds of the pwm output */
+unsigned long BoundedFrequency(unsigned long freq, unsigned long target);
+
+/* Plan the S-curve segments of a move, from the acceleration the frequency already has */
+void PlanSCurve(long long acceleration);
+
+/* The distance covered by the S-curve at a tick */
+unsigned long SCurveOffset(unsigned long tick);
+
+/* The acceleration of the ramp in progress */
+long long CurrentAcceleration(void);
+
+/* The square root of a number, rounded up */
+unsigned long SquareRootCeil(unsigned long long value);
+
+//////////////////////////////////////////////////////////////////////////////
+/////////////////////      GLOBAL VARIABLE    ////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+static volatile unsigned long _rampFrequency = 0; // The frequency currently output {1/FREQUENCY_FINE_SCALE Hz}
+static volatile unsigned long _rampTarget = 0;    // The frequency the ramp moves to {1/FREQUENCY_FINE_SCALE Hz}
+static volatile unsigned long _rampStart = 0;     // The frequency the ramp started from {1/FREQUENCY_FINE_SCALE Hz}
+static volatile bool _rampRunning = false;        // If the frequency is still moving towards the target
+static unsigned long _rampRemainder = 0;          // The fraction of a fine unit carried to the next tick {1/RAMP_TICK_FREQ}
+static unsigned int _acceleration = RAMP_DEFAULT_RATE; // The rate while the frequency goes up {Hz/s}
+static unsigned int _deceleration = RAMP_DEFAULT_RATE; // The rate while the frequency goes down {Hz/s}
+static RampProfile _profile = RAMP_PROFILE_LINEAR; // The shape of the next ramps
+static unsigned int _jerk = RAMP_DEFAULT_JERK;    // The highest change of the acceleration {Hz/s^2}
+static bool _sCurve = false;                      // If the ramp in progress is an S-curve
+static bool _sCurveUp = false;                    // If the S-curve moves the frequency up
+static bool _sCurveStopping = false;              // If the S-curve only stops the frequency, to plan the move again from there
+static unsigned long _sCurveDistance = 0;         // The frequency change of the S-curve {1/FREQUENCY_FINE_SCALE Hz}
+static unsigned long _sCurveTick = 0;             // The ticks elapsed since the S-curve started
+static unsigned long _sCurveStartTicks = 0;       // The ticks from the initial to the peak acceleration (n1)
+static unsigned long _sCurvePeakTicks = 0;        // The ticks of the segment of peak acceleration (na)
+static unsigned long _sCurveJerkTicks = 0;        // The ticks from the peak acceleration to 0 (nj)
+static long long _sCurveInitial = 0;              // The initial acceleration (A0) {2^-SCURVE_FRACTION_BITS fine units per tick}
+static long long _sCurvePeak = 0;                 // The peak acceleration (Ap) {2^-SCURVE_FRACTION_BITS fine units per tick}
+
+//////////////////////////////////////////////////////////////////////////////
+
+
+/* ***************FrequencyRamp_Init******************
+ * Initialize the ramp at a frequency and start the timer that paces it
+ * Input: freq - The current fundamental frequency {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: none
+ */
+void FrequencyRamp_Init(unsigned long freq)
+{
+    _rampFrequency = freq;
+    _rampTarget = freq;
+    _rampStart = freq;
+    _rampRunning = false;
+    _rampRemainder = 0;
+    Timer2_Init(&RampTick, SYSTEM_CLOCK_FREQ / RAMP_TICK_FREQ);
+}
+
+/* ***************FrequencyRamp_SetRates******************
+ * Update the acceleration and the deceleration
+ * Input: acceleration - The rate while the frequency goes up {Hz/s}
+ *        deceleration - The rate while the frequency goes down {Hz/s}
+ * Output: none
+ */
+void FrequencyRamp_SetRates(unsigned int acceleration, unsigned int deceleration)
+{
+    Timer2_DisableInterrupt();
+    _acceleration = acceleration;
+    _deceleration = deceleration;
+    Timer2_EnableInterrupt();
+}
+
+/* ***************FrequencyRamp_SetProfile******************
+ * Select the shape of the next ramps
+ * Input: profile - The ramp shape {RampProfile}
+ *        jerk - The highest change of the acceleration {Hz/s^2}
+ * Output: none
+ */
+void FrequencyRamp_SetProfile(RampProfile profile, unsigned int jerk)
+{
+    Timer2_DisableInterrupt();
+    _profile = profile;
+    _jerk = jerk;
+    Timer2_EnableInterrupt();
+}
+
+/* ***************FrequencyRamp_MoveTo******************
+ * Start a ramp from the current frequency towards a new target
+ * Input: freq - The target frequency {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: none
+ */
+void FrequencyRamp_MoveTo(unsigned long freq)
+{
+    long long acceleration;
+    unsigned int rate;
+
+    Timer2_DisableInterrupt();
+    freq = BoundedFrequency(freq, freq);
+    acceleration = CurrentAcceleration();
+    _rampStart = _rampFrequency;
+    _rampTarget = freq;
+    _rampRemainder = 0;
+
+    /* The S-curve segments are planned once here, the ticks only evaluate them */
+    rate = (freq > _rampStart) ? _acceleration : _deceleration;
+    _sCurve = (_profile == RAMP_PROFILE_SCURVE) && (_jerk != 0) && (rate != 0) && (( freq != _rampStart ) || ( acceleration != 0 ));
+    if(_sCurve) PlanSCurve(acceleration);
+    _rampRunning = _sCurve || (freq != _rampFrequency);
+    Timer2_EnableInterrupt();
+}
+
+/* ***************FrequencyRamp_SetFrequency******************
+ * Cancel any ramp and output a frequency right away
+ * Input: freq - The new frequency {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: none
+ */
+void FrequencyRamp_SetFrequency(unsigned long freq)
+{
+    Timer2_DisableInterrupt();
+    freq = BoundedFrequency(freq, freq);
+    _rampRunning = false;
+    _rampStart = freq;
+    _rampTarget = freq;
+    ApplyFrequency(freq);
+    Timer2_EnableInterrupt();
+}
+
+/* ***************FrequencyRamp_Cancel******************
+ * Cancel the ramp in progress, the frequency reached so far is kept
+ * Input: none
+ * Output: none
+ */
+void FrequencyRamp_Cancel(void)
+{
+    Timer2_DisableInterrupt();
+    _rampRunning = false;
+    _rampTarget = _rampFrequency;
+    Timer2_EnableInterrupt();
+}
+
+/* ***************FrequencyRamp_IsRunning******************
+ * Returns if a ramp is in progress
+ * Input: none
+ * Output: bool - true while the frequency is still moving towards the target
+ */
+bool FrequencyRamp_IsRunning(void)
+{
+    return _rampRunning;
+}
+
+/* ***************FrequencyRamp_GetFrequency******************
+ * Returns the frequency currently output
+ * Input: none
+ * Output: unsigned long - the frequency {1/FREQUENCY_FINE_SCALE Hz}
+ */
+unsigned long FrequencyRamp_GetFrequency(void)
+{
+    return _rampFrequency;
+}
+
+/* ***************FrequencyRamp_GetProgress******************
+ * Returns how much of the last ramp is done
+ * Input: none
+ * Output: unsigned int - the progress {0.1 %}
+ */
+unsigned int FrequencyRamp_GetProgress(void)
+{
+    unsigned long done;
+    unsigned long total;
+
+    Timer2_DisableInterrupt();
+    if(!_rampRunning)
+    {
+        Timer2_EnableInterrupt();
+        return RAMP_PROGRESS_DONE;
+    }
+    done = (_rampFrequency > _rampStart) ? (_rampFrequency - _rampStart) : (_rampStart - _rampFrequency);
+    total = (_rampTarget > _rampStart) ? (_rampTarget - _rampStart) : (_rampStart - _rampTarget);
+    Timer2_EnableInterrupt();
+
+    /* An S-curve that has to stop first may move away from the target, or even start on it */
+    if(( total == 0 ) || ( done > total )) return 0;
+    return ((unsigned long long)done * RAMP_PROGRESS_DONE) / total;
+}
+
+/* ***************RampTick******************
+ * Executed by TIMER2 to move the frequency one step towards the target
+ * Input: none
+ * Output: none
+ */
+void RampTick(void)
+{
+    unsigned long freq = _rampFrequency;
+    unsigned long target;
+    unsigned long distance;
+    unsigned long step;
+    unsigned int rate;
+
+    if(!_rampRunning) return;
+
+    /* The bounds may have been narrowed since the command, the ramp then ends at the new bound */
+    target = BoundedFrequency(_rampTarget, _rampTarget);
+    _rampTarget = target;
+
+    if(_sCurve)
+    {
+        _sCurveTick++;
+        step = SCurveOffset(_sCurveTick);
+        if(!_sCurveUp && (step > _rampStart)) step = _rampStart;
+        freq = _sCurveUp ? (_rampStart + step) : (_rampStart - step);
+        freq = BoundedFrequency(freq, target);
+        if(freq != _rampFrequency) ApplyFrequency(freq);
+        if(!_sCurveStopping)
+        {
+            if(freq == target) _rampRunning = false;
+        }
+        else if(_sCurveTick >= _sCurveStartTicks)
+        {
+            /* Stopped, the move is planned again from rest */
+            _rampStart = _rampFrequency;
+            rate = (target > _rampStart) ? _acceleration : _deceleration;
+            if(rate == 0) ApplyFrequency(target);
+            if(( rate == 0 ) || ( target == _rampStart )) _rampRunning = false;
+            else PlanSCurve(0);
+        }
+        return;
+    }
+
+    rate = (target > freq) ? _acceleration : _deceleration;
+    distance = (target > freq) ? (target - freq) : (freq - target);
+
+    /* The fine units of this tick, the fraction is left for the next one */
+    _rampRemainder += (unsigned long)rate * FREQUENCY_FINE_SCALE;
+    step = _rampRemainder / RAMP_TICK_FREQ;
+    _rampRemainder %= RAMP_TICK_FREQ;
+
+    if((rate == 0) || (step >= distance)) freq = target;
+    else if(target > freq) freq += step;
+    else freq -= step;
+
+    freq = BoundedFrequency(freq, target);
+    if(freq != _rampFrequency) ApplyFrequency(freq);
+    if(freq == target) _rampRunning = false;
+}
+
+/* ***************ApplyFrequency******************
+ * Output a frequency through the pwm output
+ * Input: freq - The frequency {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: none
+ */
+void ApplyFrequency(unsigned long freq)
+{
+    _rampFrequency = freq;
+    PwmOuputController_UpdateFrequencyFine(freq);
+}
+
+/* ***************BoundedFrequency******************
+ * Keep a frequency within the bounds of the pwm output, the same way it would clamp it. Only the idle
+ *  is below the lower bound, so a ramp heading to the idle goes straight to it from there
+ * Input: freq - The frequency {1/FREQUENCY_FINE_SCALE Hz}
+ *        target - The frequency the ramp moves to {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: unsigned long - the frequency within the bounds, or the idle {1/FREQUENCY_FINE_SCALE Hz}
+ */
+unsigned long BoundedFrequency(unsigned long freq, unsigned long target)
+{
+    unsigned long lower = PwmOuputController_GetLowerBound();
+    unsigned long upper = PwmOuputController_GetUpperBound();
+
+    if(freq == 0) return 0;
+    if(freq < lower) return (target < freq) ? 0 : lower;
+    if(freq > upper) return upper;
+    return freq;
+}
+
+/* ***************PlanSCurve******************
+ * Plan the S-curve segments of a move from the ramp start to the target, in whole ticks
+ * Input: acceleration - The acceleration the frequency has at the start, up is positive
+ *                       {2^-SCURVE_FRACTION_BITS fine units per tick}
+ * Output: none
+ */
+void PlanSCurve(long long acceleration)
+{
+    bool up = (_rampTarget > _rampStart) || (( _rampTarget == _rampStart ) && ( acceleration > 0 ));
+    unsigned long distance = up ? (_rampTarget - _rampStart) : (_rampStart - _rampTarget);
+    long long jerk = ((long long)_jerk * FREQUENCY_FINE_SCALE << SCURVE_FRACTION_BITS) / ((long long)RAMP_TICK_FREQ * RAMP_TICK_FREQ);
+    long long rate = ((long long)(up ? _acceleration : _deceleration) * FREQUENCY_FINE_SCALE << SCURVE_FRACTION_BITS) / RAMP_TICK_FREQ;
+    long long total = (long long)distance << SCURVE_FRACTION_BITS;
+    long long initial = up ? acceleration : -acceleration;
+    long long startTicks;
+    long long peakTicks = 0;
+    long long jerkTicks;
+    long long reach;
+    long long peak;
+
+    if(jerk == 0) jerk = 1;
+    if(initial > rate) initial = rate;
+    _sCurveTick = 0;
+
+    /* Away from the target, or too fast to stop before it: take the acceleration down to 0 first */
+    startTicks = ((initial < 0) ? (-initial + jerk - 1) : (initial + jerk - 1)) / jerk;
+    if(( initial < 0 ) || (( initial * startTicks ) > ( 2 * total )))
+    {
+        _sCurveUp = (initial < 0) ? !up : up;
+        if(initial < 0) initial = -initial;
+        _sCurveStopping = true;
+        _sCurveStartTicks = startTicks;
+        _sCurvePeakTicks = 0;
+        _sCurveJerkTicks = 0;
+        _sCurveInitial = initial;
+        _sCurvePeak = 0;
+        _sCurveDistance = ((initial * startTicks) + (1 << SCURVE_FRACTION_BITS)) >> (SCURVE_FRACTION_BITS + 1);
+        return;
+    }
+
+    /* The ticks to reach the rate from the initial acceleration and to fall from it, and the distance they cover */
+    startTicks = (rate - initial + jerk - 1) / jerk;
+    jerkTicks = (rate + jerk - 1) / jerk;
+    reach = ((startTicks * (initial + rate)) + (jerkTicks * rate)) / 2;
+
+    if(reach <= total)
+    {
+        peakTicks = (total - reach + rate - 1) / rate;
+    }
+    else
+    {
+        /* Too short to reach the rate, Ap^2 = jerk * D + A0^2 / 2 */
+        peak = SquareRootCeil((unsigned long long)((jerk * total) + ((initial * initial) / 2)));
+        startTicks = (peak - initial + jerk - 1) / jerk;
+        jerkTicks = (peak + jerk - 1) / jerk;
+    }
+
+    /* The peak that makes the area under the acceleration exactly the distance */
+    peak = ((2 * total) - (startTicks * initial)) / (startTicks + (2 * peakTicks) + jerkTicks);
+    if(peak < 0) peak = 0;
+
+    _sCurveUp = up;
+    _sCurveStopping = false;
+    _sCurveStartTicks = startTicks;
+    _sCurvePeakTicks = peakTicks;
+    _sCurveJerkTicks = jerkTicks;
+    _sCurveInitial = initial;
+    _sCurvePeak = peak;
+    _sCurveDistance = distance;
+}
+
+/* ***************SCurveOffset******************
+ * The distance covered by the S-curve at a tick, from the closed form of its segment
+ * Input: tick - The ticks elapsed since the S-curve started
+ * Output: unsigned long - the distance {1/FREQUENCY_FINE_SCALE Hz}
+ */
+unsigned long SCurveOffset(unsigned long tick)
+{
+    long long n1 = _sCurveStartTicks;
+    long long peakEnd = n1 + _sCurvePeakTicks;
+    long long total = peakEnd + _sCurveJerkTicks;
+    long long k = tick;
+    long long offset;
+
+    if(k >= total) return _sCurveDistance;
+    if(( n1 != 0 ) && ( k <= n1 )) offset = ((_sCurveInitial * k) + (((_sCurvePeak - _sCurveInitial) * k * k) / (2 * n1))) >> SCURVE_FRACTION_BITS;
+    else if(k <= peakEnd) offset = ((((_sCurveInitial + _sCurvePeak) * n1) / 2) + (_sCurvePeak * (k - n1))) >> SCURVE_FRACTION_BITS;
+    else offset = _sCurveDistance - (((_sCurvePeak * (total - k) * (total - k)) / (2 * (long long)_sCurveJerkTicks)) >> SCURVE_FRACTION_BITS);
+
+    if(offset < 0) return 0;
+    if(offset > _sCurveDistance) return _sCurveDistance;
+    return offset;
+}
+
+/* ***************CurrentAcceleration******************
+ * The acceleration of the ramp in progress: the slope of the S-curve at its tick, or the rate of the linear ramp
+ * Input: none
+ * Output: long long - the acceleration, up is positive {2^-SCURVE_FRACTION_BITS fine units per tick}
+ */
+long long CurrentAcceleration(void)
+{
+    long long n1 = _sCurveStartTicks;
+    long long peakEnd = n1 + _sCurvePeakTicks;
+    long long total = peakEnd + _sCurveJerkTicks;
+    long long k = _sCurveTick;
+    long long acceleration;
+
+    if(!_rampRunning) return 0;
+    if(!_sCurve)
+    {
+        acceleration = ((long long)((_rampTarget > _rampFrequency) ? _acceleration : _deceleration) * FREQUENCY_FINE_SCALE << SCURVE_FRACTION_BITS) / RAMP_TICK_FREQ;
+        return (_rampTarget > _rampFrequency) ? acceleration : -acceleration;
+    }
+
+    if(k >= total) acceleration = 0;
+    else if(k < n1) acceleration = _sCurveInitial + (((_sCurvePeak - _sCurveInitial) * k) / n1);
+    else if(k <= peakEnd) acceleration = _sCurvePeak;
+    else acceleration = (_sCurvePeak * (total - k)) / (long long)_sCurveJerkTicks;
+
+    return _sCurveUp ? acceleration : -acceleration;
+}
+
+/* ***************SquareRootCeil******************
+ * The square root of a number, rounded up
+ * Input: value - The number
+ * Output: unsigned long - the smallest root whose square is not below the number
+ */
+unsigned long SquareRootCeil(unsigned long long value)
+{
+    unsigned long long root = 0;
+    unsigned long long bit = 1ULL << 62;
+
+    /* One result bit per iteration, from the highest one down */
+    while(bit > value) bit >>= 2;
+    while(bit != 0)
+    {
+        if(value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (unsigned long)((value != 0) ? (root + 1) : root);
+}
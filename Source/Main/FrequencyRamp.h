@@ -0,0 +1,100 @@
+/*
+ * FrequencyRamp.h
+ *
+ * Ramps the fundamental frequency towards a target at a rate in Hz/s, paced by TIMER2,
+ *  so the main loop keeps running along the whole ramp.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#ifndef SOURCE_MAIN_FREQUENCYRAMP_H_
+#define SOURCE_MAIN_FREQUENCYRAMP_H_
+
+#include <stdbool.h>
+
+/* The rate of the ramp steps {Hz} */
+#define RAMP_TICK_FREQ 100
+/* The default acceleration and deceleration {Hz/s} */
+#define RAMP_DEFAULT_RATE 20
+/* The default jerk of the S-curve profile {Hz/s^2} */
+#define RAMP_DEFAULT_JERK 40
+/* The progress of a finished ramp {0.1 %} */
+#define RAMP_PROGRESS_DONE 1000
+
+/* The shapes of the frequency ramp:
+ * RAMP_PROFILE_LINEAR - the frequency changes at the constant acceleration (or deceleration)
+ * RAMP_PROFILE_SCURVE - the acceleration itself rises and falls at the jerk limit, so it is
+ *                       continuous at the start and at the end of the ramp */
+typedef enum {RAMP_PROFILE_LINEAR, RAMP_PROFILE_SCURVE} RampProfile;
+
+/* ***************FrequencyRamp_Init******************
+ * Initialize the ramp at a frequency and start the timer that paces it.
+ * From here on the frequency must only be changed through this module.
+ * Input: freq - The current fundamental frequency {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: none
+ */
+void FrequencyRamp_Init(unsigned long freq);
+
+/* ***************FrequencyRamp_SetRates******************
+ * Update the acceleration and the deceleration, a linear ramp in progress follows them right
+ *  away and an S-curve from its next target. A rate of 0 makes the frequency jump straight to the target.
+ * Input: acceleration - The rate while the frequency goes up {Hz/s}
+ *        deceleration - The rate while the frequency goes down {Hz/s}
+ * Output: none
+ */
+void FrequencyRamp_SetRates(unsigned int acceleration, unsigned int deceleration);
+
+/* ***************FrequencyRamp_SetProfile******************
+ * Select the shape of the next ramps. The S-curve keeps the acceleration within the rates
+ *  and its change within the jerk, a jerk of 0 gives the linear profile.
+ * Input: profile - The ramp shape {RampProfile}
+ *        jerk - The highest change of the acceleration {Hz/s^2}
+ * Output: none
+ */
+void FrequencyRamp_SetProfile(RampProfile profile, unsigned int jerk);
+
+/* ***************FrequencyRamp_MoveTo******************
+ * Start a ramp from the current frequency towards a new target. A linear ramp in progress
+ *  just takes the new target, an S-curve is planned again from the frequency and the acceleration reached
+ * Input: freq - The target frequency {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: none
+ */
+void FrequencyRamp_MoveTo(unsigned long freq);
+
+/* ***************FrequencyRamp_SetFrequency******************
+ * Cancel any ramp and output a frequency right away
+ * Input: freq - The new frequency {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: none
+ */
+void FrequencyRamp_SetFrequency(unsigned long freq);
+
+/* ***************FrequencyRamp_Cancel******************
+ * Cancel the ramp in progress, the frequency reached so far is kept
+ * Input: none
+ * Output: none
+ */
+void FrequencyRamp_Cancel(void);
+
+/* ***************FrequencyRamp_IsRunning******************
+ * Returns if a ramp is in progress
+ * Input: none
+ * Output: bool - true while the frequency is still moving towards the target
+ */
+bool FrequencyRamp_IsRunning(void);
+
+/* ***************FrequencyRamp_GetFrequency******************
+ * Returns the frequency currently output
+ * Input: none
+ * Output: unsigned long - the frequency {1/FREQUENCY_FINE_SCALE Hz}
+ */
+unsigned long FrequencyRamp_GetFrequency(void);
+
+/* ***************FrequencyRamp_GetProgress******************
+ * Returns how much of the last ramp is done
+ * Input: none
+ * Output: unsigned int - the progress {0.1 %}, RAMP_PROGRESS_DONE once finished or cancelled
+ */
+unsigned int FrequencyRamp_GetProgress(void);
+
+#endif /* SOURCE_MAIN_FREQUENCYRAMP_H_ */
@@ -7,25 +7,40 @@
  *
  * The amount of interrupts that represents the full pwm cycle can be calculated by:
  * 233280/(72 * wf)
- * Where wf is the fundamental frequency that can tour from 30 all the way up to 90
+ * Where wf is the fundamental frequency, from FREQUENCY_RANGE_LOWER up to FREQUENCY_RANGE_UPPER.
  *
  * With the value of the total interrupts per pwm cycle we can calculate the table of TONs
  * That will be outputed along the sine wave. To calculate it we can do:
  * RoundToNearest(Interrupts per pwm cycle * SinOutTable[i]) = TON[i]
- * Where SinOutTable is a fixed table with 36 values representing the output of:
+ * Where SinOutTable is the shared half sine wave table (SineTable.h), in 16 bits fixed point:
  * sin(x) with 0 < x <= 180, where x is increased in units of 5 (5, 10, 15 ... 175, 180).
  *
+ * The NCO mode reads the sine from a phase accumulator instead of the table, and the backend
+ * (PWM_OUTPUT_BACKEND) selects what outputs the pwm cycles: the Systick Interrupt, the PWM0
+ * generator, the uDMA or the three-phase legs. Each part is described at its own functions.
+ *
  *  Created on: Nov 8, 2018
  *      Author: GMAGRI
  */
 
+#include "../DeviceDrivers/ADCT0ATrigger.h"
 #include "../DeviceDrivers/Debug.h"
+#include "../DeviceDrivers/PWM.h"
+#include "../DeviceDrivers/Timer1.h"
+#include "../DeviceDrivers/Timer2.h"
+#include "../DeviceDrivers/uDMA.h"
+#include "DriveAcquisition.h"
 #include "PwmOutputController.h"
+#include "SineTable.h"
+#include "TonTableBank.h"
 #include "tm4c123gh6pm.h"
 #include <stdint.h>
 #include <stdbool.h>
 #include "driverlib/interrupt.h"
 
+/* The sample slot that no Systick Interrupt reaches, while the current isn't sampled by the modulator */
+#define SAMPLE_SLOT_NONE 0xFFFFFFFF
+
 
 //////////////////////////////////////////////////////////////////////////////
 ////////////////      LOCAL FUNCTIONS PROTOTYPES    //////////////////////////
@@ -37,12 +52,6 @@ void Systick_Init(void);
 /* Initialize the pins use to output the pwm signal */
 void PwmPinsInit(void);
 
-/* Make the current selected pwm pin HI {1} */
-void PwmPinOn(void);
-
-/* Make the current selected pwm pin LOW {0} */
-void PwmPinOff(void);
-
 /* Toogle the pin within every Systick Interrupt, used for debug */
 void InterruptPinToogle(void);
 
@@ -50,7 +59,13 @@ void InterruptPinToogle(void);
 void DebugPinToogle(void);
 
 /* Recalculate the entire ton table base on the current setted frequency */
-void UpdateTonTable(void);
+void UpdateTonTable(volatile TonTable *table);
+
+/* The modulation index of a frequency from the V/f curve */
+unsigned long VfModulationIndex(unsigned long freq);
+
+/* The carrier ratio of a frequency */
+unsigned int CarrierRatio(unsigned long freq);
 
 /* Evaluate if it was required to start the motor */
 bool CheckForStartRequired(void);
@@ -61,8 +76,101 @@ bool CheckForStopRequired(void);
 /* Update the current index within the ton table */
 void UpdateIndex(void);
 
-/* Copy the preTonTable update value into the current ton table */
-void CopyPreTonIntoTon(void);
+/* Make the pending ton table the active one */
+void SwapTonTable(void);
+
+/* Make the pending NCO settings the active ones */
+void SwapNcoSettings(void);
+
+/* Calculate and publish the NCO settings of a frequency */
+void UpdateNcoSettings(unsigned long freq);
+
+/* Advance the phase accumulator by one pwm cycle, returning the phase at its middle */
+unsigned long NextNcoPhase(void);
+
+/* The next random deviation of the pwm cycle */
+long NextCarrierDeviation(unsigned long spread);
+
+/* The magnitude of the sine of a phase */
+unsigned int PhaseToSine(unsigned long phase);
+
+/* The highest modulation index of the selected modulation strategy */
+unsigned long ModulationLimit(void);
+
+/* The clip level of the sine wave that outputs an overmodulated index */
+unsigned long OvermodulationClip(unsigned long index, bool spaceVector);
+
+/* Scale the magnitude of a sine by a modulation index, clipping it while overmodulated */
+unsigned int ShapeSine(unsigned int sine, unsigned long index);
+
+/* The modulation index of the active NCO settings, raised by the DC bus feed-forward */
+unsigned long ActiveModulationIndex(void);
+
+/* The magnitude of the sine of a phase, scaled by the active modulation index */
+unsigned int ModulatedSine(unsigned long phase);
+
+/* Update the feed-forward gain from the DC bus of a new frame of the drive acquisition */
+void UpdateBusGain(void);
+
+/* Scale a ton by the DC bus feed-forward gain */
+unsigned int CompensateBusTon(unsigned int ton, unsigned int interrupts);
+
+/* Advance the phase accumulator by one pwm cycle */
+void NextNcoCycle(void);
+
+/* Evaluate if the active frequency of the selected mode can be output */
+bool HasFrequency(void);
+
+/* Load the next pwm cycle of the Systick backend */
+void LoadSystickCycle(void);
+
+/* Load an idle slot into the Systick backend, the pins stay LOW */
+void LoadSystickIdle(void);
+
+/* The current sample point within a pwm cycle */
+unsigned long SamplePoint(unsigned long on, unsigned long period);
+
+/* Load the ton of the current index into the hardware PWM generator */
+void LoadPwmCycle(void);
+
+/* Executed by the hardware PWM generator at the start of every pwm cycle */
+void PwmCycleTask(void);
+
+/* The length of a pwm cycle in PWM clocks */
+unsigned long PwmCyclePeriod(unsigned int interrupts);
+
+/* Convert a ton into PWM clocks */
+unsigned long TonToPwmClocks(unsigned int ton);
+
+/* Recalculate the comparator values streamed by the uDMA */
+void UpdateStreamedTables(const volatile TonTable *table);
+
+/* Arm the uDMA channels to stream one sine cycle of the given table */
+void ArmStreams(unsigned int table, bool alternate);
+
+/* Start or stop the uDMA streaming according to the requests */
+void UpdateStreamingState(void);
+
+/* Executed when the uDMA finishes streaming a sine cycle */
+void StreamedSineCycleTask(void);
+
+/* The HI time of the high side of a three-phase leg */
+unsigned long LegWidth(unsigned long phase, unsigned long period);
+
+/* The HI times of the high sides of the three legs from the space vector */
+void SpaceVectorWidths(unsigned long phase, unsigned long period, unsigned long widths[3]);
+
+/* Clip the swing of a three-phase leg at the whole pwm cycle */
+unsigned long ClipLegWidth(unsigned long width, unsigned long period, unsigned long clip);
+
+/* Compensate the dead time into the HI time of a three-phase leg */
+unsigned long CompensateDeadTime(unsigned long width, unsigned long phase, unsigned long period);
+
+/* Load the next pwm cycle of the three legs into the PWM generators */
+void LoadThreePhaseCycle(void);
+
+/* Executed by the PWM0 generator 0 at the start of every three-phase pwm cycle */
+void ThreePhaseCycleTask(void);
 
 //////////////////////////////////////////////////////////////////////////////
 /////////////////////      GLOBAL VARIABLE    ////////////////////////////////
@@ -71,12 +179,102 @@ void CopyPreTonIntoTon(void);
 MotorState     _motorState    = SM_MOTOR_STOPPED;   // The motor control state initiate as stopped.
 PwmPin         _pwmPin        = PWM_PIN_HI;   // The pin that is currently selected for output.
 ButtonState    _buttonClicked = NONE_CLICKED; // The variable that holds the button events.
-TonTable       _preTonTable;
+PwmMode        _pwmMode       = PWM_MODE_TABLE; // The selected modulation mode
+PwmModulation  _modulation    = PWM_MODULATION_SPWM; // The selected modulation strategy of the three-phase legs
 unsigned int   _frequency     = 60;           // The variable that holds the fundamental frequency
+unsigned long  _fineFrequency = 6000;         // The fundamental frequency {1/FREQUENCY_FINE_SCALE Hz}
+unsigned long  _lowerBound = FREQUENCY_RANGE_LOWER; // The lowest frequency other than the idle {1/FREQUENCY_FINE_SCALE Hz}
+unsigned long  _upperBound = FREQUENCY_RANGE_UPPER; // The highest frequency {1/FREQUENCY_FINE_SCALE Hz}
+unsigned long  _modulationIndex = MODULATION_FULL; // The amplitude of the sine wave {1/65536}
+bool           _overmodulation = false;       // If the modulation index may rise above the full sine wave up to the six-step
+unsigned long  _vfCurve[VF_CURVE_POINTS];     // The modulation index of each V/f curve point {1/65536}
+unsigned int   _carrierRatio = PWM_CYCLE_WITHIN_FULL_SINE; // The selected carrier ratio, or CARRIER_RATIO_AUTO
+unsigned int   _carrierGear = 0;              // The current gear of the automatic carrier ratio
+unsigned int   _carrierFrequency = CARRIER_SYNCHRONOUS; // The asynchronous carrier frequency {Hz}, or CARRIER_SYNCHRONOUS
+bool           _ncoZeroCrossed = false;       // If the last pwm cycle crossed a zero of the sine wave
+unsigned int   _carrierSpread = 0;            // The band of the randomized carrier {%}, 0 for the fixed carrier
+unsigned long  _carrierLfsr = 0xACE1;         // The 16 bits LFSR that randomizes the carrier, never 0
+long           _ncoDeviation = 0;             // The deviation of the current pwm cycle {Systick Interrupts or PWM clocks}
+unsigned long  _deadTime = NS_TO_CLOCKS(PWM_DEAD_TIME_NS); // The dead time of the three-phase legs {core clocks}
+bool           _deadTimeCompensation = false; // If the dead time is compensated into the leg widths
+unsigned long  _currentLag = 0;               // The lag of the leg currents to their voltages {2^-32 sine wave}
+bool           _busCompensation = false;      // If the DC bus feed-forward is enabled
+unsigned long  _busNominal = 0;               // The sample of the rated DC bus {0 to 4095}
+unsigned long  _busVoltage = 0;               // The last sample of the DC bus {0 to 4095}
+unsigned long  _busGain = MODULATION_FULL;    // The DC bus feed-forward gain {1/65536}
+unsigned long  _busPeriods = 0;               // The control periods acquired when the gain was last updated
+unsigned long  _vfBaseFrequency = 0;          // The frequency of the last V/f curve point {1/FREQUENCY_FINE_SCALE Hz}, 0 without curve
 unsigned int   _interruptsInPwmCycle = 0;     // The variable that represents the amount of cycles that represent a full pwm cycle
-unsigned int   _tonTable[36];                 // The table that holds the dynamically calculated ton times
+volatile TonTable _tonTables[2];              // The two tables that hold the dynamically calculated ton times
+const volatile TonTable * volatile _activeTonTable = &_tonTables[0]; // The table being output by the interrupt
+const volatile TonTable * volatile _pendingTonTable = 0;             // The table waiting for the end of the half sine wave
 unsigned int   _tonIndex = 0;                 // The current indexes within ton Table
-unsigned long  _interruptsCounter = 0;        // The counter of already reached interrupts within motor Started state
+volatile NcoSettings _ncoSettings[2];         // The two buffers of the phase accumulator settings
+const volatile NcoSettings * volatile _activeNco = &_ncoSettings[0];  // The settings used by the interrupt
+const volatile NcoSettings * volatile _pendingNco = 0;                // The settings waiting for the next pwm cycle
+unsigned long  _ncoPhase = 0;                 // The phase accumulator, 2^32 is a full sine wave
+unsigned int   _ncoSine = 0;                  // The sine of the current pwm cycle {1/65536}
+SystickState   _systick = {{0, 0, 0, SAMPLE_SLOT_NONE}, {0, 0, 0, SAMPLE_SLOT_NONE}, 0, false}; // The current and next Systick slots
+unsigned long  _lateSlots = 0;                // The Systick slots the PendSV didn't finish in time
+#if PWM_ISR_PROFILING
+unsigned long  _isrCycles = 0;                // The core clock cycles spent into the pwm cycle interrupt of the PWM0 and uDMA backends
+unsigned long  _systickCycles = 0;            // The core clock cycles spent into the Systick Interrupt
+unsigned long  _pendSvCycles = 0;             // The core clock cycles spent into the PendSV, without the Systick Interrupts nested into it
+unsigned long  _systickWorstCycles = 0;       // The longest Systick Interrupt since the last read {core clocks}
+#endif
+bool           _sampleSynchronized = false;   // If the current is sampled by the modulator instead of TIMER0A
+unsigned short _samplePhase = SAMPLE_PHASE_ON_CENTER; // The current sample from the middle of the on-period {1/65536 pwm cycle}
+
+/* The gears of the automatic carrier ratio, the highest frequency of each one keeps the carrier at 7 kHz */
+static const CarrierGear _carrierGears[] = {
+    /* ratio, highest frequency {1/FREQUENCY_FINE_SCALE Hz} */
+    {1152,   607},
+    { 576,  1215},
+    { 288,  2430},
+    { 144,  4861},
+    {  72,  9722},
+    {  36, 19444},
+    {  18, 38888},
+    {   9, 0xFFFFFFFF}
+};
+#define CARRIER_GEARS (sizeof(_carrierGears) / sizeof(_carrierGears[0]))
+
+/* Scale a sine by a modulation index, the full index gives the very same sine */
+#define SCALE_SINE(sine, index) ((((sine) * (index)) + (1 << (SINE_TABLE_FRACTION_BITS - 1))) >> SINE_TABLE_FRACTION_BITS)
+
+/* The sine table point nearest to the angle of a ton table index (i + 1) * 5 degrees */
+#define TON_TO_SINE_INDEX(i) (((((i) + 1) * SINE_TABLE_POINTS + 18) / 36) - 1)
+
+/* The masked data addresses of the Systick backend pins, a write only changes that single pin */
+#define PWM_PIN_HI_DATA  (&GPIO_PORTB_DATA_BITS_R[0x01]) // PB0
+#define PWM_PIN_LOW_DATA (&GPIO_PORTB_DATA_BITS_R[0x02]) // PB1
+/* The length of the Systick slots while the motor is stopped, how often the start request is checked */
+#define SYSTICK_IDLE_INTERRUPTS 36
+/* The length of the LOW slot that replaces a slot the PendSV didn't finish in time */
+#define SYSTICK_LATE_INTERRUPTS 1
+
+/* The phase accumulator values of 120 and 240 degrees */
+#define PHASE_120 0x55555555
+#define PHASE_240 0xAAAAAAAA
+/* The phase accumulator values of 60 and 90 degrees */
+#define PHASE_60  0x2AAAAAAB
+#define PHASE_90  0x40000000
+/* The fractional bits of the phase increment of one Systick Interrupt or PWM clock. At FREQUENCY_RANGE_UPPER
+ *  one Systick Interrupt is 2^22.8 of phase, so 8 bits keep it within the 32 bits of incrementPerUnit */
+#define NCO_UNIT_FRACTION_BITS 8
+
+#if PWM_OUTPUT_BACKEND == PWM_BACKEND_UDMA
+#define UDMA_CHANNEL_HI  20                   // TIMER1A request, writes the comparator A (HI pin)
+#define UDMA_CHANNEL_LOW 21                   // TIMER1B request, writes the comparator B (LOW pin)
+/* Word transfers from an incrementing table into a fixed comparator, one per request */
+#define UDMA_STREAM_CONTROL (UDMA_CHCTL_DSTINC_NONE | UDMA_CHCTL_DSTSIZE_32 | UDMA_CHCTL_SRCINC_32 | \
+                             UDMA_CHCTL_SRCSIZE_32 | UDMA_CHCTL_ARBSIZE_1 | UDMA_CHCTL_XFERMODE_PINGPONG)
+unsigned long  _streamTables[2][108];         // The two streamed tables [OFF x 36 | compare x 36 | OFF x 36]
+unsigned long  _streamPeriods[2];             // The pwm cycle length of each streamed table
+unsigned long  _stagingTable[36];             // The last calculated comparator values
+unsigned long  _stagingPeriod;                // The pwm cycle length of the staging table
+unsigned int   _tablesToUpdate = 0;           // The amount of streamed tables still older than the staging one
+#endif
 
 
 //////////////////////////////////////////////////////////////////////////////
@@ -90,16 +288,34 @@ unsigned long  _interruptsCounter = 0;        // The counter of already reached
  */
 void PwmOuputController_Init(unsigned short freq)
 {
+#if PWM_OUTPUT_BACKEND == PWM_BACKEND_THREE_PHASE
+    _pwmMode = PWM_MODE_NCO;
+#endif
 
     /* Calls the function that update the sine frequency */
     PwmOuputController_UpdateFrequency(freq);
-    /* In the first execution consume the preTonTable */
-    //CopyPreTonIntoTon();
+    /* In the first execution the table is consumed right away */
+    SwapTonTable();
+    SwapNcoSettings();
 
     /* Initialize drivers */
+    Debug_CycleCounterInit(); // Used to measure the CPU load of the pwm output
     IntMasterEnable(); // Enable interrupts that are used within this module
+#if PWM_OUTPUT_BACKEND == PWM_BACKEND_HARDWARE
+    PWM0Gen0_Init(&PwmCycleTask, PWM_MAX_PERIOD); // Outputs stay LOW until the motor is started
+    PWM0Gen1_InitTrigger(PWM_MAX_PERIOD);         // The current sample, aligned with the generator 0
+#elif PWM_OUTPUT_BACKEND == PWM_BACKEND_THREE_PHASE
+    PWM0_InitThreePhase(&ThreePhaseCycleTask, PWM_MAX_PERIOD, _deadTime); // Outputs stay disabled until the motor is started
+#elif PWM_OUTPUT_BACKEND == PWM_BACKEND_UDMA
+    uDMA_Init();
+    uDMA_AssignChannel(UDMA_CHANNEL_HI, 0);
+    uDMA_AssignChannel(UDMA_CHANNEL_LOW, 0);
+    PWM0Gen0_InitStreamed(PWM_MAX_PERIOD);       // Outputs stay LOW until the motor is started
+    Timer1_Init(&StreamedSineCycleTask, PWM_MAX_PERIOD);
+#else
     PwmPinsInit();     // Initialize the Driver for the pwm pins
     Systick_Init();    // Initilize the Systick Interrupt
+#endif
 }
 
 /* ************Systick_Init*******************
@@ -114,6 +330,11 @@ void Systick_Init(void)
     NVIC_ST_RELOAD_R = DEFAULT_RELOAD;            // reload value
     NVIC_ST_CURRENT_R = 0;                        // any write to current clears it
     NVIC_SYS_PRI3_R = NVIC_SYS_PRI3_R&0x00FFFFFF; // priority 0
+    NVIC_SYS_PRI3_R = (NVIC_SYS_PRI3_R&0xFF00FFFF)|0x00E00000; // PendSV priority 7, below anything else
+    LoadSystickIdle();                            // the first slot keeps the pins LOW
+    _systick.cycle = _systick.next;
+    _systick.nextReady = true;                    // and so does the one after it
+    _systick.counter = 0;
     NVIC_ST_CTRL_R = 0x00000007;                  // enable with core clock and interrupts
 
 }
@@ -138,62 +359,459 @@ void PwmPinsInit(void)
 
 /* **************UpdateTonTable*********************
  * Update the table of Tons based on already calculated values
- * Input: none
+ * Input: table - the ton table to be calculated
  * Output: none
  */
-void UpdateTonTable(void)
+void UpdateTonTable(volatile TonTable *table)
 {
     int i=0;
     for(i=0; i<36; i++)
     {
         /* As both sine wave semicycles are equivalent we calculate and output base on one semicycle, wich leads to 36 points.
          * We first multiply the position of the sine wave table for the already calculated amount of interruts within one (1/36) pwm cycle
-         * The result of it is a double value that corresponds to the total pwm cycles that we need to stay in HI.
-         * By adding +0.5 and casting to int we are executing a "round to the nearest" with the ton value
-         * The pre ton table is full calculated into tihs routine and after is consulted to verify if there is updates or not */
-//        _preTonTable.preTonTable[i] = (int)((double)(_interruptsInPwmCycle * _SinOutTable[i]) + 0.5);
-        _tonTable[i] = (int)((double)(_interruptsInPwmCycle * _SinOutTable[i]) + 0.5);
+         * The result of it is a fixed point value that corresponds to the total pwm cycles that we need to stay in HI.
+         * By adding half of the fixed point unit and shifting the fraction out we are executing a "round to the nearest" with the ton value */
+        table->tonTable[i] = ((_interruptsInPwmCycle * ShapeSine(SineTable_HalfWave(TON_TO_SINE_INDEX(i)), _modulationIndex)) + (1 << (SINE_TABLE_FRACTION_BITS - 1))) >> SINE_TABLE_FRACTION_BITS;
+    }
+    table->interruptsInPwmCycle = _interruptsInPwmCycle;
+}
+
+/* **************VfModulationIndex*********************
+ * The modulation index of a frequency, interpolated between the two nearest V/f curve points
+ * Input: freq - the fundamental frequency {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: unsigned long - the modulation index {1/65536}
+ */
+unsigned long VfModulationIndex(unsigned long freq)
+{
+    unsigned long position;
+    unsigned int i;
+    unsigned long fraction;
+    unsigned long limit;
+
+    if(freq >= _vfBaseFrequency)
+    {
+        /* Past the base frequency the overmodulation keeps the V/f slope up to the six-step */
+        if(!_overmodulation || (_vfBaseFrequency == 0)) return MODULATION_FULL;
+        position = ((unsigned long long)freq * MODULATION_FULL) / _vfBaseFrequency;
+        limit = ModulationLimit();
+        return (position > limit) ? limit : position;
     }
 
-    /* Sinalize that the table is now updated with new values */
-//    _preTonTable.tState = UPDATED;
+    /* The curve point below the frequency, with 8 fractional bits */
+    position = ((freq * (VF_CURVE_POINTS - 1)) << 8) / _vfBaseFrequency;
+    i = position >> 8;
+    fraction = position & 0xFF;
+
+    return _vfCurve[i] + ((((long)_vfCurve[i + 1] - (long)_vfCurve[i]) * (long)fraction) >> 8);
 }
 
-/* **************CopyPreTonIntoTon*********************
- * Copy the preTonTable update value into the current ton table
+/* **************CarrierRatio*********************
+ * The carrier ratio of a frequency, the selected one or the one of the automatic gear.
+ * The gear shifts up as soon as the frequency is above its highest one, and back only
+ *  when it is 1/32 below the highest frequency of the previous gear.
+ * Input: freq - the fundamental frequency {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: unsigned int - the pwm cycles within the sine wave
+ */
+unsigned int CarrierRatio(unsigned long freq)
+{
+    unsigned long previous;
+
+    if(_carrierRatio != CARRIER_RATIO_AUTO) return _carrierRatio;
+
+    while(( _carrierGear < (CARRIER_GEARS - 1) ) && ( freq > _carrierGears[_carrierGear].highestFrequency ))
+    {
+        _carrierGear++;
+    }
+    while(_carrierGear > 0)
+    {
+        previous = _carrierGears[_carrierGear - 1].highestFrequency;
+        if(freq >= (previous - (previous >> 5))) break;
+        _carrierGear--;
+    }
+
+    return _carrierGears[_carrierGear].ratio;
+}
+
+/* **************SwapTonTable*********************
+ * Make the pending ton table the active one, if there is one.
+ * Only called from the interrupt, or before it is enabled.
  * Input: none
  * Output: none
  */
-void CopyPreTonIntoTon(void)
+void SwapTonTable(void)
 {
-    int i=0;
-    for(i=0; i<36; i++)
+    if(_pendingTonTable != 0)
     {
-        _tonTable[i] = _preTonTable.preTonTable[i];
+        _activeTonTable = _pendingTonTable;
+        _pendingTonTable = 0;
     }
-    _preTonTable.tState = CONSUMED;
 }
 
-/* ***********************PwmPinOn***********************
- * Make the current selected pwm pin HI {1}
+/* **************SwapNcoSettings*********************
+ * Make the pending NCO settings the active ones, if there are.
+ * Only called from the interrupt.
  * Input: none
  * Output: none
  */
-void PwmPinOn(void)
+void SwapNcoSettings(void)
+{
+    if(_pendingNco != 0)
+    {
+        _activeNco = _pendingNco;
+        _pendingNco = 0;
+    }
+}
+
+/* **************UpdateNcoSettings*********************
+ * Calculate the phase increment of a frequency over the pwm cycle of its carrier ratio,
+ *  or of the asynchronous carrier, and publish them to be taken at the next pwm cycle.
+ * The pwm cycle lasts about 1 / (ratio * f), so freq * Tpwm is nearly constant and the
+ *  64 bits math never overflows.
+ * Input: freq - the fundamental frequency {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: none
+ */
+void UpdateNcoSettings(unsigned long freq)
+{
+    volatile NcoSettings *settings;
+    unsigned long interrupts = 0;
+    unsigned long long clocks = 0;
+    unsigned int ratio = 0;
+    unsigned long nominal;
+    unsigned long spread;
+
+    if(_carrierFrequency != CARRIER_SYNCHRONOUS)
+    {
+        /* The asynchronous pwm cycle doesn't depend on the frequency */
+        if(freq != 0) interrupts = (INTERRUPT_FREQ + (_carrierFrequency / 2)) / _carrierFrequency;
+#if (PWM_OUTPUT_BACKEND == PWM_BACKEND_HARDWARE) || (PWM_OUTPUT_BACKEND == PWM_BACKEND_THREE_PHASE)
+        clocks = SYSTEM_CLOCK_FREQ / _carrierFrequency;
+        if(clocks > PWM_MAX_PERIOD) clocks = PWM_MAX_PERIOD;
+#endif
+    }
+    else
+    {
+        ratio = CarrierRatio(freq);
+        if(freq != 0)
+        {
+            interrupts = ((unsigned long long)INTERRUPT_FREQ * FREQUENCY_FINE_SCALE) / (ratio * (unsigned long long)freq);
+        }
+#if (PWM_OUTPUT_BACKEND == PWM_BACKEND_HARDWARE) || (PWM_OUTPUT_BACKEND == PWM_BACKEND_THREE_PHASE)
+        clocks = PwmCyclePeriod(interrupts);
+#endif
+    }
+
+    /* The real pwm cycle length in core clocks */
+#if (PWM_OUTPUT_BACKEND != PWM_BACKEND_HARDWARE) && (PWM_OUTPUT_BACKEND != PWM_BACKEND_THREE_PHASE)
+    clocks = interrupts * PWM_CLOCKS_PER_INTERRUPT;
+#endif
+
+    /* Withdraw the settings not consumed yet, so the interrupt can't swap while the other ones are written */
+    _pendingNco = 0;
+    settings = (_activeNco == &_ncoSettings[0]) ? &_ncoSettings[1] : &_ncoSettings[0];
+    /* 80 MHz * 100 is a multiple of 256, so taking 8 bits out of both sides gives the same quotient */
+    settings->phaseIncrement = ((clocks * freq) << 24) / (((unsigned long long)SYSTEM_CLOCK_FREQ * FREQUENCY_FINE_SCALE) >> 8);
+    settings->interruptsInPwmCycle = interrupts;
+    settings->pwmPeriod = clocks;
+    settings->modulationIndex = _modulationIndex;
+    settings->carrierRatio = ratio;
+
+    /* The randomized carrier deviates in the units of the backend, keeping the pwm cycle countable */
+#if (PWM_OUTPUT_BACKEND == PWM_BACKEND_HARDWARE) || (PWM_OUTPUT_BACKEND == PWM_BACKEND_THREE_PHASE)
+    nominal = clocks;
+    spread = (nominal * _carrierSpread) / 100;
+    if(spread > (PWM_MAX_PERIOD - nominal)) spread = PWM_MAX_PERIOD - nominal;
+#else
+    nominal = interrupts;
+    spread = (nominal * _carrierSpread) / 100;
+#endif
+    if(spread >= (nominal / 2)) spread = (nominal < 4) ? 0 : (nominal / 2) - 1;
+    settings->spread = spread;
+    settings->incrementPerUnit = (nominal == 0) ? 0 : (((unsigned long long)settings->phaseIncrement << NCO_UNIT_FRACTION_BITS) / nominal);
+    _pendingNco = settings;
+}
+
+/* **************NextNcoPhase*********************
+ * Advance the phase accumulator by one pwm cycle, taking the pending settings
+ *  when allowed
+ * Input: none
+ * Output: unsigned long - the phase at the middle of the pwm cycle {2^-32 sine wave}
+ */
+unsigned long NextNcoPhase(void)
+{
+    unsigned long phase;
+    unsigned long next;
+    unsigned long increment;
+
+    /* A new carrier ratio is only taken at a zero crossing, so the sine wave has no phase jump */
+    if(( _pendingNco != 0 ) && ( _ncoZeroCrossed || ( _pendingNco->carrierRatio == _activeNco->carrierRatio ) ))
+    {
+        SwapNcoSettings();
+    }
+
+    /* The randomized pwm cycle advances the phase by its own length */
+    increment = _activeNco->phaseIncrement;
+    _ncoDeviation = 0;
+    if(_activeNco->spread != 0)
+    {
+        _ncoDeviation = NextCarrierDeviation(_activeNco->spread);
+        increment += (long)(((long long)_ncoDeviation * (long long)_activeNco->incrementPerUnit) >> NCO_UNIT_FRACTION_BITS);
+    }
+
+    phase = _ncoPhase + (increment >> 1);
+    next = _ncoPhase + increment;
+    _ncoZeroCrossed = ((next ^ _ncoPhase) & 0x80000000) != 0;
+    _ncoPhase = next;
+
+    return phase;
+}
+
+/* **************NextCarrierDeviation*********************
+ * Shift the carrier LFSR and map it uniformly onto the deviations within the spread,
+ *  with a multiply instead of a division
+ * Input: spread - the highest deviation {Systick Interrupts or PWM clocks, below 32768}
+ * Output: long - the deviation of the next pwm cycle, from -spread to +spread
+ */
+long NextCarrierDeviation(unsigned long spread)
+{
+    /* Galois LFSR x^16 + x^14 + x^13 + x^11 + 1, all the 65535 non zero states */
+    _carrierLfsr = (_carrierLfsr >> 1) ^ ((0 - (_carrierLfsr & 1)) & 0xB400);
+
+    return (long)((_carrierLfsr * ((2 * spread) + 1)) >> 16) - (long)spread;
+}
+
+/* **************PhaseToSine*********************
+ * The magnitude of the sine of a phase, read from the nearest point of the
+ *  half sine wave table, where 0 and SINE_TABLE_POINTS are sin(0) and sin(180)
+ * Input: phase - the phase {2^-32 sine wave}
+ * Output: unsigned int - |sin(phase)| {1/65536}
+ */
+unsigned int PhaseToSine(unsigned long phase)
 {
-    if(_pwmPin == PWM_PIN_HI) GPIO_PORTB_DATA_R |= 0x01;
-    if(_pwmPin == PWM_PIN_LOW) GPIO_PORTB_DATA_R |= 0x02;
+    unsigned int k = (((unsigned long long)(phase & 0x7FFFFFFF) * SINE_TABLE_POINTS) + 0x40000000) >> 31;
+
+    return ((k == 0) || (k == SINE_TABLE_POINTS)) ? 0 : SineTable_HalfWave(k - 1);
 }
 
-/* ***********************PwmPinOff***********************
- * Make the current selected pwm pin LOW {0}
+/* **************ModulationLimit*********************
+ * The highest modulation index of the selected modulation strategy: the full sine wave,
+ *  or its six-step while the overmodulation is enabled
+ * Input: none
+ * Output: unsigned long - the modulation index {1/65536}
+ */
+unsigned long ModulationLimit(void)
+{
+    if(!_overmodulation) return MODULATION_FULL;
+#if PWM_OUTPUT_BACKEND == PWM_BACKEND_THREE_PHASE
+    if(_modulation == PWM_MODULATION_SVPWM) return MODULATION_SIX_STEP_SVPWM;
+#endif
+    return MODULATION_SIX_STEP;
+}
+
+/* **************OvermodulationClip*********************
+ * The level where the sine wave (or the space vector leg) is clipped at the whole pwm cycle so
+ *  its fundamental is the commanded one, interpolated between the two nearest table points.
+ * The tables were found by bisection of the fundamental of the clipped wave, it falls from
+ *  1.0 at the full sine wave to 0 at the six-step, where only the sign is left.
+ * Input: index - the modulation index {MODULATION_FULL to the six-step} {1/65536}
+ *        spaceVector - true for the space vector leg, false for the sine wave
+ * Output: unsigned long - the clip level {1/65536}
+ */
+unsigned long OvermodulationClip(unsigned long index, bool spaceVector)
+{
+    static const unsigned long sineClip[OVERMODULATION_POINTS] = {
+        65536, 64215, 62686, 60988, 59126, 57096, 54886, 52480, 49855,
+        46978, 43803, 40263, 36255, 31604, 25970, 18478,     0};
+    static const unsigned long spaceVectorClip[OVERMODULATION_POINTS] = {
+        65536, 65041, 64462, 63802, 63052, 62190, 61177, 59931, 58224,
+        55061, 51119, 46794, 41969, 36445, 29837, 21154,     0};
+    const unsigned long *clip = spaceVector ? spaceVectorClip : sineClip;
+    unsigned long sixStep = spaceVector ? MODULATION_SIX_STEP_SVPWM : MODULATION_SIX_STEP;
+    unsigned long position;
+    unsigned int i;
+    unsigned long fraction;
+
+    if(index >= sixStep) return 0;
+    if(index <= MODULATION_FULL) return MODULATION_FULL;
+
+    /* The table point below the index, with 8 fractional bits */
+    position = (((index - MODULATION_FULL) * (OVERMODULATION_POINTS - 1)) << 8) / (sixStep - MODULATION_FULL);
+    i = position >> 8;
+    fraction = position & 0xFF;
+
+    return clip[i] - (((clip[i] - clip[i + 1]) * fraction) >> 8);
+}
+
+/* **************ShapeSine*********************
+ * Scale the magnitude of a sine by a modulation index. Above the full sine wave it is
+ *  divided by the clip level instead and held at the whole pwm cycle from there up
+ * Input: sine - |sin| {1/65536}
+ *        index - the modulation index {1/65536}
+ * Output: unsigned int - the scaled sine {1/65536}, MODULATION_FULL once clipped
+ */
+unsigned int ShapeSine(unsigned int sine, unsigned long index)
+{
+    unsigned long clip;
+
+    if(index <= MODULATION_FULL) return SCALE_SINE(sine, index);
+
+    /* At the six-step the clip level is 0 and anything is clipped, the zero crossing included */
+    clip = OvermodulationClip(index, false);
+    if(sine >= clip) return MODULATION_FULL;
+    return ((unsigned long)sine << SINE_TABLE_FRACTION_BITS) / clip;
+}
+
+/* **************ActiveModulationIndex*********************
+ * The modulation index of the active NCO settings, raised by the DC bus feed-forward
+ *  and kept within the limit of the modulation strategy
+ * Input: none
+ * Output: unsigned long - the modulation index {1/65536}
+ */
+unsigned long ActiveModulationIndex(void)
+{
+    unsigned long index = _activeNco->modulationIndex;
+    unsigned long limit = ModulationLimit();
+
+    if(_busCompensation) index = ((unsigned long long)index * _busGain) >> 16;
+
+    return (index > limit) ? limit : index;
+}
+
+/* **************ModulatedSine*********************
+ * The magnitude of the sine of a phase, scaled by the modulation index of the active NCO settings
+ * Input: phase - the phase {2^-32 sine wave}
+ * Output: unsigned int - |sin(phase)| * modulation index {1/65536}
+ */
+unsigned int ModulatedSine(unsigned long phase)
+{
+    return ShapeSine(PhaseToSine(phase), ActiveModulationIndex());
+}
+
+/* **************UpdateBusGain*********************
+ * Update the feed-forward gain from the DC bus of each new frame of the drive acquisition,
+ *  called once per pwm cycle before it is calculated. The frames come at ACQUISITION_FREQ,
+ *  a pwm cycle without a new one keeps the gain and only reads the period counter
  * Input: none
  * Output: none
  */
-void PwmPinOff(void)
+void UpdateBusGain(void)
 {
-    if(_pwmPin == PWM_PIN_HI) GPIO_PORTB_DATA_R &= ~0x01;
-    if(_pwmPin == PWM_PIN_LOW) GPIO_PORTB_DATA_R &= ~0x02;
+    unsigned long periods;
+    unsigned long bus;
+
+    if(!_busCompensation) return;
+    periods = DriveAcquisition_GetPeriods();
+    if(periods == _busPeriods) return;
+    _busPeriods = periods;
+
+    bus = DriveAcquisition_GetValue(ACQUISITION_BUS);
+    _busVoltage = bus;
+
+    /* nominal / bus, held at BUS_GAIN_MAX when the bus is below half of the nominal */
+    if((bus * (BUS_GAIN_MAX / MODULATION_FULL)) <= _busNominal) _busGain = BUS_GAIN_MAX;
+    else _busGain = (_busNominal << 16) / bus;
+}
+
+/* **************CompensateBusTon*********************
+ * Scale a ton of the table mode by the DC bus feed-forward gain
+ * Input: ton - the ton {Systick Interrupts}
+ *        interrupts - the pwm cycle length, the highest ton {Systick Interrupts}
+ * Output: unsigned int - the compensated ton {Systick Interrupts}
+ */
+unsigned int CompensateBusTon(unsigned int ton, unsigned int interrupts)
+{
+    unsigned long compensated;
+
+    if(!_busCompensation) return ton;
+    compensated = ((ton * _busGain) + (1 << (SINE_TABLE_FRACTION_BITS - 1))) >> SINE_TABLE_FRACTION_BITS;
+
+    return (compensated > interrupts) ? interrupts : compensated;
+}
+
+/* **************NextNcoCycle*********************
+ * Advance the phase accumulator by one pwm cycle, selecting the pin
+ *  and the sine at the middle of the pwm cycle.
+ * Input: none
+ * Output: none
+ */
+void NextNcoCycle(void)
+{
+    unsigned long phase = NextNcoPhase();
+
+    /* The second half of the sine wave is output by the LOW pin */
+    _pwmPin = (phase & 0x80000000) ? PWM_PIN_LOW : PWM_PIN_HI;
+    _ncoSine = ModulatedSine(phase);
+}
+
+/* **************HasFrequency*********************
+ * Evaluate if the active frequency of the selected mode can be output
+ * Input: none
+ * Output: bool
+ */
+bool HasFrequency(void)
+{
+    if(_pwmMode == PWM_MODE_NCO) return (_activeNco->interruptsInPwmCycle != 0);
+    return (_activeTonTable->interruptsInPwmCycle != 0);
+}
+
+/* **************LoadSystickCycle*********************
+ * Load the pin, the ton and the length of the next slot of the Systick backend,
+ *  from the ton table or from the phase accumulator.
+ * Input: none
+ * Output: none
+ */
+void LoadSystickCycle(void)
+{
+    volatile SystickSlot *next = &_systick.next;  // written before the Systick Interrupt is told it is ready
+    unsigned int interrupts;
+    unsigned int ton;
+
+    UpdateBusGain();
+
+    if(_pwmMode == PWM_MODE_NCO)
+    {
+        NextNcoCycle();
+        interrupts = _activeNco->interruptsInPwmCycle + _ncoDeviation;
+        ton = (((unsigned long long)interrupts * _ncoSine) + (1 << (SINE_TABLE_FRACTION_BITS - 1))) >> SINE_TABLE_FRACTION_BITS;
+    }
+    else
+    {
+        interrupts = _activeTonTable->interruptsInPwmCycle;
+        ton = CompensateBusTon(_activeTonTable->tonTable[_tonIndex], interrupts);
+    }
+    next->ton = ton;
+    next->interrupts = interrupts;
+    next->pin = (_pwmPin == PWM_PIN_HI) ? PWM_PIN_HI_DATA : PWM_PIN_LOW_DATA;
+    next->sample = _sampleSynchronized ? SamplePoint(ton, interrupts) : SAMPLE_SLOT_NONE;
+}
+
+/* **************LoadSystickIdle*********************
+ * Load an idle slot into the Systick backend, the pins stay LOW
+ * Input: none
+ * Output: none
+ */
+void LoadSystickIdle(void)
+{
+    volatile SystickSlot *next = &_systick.next;
+
+    next->ton = 0;
+    next->interrupts = SYSTICK_IDLE_INTERRUPTS;
+    next->pin = PWM_PIN_HI_DATA;
+    /* The idle slots keep sampling, the offset of the current sensor */
+    next->sample = _sampleSynchronized ? SamplePoint(0, SYSTICK_IDLE_INTERRUPTS) : SAMPLE_SLOT_NONE;
+}
+
+/* **************SamplePoint*********************
+ * The current sample point within a pwm cycle: the middle of the on-period
+ *  moved by the sample phase, wrapped into the pwm cycle
+ * Input: on - the on-time from the start of the pwm cycle {Systick Interrupts or PWM clocks}
+ *        period - the pwm cycle length {Systick Interrupts or PWM clocks}
+ * Output: unsigned long - the sample from the start of the pwm cycle {Systick Interrupts or PWM clocks}
+ */
+unsigned long SamplePoint(unsigned long on, unsigned long period)
+{
+    unsigned long point = (on >> 1) + (((unsigned long long)period * _samplePhase) >> 16);
+
+    return (point >= period) ? (point - period) : point;
 }
 
 /* **************InterruptPinToogle*********************
@@ -203,7 +821,7 @@ void PwmPinOff(void)
  */
 void InterruptPinToogle(void)
 {
-    GPIO_PORTB_DATA_R =  (GPIO_PORTB_DATA_R ^ 0x04);
+    GPIO_PORTB_DATA_BITS_R[0x04] ^= 0x04; // PB2 alone, the other pins are never written
 }
 
 /* **************InterruptPinToogle*********************
@@ -213,7 +831,7 @@ void InterruptPinToogle(void)
  */
 void DebugPinToogle(void)
 {
-    GPIO_PORTB_DATA_R =  (GPIO_PORTB_DATA_R ^ 0x08);
+    GPIO_PORTB_DATA_BITS_R[0x08] ^= 0x08; // PB3 alone, the other pins are never written
 }
 
 /* ***************PwmOuputController_Start******************
@@ -230,6 +848,11 @@ void PwmOuputController_Start(void)
         /* Signalize the intention to start the motor */
         _buttonClicked = START_CLICKED;
     }
+#if PWM_OUTPUT_BACKEND == PWM_BACKEND_UDMA
+    Timer2_DisableInterrupt();                   // the ramp step updates the streaming state too
+    UpdateStreamingState();
+    Timer2_EnableInterrupt();
+#endif
 }
 
 /* ***************PwmOuputController_Stop******************
@@ -246,6 +869,11 @@ void PwmOuputController_Stop(void)
         /* Signalize the intention to start the motor */
         _buttonClicked = STOP_CLICKED;
     }
+#if PWM_OUTPUT_BACKEND == PWM_BACKEND_UDMA
+    Timer2_DisableInterrupt();                   // the ramp step updates the streaming state too
+    UpdateStreamingState();
+    Timer2_EnableInterrupt();
+#endif
 }
 
 /* ***************CheckForStartRequired******************
@@ -280,7 +908,6 @@ MotorState Control_GetMotorState(void) {
 /* ***************CheckForStopRequired******************
  * Update the current index within the ton table;
  * Toogle the current selected pwm pin;
- * Reset the interrupts counter;
  * Input: none
  * Output: none
  */
@@ -297,16 +924,11 @@ void UpdateIndex(void)
        if(_pwmPin == PWM_PIN_HI) _pwmPin = PWM_PIN_LOW;
        else if(_pwmPin == PWM_PIN_LOW) _pwmPin = PWM_PIN_HI;
 
-//       /* At the end of a full sine wave cycle verify if there is new ton table */
-//       if( _preTonTable.tState == UPDATED )
-//       {
-//           /* Consume it */
-//           CopyPreTonIntoTon();
-//       }
+       /* At the end of a half sine wave verify if there is new ton table */
+       SwapTonTable();
 
        _tonIndex = 0;
     }
-    _interruptsCounter = 0;
 }
 
 /* **********PwmOuputController_UpdateFrequency************
@@ -316,91 +938,713 @@ void UpdateIndex(void)
  */
 void PwmOuputController_UpdateFrequency(unsigned short freq)
 {
+    PwmOuputController_UpdateFrequencyFine((unsigned long)freq * FREQUENCY_FINE_SCALE);
+}
+
+/* **********PwmOuputController_UpdateFrequencyFine************
+ * Update the frequency set to the motor operate, with sub-hertz resolution.
+ * The ton table is updated with the nearest whole pwm cycle length, 0 is the idle.
+ * Input: freq - The new frequency {unsigned long} {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: none
+ */
+void PwmOuputController_UpdateFrequencyFine(unsigned long freq)
+{
+    const volatile TonTable *table = 0;
+    volatile TonTable *buffer;
+    unsigned int interrupts;
+
+    /* Keep any frequency but the idle within the bounds */
+    if(freq != 0)
+    {
+        if(freq < PwmOuputController_GetLowerBound()) freq = PwmOuputController_GetLowerBound();
+        if(freq > _upperBound) freq = _upperBound;
+    }
+
     /* Update the setted frequency */
-    _frequency = freq;
+    _fineFrequency = freq;
+    _frequency = (freq + (FREQUENCY_FINE_SCALE / 2)) / FREQUENCY_FINE_SCALE;
+    _modulationIndex = VfModulationIndex(freq);
+
+    if(_pwmMode == PWM_MODE_NCO) UpdateNcoSettings(freq);
+
+    /* Calculate the total interrupts units that compose the full pwm cycle, the idle has none */
+    interrupts = (freq == 0) ? 0 : ((unsigned long)INTERRUPT_FREQ * FREQUENCY_FINE_SCALE) / (PWM_CYCLE_WITHIN_FULL_SINE * freq);
+
+    /* Withdraw the table not consumed yet, so the interrupt can't swap while the other one is written */
+    _pendingTonTable = 0;
+
+#if TON_TABLE_BANK
+    /* Within the bank the table of the full sine wave is already calculated, whatever the fine frequency */
+    if(_modulationIndex == MODULATION_FULL) table = TonTableBank_Get(interrupts);
+#endif
+    _interruptsInPwmCycle = interrupts;
+    if(table == 0)
+    {
+        buffer = (_activeTonTable == &_tonTables[0]) ? &_tonTables[1] : &_tonTables[0];
+        UpdateTonTable(buffer);
+        table = buffer;
+    }
+    _pendingTonTable = table;
+#if PWM_OUTPUT_BACKEND == PWM_BACKEND_UDMA
+    UpdateStreamedTables(table);
+    UpdateStreamingState();
+#endif
+}
+
+/* **********PwmOuputController_SetFrequencyBounds************
+ * Update the frequency bounds, kept within the frequency range,
+ *  and bring the current frequency within them
+ * Input: lower - The lowest frequency, other than the idle {1/FREQUENCY_FINE_SCALE Hz}
+ *        upper - The highest frequency {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: none
+ */
+void PwmOuputController_SetFrequencyBounds(unsigned long lower, unsigned long upper)
+{
+    if(lower < FREQUENCY_RANGE_LOWER) lower = FREQUENCY_RANGE_LOWER;
+    if(upper > FREQUENCY_RANGE_UPPER) upper = FREQUENCY_RANGE_UPPER;
+    if(upper < lower) upper = lower;
+
+    Timer2_DisableInterrupt();
+    _lowerBound = lower;
+    _upperBound = upper;
+    if(( _fineFrequency != 0 ) && (( _fineFrequency < PwmOuputController_GetLowerBound() ) || ( _fineFrequency > upper )))
+    {
+        PwmOuputController_UpdateFrequencyFine(_fineFrequency);
+    }
+    Timer2_EnableInterrupt();
+}
+
+/* **********PwmOuputController_GetLowerBound************
+ * Returns the lowest frequency, other than the idle
+ * Input: none
+ * Output: unsigned long - the frequency {1/FREQUENCY_FINE_SCALE Hz}
+ */
+unsigned long PwmOuputController_GetLowerBound(void)
+{
+#if (PWM_OUTPUT_BACKEND == PWM_BACKEND_HARDWARE) || (PWM_OUTPUT_BACKEND == PWM_BACKEND_UDMA)
+    /* The pwm cycle of the table mode must fit into the generator */
+    if(( _pwmMode == PWM_MODE_TABLE ) && ( _lowerBound < PWM_TABLE_RANGE_LOWER )) return PWM_TABLE_RANGE_LOWER;
+#endif
+    return _lowerBound;
+}
+
+/* **********PwmOuputController_GetUpperBound************
+ * Returns the highest frequency
+ * Input: none
+ * Output: unsigned long - the frequency {1/FREQUENCY_FINE_SCALE Hz}
+ */
+unsigned long PwmOuputController_GetUpperBound(void)
+{
+    return _upperBound;
+}
+
+/* **********PwmOuputController_SetMode************
+ * Select the modulation mode, only allowed while the motor is stopped
+ * Input: mode - The modulation mode {PwmMode}
+ * Output: none
+ */
+void PwmOuputController_SetMode(PwmMode mode)
+{
+#if (PWM_OUTPUT_BACKEND != PWM_BACKEND_UDMA) && (PWM_OUTPUT_BACKEND != PWM_BACKEND_THREE_PHASE)
+    if( _motorState == SM_MOTOR_STOPPED )
+    {
+        Timer2_DisableInterrupt();
+        /* The NCO settings are only kept updated while the mode is selected */
+        if(( mode == PWM_MODE_NCO ) && ( _pwmMode != PWM_MODE_NCO )) UpdateNcoSettings(_fineFrequency);
+        _pwmMode = mode;
+        /* The table mode may have a higher lower bound */
+        if(( _fineFrequency != 0 ) && ( _fineFrequency < PwmOuputController_GetLowerBound() ))
+        {
+            PwmOuputController_UpdateFrequencyFine(_fineFrequency);
+        }
+        Timer2_EnableInterrupt();
+    }
+#else
+    (void)mode; // the uDMA backend only streams ton tables, the three-phase one only runs the NCO
+#endif
+}
+
+/* **********PwmOuputController_SetModulation************
+ * Select the modulation strategy of the three-phase backend,
+ *  only allowed while the motor is stopped
+ * Input: modulation - The modulation strategy {PwmModulation}
+ * Output: none
+ */
+void PwmOuputController_SetModulation(PwmModulation modulation)
+{
+    if( _motorState == SM_MOTOR_STOPPED )
+    {
+        Timer2_DisableInterrupt();
+        _modulation = modulation;
+        /* The six-step of the new strategy may be a different modulation index */
+        if(_overmodulation) PwmOuputController_UpdateFrequencyFine(_fineFrequency);
+        Timer2_EnableInterrupt();
+    }
+}
+
+/* **********PwmOuputController_SetVfCurve************
+ * Configure the volts per hertz curve that scales the sine wave and apply
+ *  the new modulation index to the current frequency.
+ * Input: curve - The V/f curve {VfCurve}
+ *        baseFrequency - The frequency of the rated voltage {Hz}
+ *        boost - The voltage at 0 Hz {0.1 % of the rated voltage}
+ * Output: none
+ */
+void PwmOuputController_SetVfCurve(VfCurve curve, unsigned short baseFrequency, unsigned short boost)
+{
+    int i = 0;
+    unsigned long x;
+    unsigned long index;
+    unsigned long boostIndex = ((unsigned long)boost * MODULATION_FULL) / 1000;
+
+    if(boostIndex > MODULATION_FULL) boostIndex = MODULATION_FULL;
+
+    /* The ramp step reads the curve */
+    Timer2_DisableInterrupt();
+    for(i=0; i<VF_CURVE_POINTS; i++)
+    {
+        /* The frequency of the point relative to the base one {1/65536} */
+        x = ((unsigned long)i * MODULATION_FULL) / (VF_CURVE_POINTS - 1);
+
+        if(curve == VF_CURVE_LINEAR) index = x;
+        else if(curve == VF_CURVE_QUADRATIC) index = (((unsigned long long)x * x) + (MODULATION_FULL / 2)) / MODULATION_FULL;
+        else index = MODULATION_FULL;
+
+        /* The boost lifts the curve at 0 Hz and fades out at the base frequency */
+        _vfCurve[i] = boostIndex + (((unsigned long long)(MODULATION_FULL - boostIndex) * index) / MODULATION_FULL);
+    }
+    _vfBaseFrequency = (curve == VF_CURVE_NONE) ? 0 : (unsigned long)baseFrequency * FREQUENCY_FINE_SCALE;
+
+    PwmOuputController_UpdateFrequencyFine(_fineFrequency);
+    Timer2_EnableInterrupt();
+}
+
+/* **********PwmOuputController_SetOvermodulation************
+ * Allow the modulation index above the full sine wave, up to the six-step,
+ *  and apply the new modulation index to the current frequency.
+ * Input: enable - true to allow the overmodulation
+ * Output: none
+ */
+void PwmOuputController_SetOvermodulation(bool enable)
+{
+    Timer2_DisableInterrupt();
+    _overmodulation = enable;
+
+    PwmOuputController_UpdateFrequencyFine(_fineFrequency);
+    Timer2_EnableInterrupt();
+}
+
+/* **********PwmOuputController_GetModulationIndex************
+ * Returns the modulation index applied to the current frequency
+ * Input: none
+ * Output: unsigned long - the modulation index {1/65536}
+ */
+unsigned long PwmOuputController_GetModulationIndex(void)
+{
+    return _modulationIndex;
+}
+
+/* **********PwmOuputController_SetCarrierRatio************
+ * Select the amount of pwm cycles within the sine wave of the NCO mode
+ * Input: ratio - The pwm cycles within the sine wave, or CARRIER_RATIO_AUTO
+ * Output: none
+ */
+void PwmOuputController_SetCarrierRatio(unsigned int ratio)
+{
+    Timer2_DisableInterrupt();
+    _carrierRatio = ratio;
+    if(_pwmMode == PWM_MODE_NCO) UpdateNcoSettings(_fineFrequency);
+    Timer2_EnableInterrupt();
+}
+
+/* **********PwmOuputController_GetCarrierRatio************
+ * Returns the carrier ratio of the current frequency
+ * Input: none
+ * Output: unsigned int - the pwm cycles within the sine wave
+ */
+unsigned int PwmOuputController_GetCarrierRatio(void)
+{
+    if(_pwmMode == PWM_MODE_NCO) return _activeNco->carrierRatio;
+    return PWM_CYCLE_WITHIN_FULL_SINE;
+}
+
+/* **********PwmOuputController_SetCarrierFrequency************
+ * Select an asynchronous carrier for the NCO mode
+ * Input: freq - The carrier frequency {Hz}, or CARRIER_SYNCHRONOUS
+ * Output: none
+ */
+void PwmOuputController_SetCarrierFrequency(unsigned int freq)
+{
+    Timer2_DisableInterrupt();
+    _carrierFrequency = freq;
+    if(_pwmMode == PWM_MODE_NCO) UpdateNcoSettings(_fineFrequency);
+    Timer2_EnableInterrupt();
+}
 
-    /* Calculate the total interrupts units that compose the full pwm cycle */
-    _interruptsInPwmCycle = INTERRUPT_FREQ / (PWM_CYCLE_WITHIN_FULL_SINE * _frequency);
+/* **********PwmOuputController_SetCarrierSpread************
+ * Randomize the pwm cycle of the NCO mode within a band around its nominal length
+ * Input: band - The highest deviation of each pwm cycle {% of the nominal pwm cycle}, 0 for the fixed carrier
+ * Output: none
+ */
+void PwmOuputController_SetCarrierSpread(unsigned int band)
+{
+    if(band > CARRIER_SPREAD_MAX) band = CARRIER_SPREAD_MAX;
+    Timer2_DisableInterrupt();
+    _carrierSpread = band;
+    if(_pwmMode == PWM_MODE_NCO) UpdateNcoSettings(_fineFrequency);
+    Timer2_EnableInterrupt();
+}
+
+/* **********PwmOuputController_SetDeadTime************
+ * Update the dead time between the high side and the low side of each three-phase leg
+ * Input: ns - The dead time {ns}
+ * Output: none
+ */
+void PwmOuputController_SetDeadTime(unsigned int ns)
+{
+    _deadTime = NS_TO_CLOCKS(ns);
+#if PWM_OUTPUT_BACKEND == PWM_BACKEND_THREE_PHASE
+    PWM0_SetThreePhaseDeadTime(_deadTime);
+#endif
+}
+
+/* **********PwmOuputController_SetDeadTimeCompensation************
+ * Enable or disable the dead time compensation of the three-phase legs
+ * Input: enable - true to compensate the dead time
+ *        currentLag - The lag of the current to the voltage of each leg {degrees}
+ * Output: none
+ */
+void PwmOuputController_SetDeadTimeCompensation(bool enable, unsigned short currentLag)
+{
+    _currentLag = (((unsigned long long)(currentLag % 360)) << 32) / 360;
+    _deadTimeCompensation = enable;
+}
+
+/* **********PwmOuputController_SetBusCompensation************
+ * Enable or disable the DC bus feed-forward
+ * Input: enable - true to compensate the DC bus
+ *        nominal - The sample of the rated DC bus {0 to 4095}
+ * Output: none
+ */
+void PwmOuputController_SetBusCompensation(bool enable, unsigned int nominal)
+{
+#if PWM_OUTPUT_BACKEND != PWM_BACKEND_UDMA
+    /* Start again from the unity gain, until the next frame */
+    _busCompensation = false;
+    _busNominal = nominal & 0xFFF;
+    _busGain = MODULATION_FULL;
+    _busPeriods = DriveAcquisition_GetPeriods();
+    _busCompensation = enable;
+#else
+    (void)enable;
+    (void)nominal;
+#endif
+}
+
+/* **********PwmOuputController_SetCurrentSampling************
+ * Select how the motor current ADC is triggered, by TIMER0A or by the modulator
+ * Input: synchronized - true to trigger the ADC from the modulator
+ *        phase - The sample from the middle of the on-period {1/65536 pwm cycle}
+ * Output: none
+ */
+void PwmOuputController_SetCurrentSampling(bool synchronized, unsigned short phase)
+{
+#if PWM_OUTPUT_BACKEND != PWM_BACKEND_UDMA
+    /* The next pwm cycle is loaded with the new point before the trigger moves to it */
+    _samplePhase = phase;
+    _sampleSynchronized = synchronized;
+#if PWM_OUTPUT_BACKEND == PWM_BACKEND_HARDWARE
+    ADC0_SetSeq3Trigger(synchronized ? ADC_TRIGGER_PWM1 : ADC_TRIGGER_TIMER);
+#elif PWM_OUTPUT_BACKEND == PWM_BACKEND_THREE_PHASE
+    PWM0_SetThreePhaseTrigger(synchronized, phase);
+    ADC0_SetSeq3Trigger(synchronized ? ADC_TRIGGER_PWM0 : ADC_TRIGGER_TIMER);
+#else
+    ADC0_SetSeq3Trigger(synchronized ? ADC_TRIGGER_PROCESSOR : ADC_TRIGGER_TIMER);
+#endif
+#else
+    (void)synchronized;
+    (void)phase;
+#endif
+}
 
-    UpdateTonTable();
+/* **********PwmOuputController_GetBusVoltage************
+ * Returns the last sample of the DC bus
+ * Input: none
+ * Output: unsigned int - the DC bus {0 to 4095}
+ */
+unsigned int PwmOuputController_GetBusVoltage(void)
+{
+    return _busVoltage;
 }
 
 unsigned int PwmOuputController_GetCurrentTon(void)
 {
-    return _tonTable[_tonIndex];
+    return _activeTonTable->tonTable[_tonIndex];
 }
 
-/* This is the ISR (Interrupt Service Routin) that handle the Systick Interrupts
- * The ISR is responsible mainly for the output of the pwm pins, based on the frequency
- *  and the motor state, and for updating the LEDs that sinalize the motor state to the user. */
-void SysTick_Handler(void)
+/* ************PwmOuputController_GetCpuLoad*******************
+ * Returns the share of the CPU spent into the pwm output interrupt
+ * of the selected backend since the last call to this function
+ * Input: none
+ * Output: unsigned int - the CPU load {0.1 %}
+ */
+unsigned int PwmOuputController_GetCpuLoad(void)
 {
+#if PWM_ISR_PROFILING
+    static unsigned long lastCycles = 0;
+    static unsigned long lastIsrCycles = 0;
+    unsigned long cycles = Debug_CycleCounterRead();
+    /* Each interrupt has its own sum, none of them is written by two priorities */
+    unsigned long isrCycles = _isrCycles + _systickCycles + _pendSvCycles;
+    unsigned long elapsed = (cycles - lastCycles) / 1000;
+    unsigned long busy = isrCycles - lastIsrCycles;
+
+    lastCycles = cycles;
+    lastIsrCycles = isrCycles;
+
+    if(elapsed == 0) return 0;
+    return busy / elapsed;
+#else
+    return 0;
+#endif
+}
+
+/* ************PwmOuputController_GetSystickWorstCycles*******************
+ * Returns the longest Systick Interrupt since the last call to this function, measured
+ * with the DWT cycle counter, and the slots the PendSV didn't calculate in time meanwhile
+ * Input: lateSlots - where to store the late slots, or 0
+ * Output: unsigned long - the longest Systick Interrupt {core clocks}
+ */
+unsigned long PwmOuputController_GetSystickWorstCycles(unsigned long *lateSlots)
+{
+    unsigned long worst = 0;
+
+#if PWM_ISR_PROFILING
+    worst = _systickWorstCycles;
+    _systickWorstCycles = 0;
+#endif
+    if(lateSlots != 0)
+    {
+        *lateSlots = _lateSlots;
+        _lateSlots = 0;
+    }
+    return worst;
+}
+
+/* ***************PwmCyclePeriod******************
+ * The length of a pwm cycle in PWM clocks.
+ * The table mode is kept above PWM_TABLE_RANGE_LOWER, where it always fits into
+ *  the 16 bits generator. A longer NCO pwm cycle is limited to PWM_MAX_PERIOD,
+ *  its phase increment being calculated over the limited length.
+ * Input: interrupts - the pwm cycle length {Systick Interrupts}
+ * Output: unsigned long - the pwm cycle length {PWM clocks}
+ */
+unsigned long PwmCyclePeriod(unsigned int interrupts)
+{
+    unsigned long period = interrupts * PWM_CLOCKS_PER_INTERRUPT;
+    if(period > PWM_MAX_PERIOD) period = PWM_MAX_PERIOD;
+    return period;
+}
+
+/* ***************TonToPwmClocks******************
+ * Convert a ton of the table mode into PWM clocks. The lower bound keeps
+ *  its pwm cycle within PWM_MAX_PERIOD, so the ton is never scaled.
+ * Input: ton - the ton {Systick Interrupts}
+ * Output: unsigned long - the ton {PWM clocks}
+ */
+unsigned long TonToPwmClocks(unsigned int ton)
+{
+    return ton * PWM_CLOCKS_PER_INTERRUPT;
+}
+
+/* ***************LoadPwmCycle******************
+ * Load the ton of the current index, or of the next phase accumulator step, into
+ *  the hardware PWM generator, it is applied by the generator at the start of the next pwm cycle.
+ * The selected pin outputs the ton while the other one stays LOW.
+ * Input: none
+ * Output: none
+ */
+void LoadPwmCycle(void)
+{
+    const volatile TonTable *table = _activeTonTable;
+    unsigned long period;
+    unsigned long width;
+
+    UpdateBusGain();
+    if(_pwmMode == PWM_MODE_NCO)
+    {
+        NextNcoCycle();
+        period = _activeNco->pwmPeriod + _ncoDeviation;
+        width = ((period * _ncoSine) + (1 << (SINE_TABLE_FRACTION_BITS - 1))) >> SINE_TABLE_FRACTION_BITS;
+    }
+    else
+    {
+        period = PwmCyclePeriod(table->interruptsInPwmCycle);
+        width = TonToPwmClocks(CompensateBusTon(table->tonTable[_tonIndex], table->interruptsInPwmCycle));
+    }
+
+    PWM0Gen0_SetPeriod(period);
+    if(_pwmPin == PWM_PIN_HI)
+    {
+        PWM0Gen0_SetDutyA(width);
+        PWM0Gen0_SetDutyB(0);
+    }
+    else
+    {
+        PWM0Gen0_SetDutyA(0);
+        PWM0Gen0_SetDutyB(width);
+    }
+    /* The trigger generator gets the same period, so it stays aligned even when unused */
+    PWM0Gen1_SetTrigger(period, SamplePoint((width > period) ? period : width, period));
+}
 
-    //InterruptPinToogle();
+/* This is the task executed by the PWM0 generator 0 interrupt at the start of every pwm cycle.
+ * It runs the same motor state machine of the Systick backend, but as the generator outputs
+ *  the whole pwm cycle by itself it only has to load the ton of the next one. */
+void PwmCycleTask(void)
+{
+#if PWM_ISR_PROFILING
+    unsigned long start = Debug_CycleCounterRead();
     Debug_TooglePin_1();
+#endif
 
-    /* Unique motor state machine routine */
     switch(_motorState)
     {
 
         case SM_MOTOR_STOPPED:
 
-            if(CheckForStartRequired())
+            /* A stopped motor has no frequency to output */
+            SwapTonTable();
+            SwapNcoSettings();
+            if(CheckForStartRequired() && HasFrequency())
             {
                 _motorState = SM_MOTOR_STARTED;
-                _interruptsCounter = 0;
                 _tonIndex = 0;
+                _ncoPhase = 0;
+                LoadPwmCycle();
             }
 
             break;
 
         case SM_MOTOR_STARTED:
 
-            if(CheckForStopRequired())
+            if(CheckForStopRequired() || !HasFrequency())
             {
-                PwmPinOff();
+                PWM0Gen0_SetDutyA(0);
+                PWM0Gen0_SetDutyB(0);
                 _motorState = SM_MOTOR_STOPPED;
+                _buttonClicked = NONE_CLICKED;   // stopped by the idle too, so only a new start restarts it
             }
             else
             {
+                if(_pwmMode == PWM_MODE_TABLE) UpdateIndex();
+                LoadPwmCycle();
+            }
+
+            break;
+
+        default:
+            break;
+    }
+
+#if PWM_ISR_PROFILING
+    Debug_TooglePin_1();
+    _isrCycles += Debug_CycleCounterRead() - start;
+#endif
+}
+
+/* ***************LegWidth******************
+ * The HI time of the high side of a three-phase leg, (1 + sin(phase)) / 2 of the pwm cycle
+ * Input: phase - the phase of the leg {2^-32 sine wave}
+ *        period - the pwm cycle length {PWM clocks}
+ * Output: unsigned long - the HI time {PWM clocks}
+ */
+unsigned long LegWidth(unsigned long phase, unsigned long period)
+{
+    unsigned long half = period >> 1;
+    unsigned long swing = ((half * ModulatedSine(phase)) + (1 << (SINE_TABLE_FRACTION_BITS - 1))) >> SINE_TABLE_FRACTION_BITS;
+
+    return (phase & 0x80000000) ? (half - swing) : (half + swing);
+}
+
+/* ***************SpaceVectorWidths******************
+ * The HI times of the high sides of the three legs, from the space vector of the phase.
+ * The reference vector is 90 degrees behind the phase, so the leg U follows sin(phase)
+ *  as with the sine modulation. Within each sector the leg on in both active vectors
+ *  is HI for T1 + T2 + T0/2, the leg on in one of them for T1 or T2 + T0/2 and the
+ *  leg off in both for T0/2.
+ * Input: phase - the phase of the leg U {2^-32 sine wave}
+ *        period - the pwm cycle length {PWM clocks}
+ *        widths - the HI times of the legs U, V and W {PWM clocks}
+ * Output: none
+ */
+void SpaceVectorWidths(unsigned long phase, unsigned long period, unsigned long widths[3])
+{
+    /* The angle where each sector starts, rounded down */
+    static const unsigned long sectorStart[6] = {0x00000000, 0x2AAAAAAA, 0x55555555, 0x80000000, 0xAAAAAAAA, 0xD5555555};
+    unsigned long angle = phase - PHASE_90;
+    unsigned int sector = ((unsigned long long)angle * 6) >> 32;
+    unsigned long alpha = angle - sectorStart[sector];
+    unsigned long index = ActiveModulationIndex();
+    unsigned long clip = MODULATION_FULL;
+    unsigned long t1;
+    unsigned long t2;
+    unsigned long t0;
+
+    /* Overmodulated, the full space vector is calculated and then its legs are clipped */
+    if(index > MODULATION_FULL)
+    {
+        clip = OvermodulationClip(index, true);
+        index = MODULATION_FULL;
+    }
+    t1 = ((period * SCALE_SINE(PhaseToSine(PHASE_60 - alpha), index)) + (1 << (SINE_TABLE_FRACTION_BITS - 1))) >> SINE_TABLE_FRACTION_BITS;
+    t2 = ((period * SCALE_SINE(PhaseToSine(alpha), index)) + (1 << (SINE_TABLE_FRACTION_BITS - 1))) >> SINE_TABLE_FRACTION_BITS;
+
+    /* The rounding of both dwell times may exceed the pwm cycle by one clock */
+    if((t1 + t2) > period) t2 = period - t1;
+    t0 = (period - t1 - t2) >> 1;
+
+    switch(sector)
+    {
+        case 0: // V1 (100) to V2 (110)
+            widths[0] = t1 + t2 + t0; widths[1] = t2 + t0;      widths[2] = t0;
+            break;
+        case 1: // V2 (110) to V3 (010)
+            widths[0] = t1 + t0;      widths[1] = t1 + t2 + t0; widths[2] = t0;
+            break;
+        case 2: // V3 (010) to V4 (011)
+            widths[0] = t0;           widths[1] = t1 + t2 + t0; widths[2] = t2 + t0;
+            break;
+        case 3: // V4 (011) to V5 (001)
+            widths[0] = t0;           widths[1] = t1 + t0;      widths[2] = t1 + t2 + t0;
+            break;
+        case 4: // V5 (001) to V6 (101)
+            widths[0] = t2 + t0;      widths[1] = t0;           widths[2] = t1 + t2 + t0;
+            break;
+        default: // V6 (101) to V1 (100)
+            widths[0] = t1 + t2 + t0; widths[1] = t0;           widths[2] = t1 + t0;
+            break;
+    }
 
-                /* Must verify that there is at least one cycle in ton at the first cycle*/
-                if( ( _interruptsCounter == 0 ) && ( _tonTable[_tonIndex] != 0 ) )
-                {
-                    PwmPinOn();
-                }
-
-                /* If reached the cycles values for ton and it's also the total number of pwm cycles
-                 * The function shall execute the pwm pin off, the resets and the pwm selected pin toogle
-                 * */
-                else if( ( _interruptsCounter == _tonTable[_tonIndex] ) && ( _interruptsCounter == _interruptsInPwmCycle ) )
-                {
-                    PwmPinOff();
-                    UpdateIndex();
-                    break;
-                }
-
-                /* If reached the cycles values for ton must make the pin off */
-                else if( _interruptsCounter == _tonTable[_tonIndex] )
-                {
-                    PwmPinOff();
-                }
-
-                /* If reached the total number of pwm cycles, the function shall execute
-                 *  the resets and the pwm selected pin toogle.
-                 * */
-                else if( _interruptsCounter >= _interruptsInPwmCycle )
-                {
-                    UpdateIndex();
-                    break;
-                }
-                else
-                {
-
-                }
-
-                _interruptsCounter++;
+    if(clip < MODULATION_FULL)
+    {
+        widths[0] = ClipLegWidth(widths[0], period, clip);
+        widths[1] = ClipLegWidth(widths[1], period, clip);
+        widths[2] = ClipLegWidth(widths[2], period, clip);
+    }
+}
 
+/* ***************ClipLegWidth******************
+ * Divide the swing of a three-phase leg around the middle of the pwm cycle by the clip level,
+ *  holding it at the whole pwm cycle (or at none) once it goes beyond
+ * Input: width - the HI time of the high side {PWM clocks}
+ *        period - the pwm cycle length {PWM clocks}
+ *        clip - the clip level {1/65536}, 0 for the six-step
+ * Output: unsigned long - the clipped HI time {PWM clocks}
+ */
+unsigned long ClipLegWidth(unsigned long width, unsigned long period, unsigned long clip)
+{
+    unsigned long half = period >> 1;
+    unsigned long swing = (width >= half) ? (width - half) : (half - width);
+
+    if((swing << SINE_TABLE_FRACTION_BITS) >= (half * clip)) swing = half;
+    else swing = (swing << SINE_TABLE_FRACTION_BITS) / clip;
+
+    return (width >= half) ? (half + swing) : (half - swing);
+}
+
+/* ***************CompensateDeadTime******************
+ * Compensate the dead time into the HI time of a three-phase leg: it is raised while
+ *  the current flows out of the leg and lowered while it flows in
+ * Input: width - the HI time of the high side {PWM clocks}
+ *        phase - the phase of the leg {2^-32 sine wave}
+ *        period - the pwm cycle length {PWM clocks}
+ * Output: unsigned long - the compensated HI time {PWM clocks}
+ */
+unsigned long CompensateDeadTime(unsigned long width, unsigned long phase, unsigned long period)
+{
+    if(((phase - _currentLag) & 0x80000000) != 0)
+    {
+        return (width > _deadTime) ? (width - _deadTime) : 0;
+    }
+    width += _deadTime;
+    return (width > period) ? period : width;
+}
+
+/* ***************LoadThreePhaseCycle******************
+ * Load the next phase accumulator step of the three legs into the PWM generators,
+ *  it is applied to the three of them together at the start of the next pwm cycle.
+ * Input: none
+ * Output: none
+ */
+void LoadThreePhaseCycle(void)
+{
+    unsigned long phase;
+    unsigned long period;
+    unsigned long widths[3];
+
+    UpdateBusGain();
+    phase = NextNcoPhase();
+    period = _activeNco->pwmPeriod + _ncoDeviation;
+
+    if(_modulation == PWM_MODULATION_SVPWM)
+    {
+        SpaceVectorWidths(phase, period, widths);
+    }
+    else
+    {
+        widths[0] = LegWidth(phase, period);
+        widths[1] = LegWidth(phase - PHASE_120, period);
+        widths[2] = LegWidth(phase - PHASE_240, period);
+    }
+
+    if(_deadTimeCompensation)
+    {
+        widths[0] = CompensateDeadTime(widths[0], phase, period);
+        widths[1] = CompensateDeadTime(widths[1], phase - PHASE_120, period);
+        widths[2] = CompensateDeadTime(widths[2], phase - PHASE_240, period);
+    }
+
+    PWM0_SetThreePhase(period, widths[0], widths[1], widths[2]);
+}
+
+/* This is the task executed by the PWM0 generator 0 interrupt at the start of every three-phase pwm cycle.
+ * It runs the same motor state machine of the single-phase backends, loading the three legs of the next one. */
+void ThreePhaseCycleTask(void)
+{
+#if PWM_ISR_PROFILING
+    unsigned long start = Debug_CycleCounterRead();
+    Debug_TooglePin_1();
+#endif
+
+    switch(_motorState)
+    {
+
+        case SM_MOTOR_STOPPED:
+
+            /* A stopped motor has no frequency to output */
+            SwapNcoSettings();
+            if(CheckForStartRequired() && HasFrequency())
+            {
+                _motorState = SM_MOTOR_STARTED;
+                _ncoPhase = 0;
+                LoadThreePhaseCycle();
+                PWM0_EnableThreePhase();
+            }
+
+            break;
+
+        case SM_MOTOR_STARTED:
+
+            if(CheckForStopRequired() || !HasFrequency())
+            {
+                PWM0_DisableThreePhase();
+                _motorState = SM_MOTOR_STOPPED;
+                _buttonClicked = NONE_CLICKED;   // stopped by the idle too, so only a new start restarts it
+            }
+            else
+            {
+                LoadThreePhaseCycle();
             }
 
             break;
@@ -409,7 +1653,269 @@ void SysTick_Handler(void)
             break;
     }
 
-    //InterruptPinToogle();
+#if PWM_ISR_PROFILING
     Debug_TooglePin_1();
+    _isrCycles += Debug_CycleCounterRead() - start;
+#endif
+}
+
+#if PWM_OUTPUT_BACKEND == PWM_BACKEND_UDMA
+/* ***************UpdateStreamedTables******************
+ * Recalculate the comparator values streamed by the uDMA from the ton table.
+ * The values are staged and copied by StreamedSineCycleTask into each streamed
+ *  table once the uDMA is done with it, so a sine cycle is never torn.
+ * Input: table - the ton table just calculated
+ * Output: none
+ */
+void UpdateStreamedTables(const volatile TonTable *table)
+{
+    int i = 0;
+    unsigned long period = PwmCyclePeriod(table->interruptsInPwmCycle);
+    unsigned long width;
+
+    /* Keep the interrupt away from the staging table while it is written */
+    _tablesToUpdate = 0;
+
+    for(i=0; i<36; i++)
+    {
+        /* The output goes HI when the counter reaches the comparator and stays HI until the
+         * end of the pwm cycle, for (compare + 1) clocks. The last clock is kept LOW, so the
+         * comparator never ties with the period start */
+        width = TonToPwmClocks(table->tonTable[i]);
+        if(width >= period) width = period - 1;
+        _stagingTable[i] = (width == 0) ? PWM_STREAM_OFF : (width - 1);
+    }
+    _stagingPeriod = period;
+
+    /* Both streamed tables are now older than the staging one */
+    _tablesToUpdate = 2;
+
+    if(_motorState == SM_MOTOR_STOPPED)
+    {
+        /* The uDMA is not streaming, so both tables can be updated right away */
+        for(i=0; i<36; i++)
+        {
+            _streamTables[0][36 + i] = _stagingTable[i];
+            _streamTables[1][36 + i] = _stagingTable[i];
+        }
+        _streamPeriods[0] = _stagingPeriod;
+        _streamPeriods[1] = _stagingPeriod;
+        _tablesToUpdate = 0;
+    }
+}
+
+/* ***************ArmStreams******************
+ * Arm one control structure of both uDMA channels to stream one sine cycle
+ * Input: table - the streamed table {0 or 1}
+ *        alternate - UDMA_PRIMARY or UDMA_ALTERNATE
+ * Output: none
+ */
+void ArmStreams(unsigned int table, bool alternate)
+{
+    uDMA_SetTransfer(UDMA_CHANNEL_HI, alternate, &_streamTables[table][36], &PWM0_0_CMPA_R, 72, UDMA_STREAM_CONTROL);
+    uDMA_SetTransfer(UDMA_CHANNEL_LOW, alternate, &_streamTables[table][0], &PWM0_0_CMPB_R, 72, UDMA_STREAM_CONTROL);
+}
+
+/* ***************UpdateStreamingState******************
+ * Start or stop the uDMA streaming according to the requests,
+ *  it runs from the main loop as there is no per pwm cycle interrupt.
+ * Input: none
+ * Output: none
+ */
+void UpdateStreamingState(void)
+{
+    int i = 0;
+    bool masked;
+
+    if(( _motorState == SM_MOTOR_STOPPED ) && CheckForStartRequired() && ( _interruptsInPwmCycle != 0 ))
+    {
+        /* The OFF halves never change */
+        for(i=0; i<36; i++)
+        {
+            _streamTables[0][i] = PWM_STREAM_OFF;
+            _streamTables[0][72 + i] = PWM_STREAM_OFF;
+            _streamTables[1][i] = PWM_STREAM_OFF;
+            _streamTables[1][72 + i] = PWM_STREAM_OFF;
+        }
+
+        _tonIndex = 0;
+        _pwmPin = PWM_PIN_HI;
+        ArmStreams(0, UDMA_PRIMARY);
+        ArmStreams(1, UDMA_ALTERNATE);
+        PWM0Gen0_SetPeriod(_streamPeriods[0]);
+        Timer1_SetPeriod(_streamPeriods[0]);
+        uDMA_EnableChannel(UDMA_CHANNEL_HI);
+        uDMA_EnableChannel(UDMA_CHANNEL_LOW);
+        /* Back to back, so the counter = 0 leads every timeout by the same few clocks */
+        masked = IntMasterDisable();
+        PWM0Gen0_Restart();
+        Timer1_Start();
+        if(!masked) IntMasterEnable();
+        _motorState = SM_MOTOR_STARTED;
+    }
+    else if(( _motorState == SM_MOTOR_STARTED ) && ( CheckForStopRequired() || ( _interruptsInPwmCycle == 0 ) ))
+    {
+        Timer1_Stop();
+        uDMA_DisableChannel(UDMA_CHANNEL_HI);
+        uDMA_DisableChannel(UDMA_CHANNEL_LOW);
+        PWM0_0_CMPA_R = PWM_STREAM_OFF;
+        PWM0_0_CMPB_R = PWM_STREAM_OFF;
+        _motorState = SM_MOTOR_STOPPED;
+        _buttonClicked = NONE_CLICKED;           // stopped by the idle too, so only a new start restarts it
+    }
+}
+
+/* This is the task executed when the uDMA channel of the LOW pin, the last one served at a timeout,
+ *  finishes streaming a sine cycle. Both channels are already streaming the other control structure,
+ *  so the task only has to apply its pwm cycle length and arm again the structures that have just
+ *  finished, with the newest table. */
+void StreamedSineCycleTask(void)
+{
+#if PWM_ISR_PROFILING
+    unsigned long start = Debug_CycleCounterRead();
+#endif
+    bool alternate = uDMA_IsUsingAlternate(UDMA_CHANNEL_LOW);
+    unsigned int running = alternate ? 1 : 0;
+    unsigned int finished = 1 - running;
+    int i = 0;
+
+#if PWM_ISR_PROFILING
+    Debug_TooglePin_1();
+#endif
+
+    /* The table that started streaming may have another pwm cycle length. Both registers are
+     *  taken at the end of the pwm cycle just started, the generator at its counter = 0 and the
+     *  timers at the timeout that follows it */
+    PWM0Gen0_SetPeriod(_streamPeriods[running]);
+    Timer1_SetPeriod(_streamPeriods[running]);
+
+    if(_tablesToUpdate > 0)
+    {
+        for(i=0; i<36; i++)
+        {
+            _streamTables[finished][36 + i] = _stagingTable[i];
+        }
+        _streamPeriods[finished] = _stagingPeriod;
+        _tablesToUpdate--;
+    }
+
+    ArmStreams(finished, !alternate);
+    uDMA_AcknowledgeDone(UDMA_CHANNEL_HI);
+    uDMA_AcknowledgeDone(UDMA_CHANNEL_LOW);
+
+#if PWM_ISR_PROFILING
+    Debug_TooglePin_1();
+    _isrCycles += Debug_CycleCounterRead() - start;
+#endif
+}
+#endif
+
+/* This is the ISR (Interrupt Service Routin) that handle the Systick Interrupts
+ * The ISR only outputs the pwm pin of the current slot: HI from the slot start until its ton and LOW
+ *  until its end, written through the masked data address of the pin. At the end of the slot it takes
+ *  the next one, already calculated by the PendSV, and pends the PendSV to calculate the following.
+ * When the PendSV hasn't finished the next slot yet, it is preempted in the middle of it, so the ISR
+ *  outputs a short LOW slot instead and takes the next one at the end of it. */
+void SysTick_Handler(void)
+{
+#if PWM_ISR_PROFILING
+    unsigned long start = Debug_CycleCounterRead();
+    unsigned long cycles;
+#endif
+    unsigned long counter = _systick.counter;
+
+#if PWM_ISR_PROFILING
+    Debug_TooglePin_1();
+#endif
+
+    /* The slot is over, take the next one */
+    if(counter >= _systick.cycle.interrupts)
+    {
+        *_systick.cycle.pin = 0;                 // the pin of the ending slot is left LOW
+        if(_systick.nextReady)
+        {
+            _systick.cycle = _systick.next;
+            _systick.nextReady = false;
+            NVIC_INT_CTRL_R = NVIC_INT_CTRL_PEND_SV; // calculate the slot after it
+        }
+        else
+        {
+            _systick.cycle.ton = 0;              // the PendSV is still writing it
+            _systick.cycle.interrupts = SYSTICK_LATE_INTERRUPTS;
+            _systick.cycle.sample = SAMPLE_SLOT_NONE;
+            _lateSlots++;
+        }
+        counter = 0;
+    }
+
+    /* Compare and store, the same every interrupt */
+    *_systick.cycle.pin = (counter < _systick.cycle.ton) ? 0xFF : 0;
+    if(counter == _systick.cycle.sample) ADC0_PSSI_R = 0x0008; // the current sample of the slot, ADC0 SS3
+    _systick.counter = counter + 1;
+
+#if PWM_ISR_PROFILING
+    Debug_TooglePin_1();
+    cycles = Debug_CycleCounterRead() - start;
+    if(cycles > _systickWorstCycles) _systickWorstCycles = cycles;
+    _systickCycles += cycles;
+#endif
+}
+
+/* This is the ISR (Interrupt Service Routin) that handle the PendSV, pended by the Systick Interrupt
+ *  at the start of every slot. It runs the motor state machine and calculates the next slot,
+ *  at the lowest priority so the Systick Interrupt keeps its timing. */
+void PendSV_Handler(void)
+{
+#if PWM_ISR_PROFILING
+    unsigned long start = Debug_CycleCounterRead();
+    unsigned long nested = _systickCycles;
+#endif
+
+    /* Unique motor state machine routine */
+    switch(_motorState)
+    {
+
+        case SM_MOTOR_STOPPED:
+
+            SwapTonTable();
+            SwapNcoSettings();
+            if(CheckForStartRequired() && HasFrequency())
+            {
+                _motorState = SM_MOTOR_STARTED;
+                _tonIndex = 0;
+                _ncoPhase = 0;
+                LoadSystickCycle();
+            }
+            else
+            {
+                LoadSystickIdle();
+            }
+
+            break;
+
+        case SM_MOTOR_STARTED:
+
+            if(CheckForStopRequired() || !HasFrequency())
+            {
+                _motorState = SM_MOTOR_STOPPED;
+                _buttonClicked = NONE_CLICKED;   // stopped by the idle too, so only a new start restarts it
+                LoadSystickIdle();
+            }
+            else
+            {
+                if(_pwmMode == PWM_MODE_TABLE) UpdateIndex();
+                LoadSystickCycle();
+            }
+
+            break;
+
+        default:
+            break;
+    }
+    _systick.nextReady = true;                    // the Systick Interrupt may take it now
 
+#if PWM_ISR_PROFILING
+    /* The Systick Interrupts that preempted it are already into their own sum */
+    _pendSvCycles += (Debug_CycleCounterRead() - start) - (_systickCycles - nested);
+#endif
 }
@@ -8,15 +8,7 @@
 #ifndef SOURCE_MAIN_PWMOUTPUTCONTROLLER_H_
 #define SOURCE_MAIN_PWMOUTPUTCONTROLLER_H_
 
-/* The table that represents all the 36 values from 0 to 180 degrees from 5 by 5;
- * The table is used to calculate how many cycles represent the current ton time
- *  assuming 1 as being all the 36 pwm cycles and 0 as being none. */
-static const double _SinOutTable[] ={
-    0.087155743 ,0.173648178 ,0.258819045 ,0.342020143 ,0.422618262 ,0.5 ,0.573576436 ,0.64278761 ,0.707106781 ,
-    0.766044443 ,0.819152044 ,0.866025404 ,0.906307787 ,0.939692621 ,0.965925826 ,0.984807753 ,0.996194698 ,1 ,
-    0.996194698 ,0.984807753 ,0.965925826 ,0.939692621 ,0.906307787 ,0.866025404 ,0.819152044 ,0.766044443 ,
-    0.707106781 ,0.64278761 ,0.573576436 ,0.5 ,0.422618262 ,0.342020143 ,0.258819045 ,0.173648178 ,0.087155743 ,0
-};
+#include <stdbool.h>
 
 /* All the possible states for the button entry represents the intent to start/stop the motor */
 typedef enum {NONE_CLICKED, START_CLICKED, STOP_CLICKED} ButtonState;
@@ -24,15 +16,92 @@ typedef enum {NONE_CLICKED, START_CLICKED, STOP_CLICKED} ButtonState;
 typedef enum {SM_MOTOR_INITIAL, SM_MOTOR_UPDATING, SM_MOTOR_STARTED, SM_MOTOR_STOPPED} MotorState;
 /* The enumeration values that allow to select all the available pwm pins */
 typedef enum {PWM_PIN_HI, PWM_PIN_LOW, PWM_PIN_DEBUG} PwmPin;
-/* The possible enumeration values for state of the preTonTable */
-typedef enum {UPDATED, CONSUMED} TableState;
-
-/* A struct that allows to save the current state of the ton Table that is dynamically calculated */
+/* A struct that holds one dynamically calculated ton table together with its pwm cycle length,
+ *  so the interrupt always outputs a half sine wave from a single consistent pair */
 typedef struct
 {
-    unsigned int preTonTable[36];
-    TableState tState;
+    unsigned int tonTable[36];
+    unsigned int interruptsInPwmCycle;
 } TonTable;
+/* The modulation modes that can generate the sine wave:
+ * PWM_MODE_TABLE - the ton table of the nearest integer frequency is output along 72 pwm cycles
+ * PWM_MODE_NCO   - a 32 bits phase accumulator indexes the sine table once per pwm cycle, so the
+ *                  frequency has FREQUENCY_FINE_SCALE steps per Hz and its average is exact */
+typedef enum {PWM_MODE_TABLE, PWM_MODE_NCO} PwmMode;
+/* The modulation strategies of the three-phase legs:
+ * PWM_MODULATION_SPWM  - each leg follows its own sine, the line voltage reaches 86.6% of the DC bus
+ * PWM_MODULATION_SVPWM - space vector, the dwell times of the two vectors next to the reference are
+ *                        centered into the pwm cycle and the line voltage reaches 100% of the DC bus */
+typedef enum {PWM_MODULATION_SPWM, PWM_MODULATION_SVPWM} PwmModulation;
+/* A struct that holds the phase accumulator settings of one frequency together with the
+ *  pwm cycle length they were calculated for, in Systick Interrupts and in core clocks */
+typedef struct
+{
+    unsigned long phaseIncrement;
+    unsigned int interruptsInPwmCycle;
+    unsigned long pwmPeriod;
+    unsigned long modulationIndex;
+    unsigned int carrierRatio;
+    unsigned long spread;
+    unsigned long incrementPerUnit;
+} NcoSettings;
+/* One gear of the automatic carrier ratio: the ratio and the highest frequency it is used for */
+typedef struct
+{
+    unsigned int ratio;
+    unsigned long highestFrequency;
+} CarrierGear;
+/* One slot of the Systick backend: the masked data address of its pin, its ton, its length and the
+ *  Systick Interrupt that samples the current into it, all in Systick Interrupts */
+typedef struct
+{
+    volatile unsigned long *pin;
+    unsigned long ton;
+    unsigned long interrupts;
+    unsigned long sample;
+} SystickSlot;
+/* The whole state of the Systick Interrupt, kept together so it reaches every field from one base
+ *  address: the slot being output, the next one written by the PendSV and the counter within the slot */
+typedef struct
+{
+    SystickSlot cycle;
+    SystickSlot next;
+    unsigned long counter;
+    volatile bool nextReady;
+} SystickState;
+/* The volts per hertz curves that give the modulation index below the base frequency:
+ * VF_CURVE_NONE      - full voltage at any frequency
+ * VF_CURVE_LINEAR    - voltage proportional to the frequency, constant flux
+ * VF_CURVE_QUADRATIC - voltage proportional to the square of the frequency, for fans and pumps */
+typedef enum {VF_CURVE_NONE, VF_CURVE_LINEAR, VF_CURVE_QUADRATIC} VfCurve;
+
+/* The backends that can generate the pwm output signal:
+ * PWM_BACKEND_SYSTICK  - bit-banging PB0 (HI) and PB1 (LOW) from the Systick Interrupt at INTERRUPT_FREQ
+ * PWM_BACKEND_HARDWARE - the PWM0 generator 0 drives PB6 (HI) and PB7 (LOW), the CPU only loads one
+ *                        ton value per pwm cycle
+ * PWM_BACKEND_UDMA     - the PWM0 generator 0 drives PB6 (HI) and PB7 (LOW) and the uDMA streams its
+ *                        comparators once per pwm cycle, paced by TIMER1. The CPU is only interrupted
+ *                        once per sine cycle
+ * PWM_BACKEND_THREE_PHASE - the PWM0 generators 0, 1 and 2 drive the three complementary legs of a three-phase
+ *                        inverter: U on PB6/PB7, V on PB4/PB5 and W on PE4/PE5 (high side/low side). The legs
+ *                        are 120 degrees apart on one phase accumulator, so it always uses PWM_MODE_NCO
+ * The backends don't share the pins: going from the Systick backend to any PWM0 one moves the gate signals
+ *  from PB0/PB1 to PB6/PB7 (and PB4/PB5, PE4/PE5 for the three-phase legs), so the gate driver must be
+ *  wired to the pins of the selected backend. */
+#define PWM_BACKEND_SYSTICK     0
+#define PWM_BACKEND_HARDWARE    1
+#define PWM_BACKEND_UDMA        2
+#define PWM_BACKEND_THREE_PHASE 3
+/* The backend selected to generate the pwm output signal */
+#ifndef PWM_OUTPUT_BACKEND
+#define PWM_OUTPUT_BACKEND PWM_BACKEND_SYSTICK
+#endif
+/* Enable (1) or disable (0) the profiling of the pwm output interrupts: the DWT cycle counter read
+ *  around each one, for the CPU load and the longest Systick Interrupt, and the toggles of the debug pin.
+ *  It nearly triples the cycles of the Systick Interrupt, so it stays out of the normal build */
+#ifndef PWM_ISR_PROFILING
+#define PWM_ISR_PROFILING 0
+#endif
 
 /* Default reload value based on the calculations and explained into the .c file */
 #define DEFAULT_RELOAD 342
@@ -40,6 +109,60 @@ typedef struct
 #define INTERRUPT_FREQ 233280
 /* The desired number of pwm cycles within the full sine wave, used for futher calculations */
 #define PWM_CYCLE_WITHIN_FULL_SINE 72
+/* The amount of 80MHz PWM clocks that last the same as one Systick Interrupt,
+ * used by the hardware backend to convert the ton table into PWM clocks */
+#define PWM_CLOCKS_PER_INTERRUPT (DEFAULT_RELOAD + 1)
+/* The longest pwm cycle the 16 bits PWM generator can count, in PWM clocks */
+#define PWM_MAX_PERIOD 65535
+/* The core clock, that also clocks the Systick and the PWM generator {Hz} */
+#define SYSTEM_CLOCK_FREQ 80000000
+/* The amount of fine frequency units within one Hz (0.01 Hz resolution) */
+#define FREQUENCY_FINE_SCALE 100
+/* The widest frequency range of the modulation, any bounds set at runtime are kept within it.
+ * At 0.5 Hz the table mode has INTERRUPT_FREQ / (72 * f) = 6480 Systick Interrupts per pwm cycle and the
+ *  NCO mode, at the 1152 carrier ratio, 405. At 400 Hz the table mode is down to 8, about 5 % THD at 405 Hz,
+ *  and the NCO mode, at the 9 carrier ratio, keeps 64 and the exact frequency but only 9 pwm cycles per sine
+ *  wave, about 16 % THD below the carrier (Tools/FrequencyRangeSweep.c).
+ * The hardware backends can't count a pwm cycle longer than PWM_MAX_PERIOD, so their table mode only goes
+ *  down to PWM_TABLE_RANGE_LOWER, while the NCO mode keeps the exact frequency down to 0.5 Hz with a shorter
+ *  pwm cycle. {1/FREQUENCY_FINE_SCALE Hz} */
+#define FREQUENCY_RANGE_LOWER 50
+#define FREQUENCY_RANGE_UPPER 40000
+/* The lowest frequency of the table mode on the PWM0 backends: the first one whose pwm cycle, a whole amount
+ *  of Systick Interrupts, fits into PWM_MAX_PERIOD (191 * PWM_CLOCKS_PER_INTERRUPT, 16.88 Hz). The lower bound
+ *  is raised to it, so the output is never a shortened pwm cycle of another frequency {1/FREQUENCY_FINE_SCALE Hz} */
+#define PWM_TABLE_RANGE_LOWER ((((unsigned long)INTERRUPT_FREQ * FREQUENCY_FINE_SCALE) / \
+                                (PWM_CYCLE_WITHIN_FULL_SINE * ((PWM_MAX_PERIOD / PWM_CLOCKS_PER_INTERRUPT) + 1))) + 1)
+/* The modulation index that outputs the full sine wave {1/65536} */
+#define MODULATION_FULL 65536
+/* The modulation index of the six-step square wave, whose fundamental is 4/pi of the full sine wave.
+ * Between MODULATION_FULL and it the overmodulation clips the sine wave at the whole pwm cycle {1/65536} */
+#define MODULATION_SIX_STEP 83443
+/* The same for the space vector modulation, whose full index already is 2/sqrt(3) of the full sine wave {1/65536} */
+#define MODULATION_SIX_STEP_SVPWM 72264
+/* The amount of points of the overmodulation tables, evenly spread from MODULATION_FULL to the six-step */
+#define OVERMODULATION_POINTS 17
+/* The amount of points of the V/f curve table, evenly spread from 0 Hz to the base frequency */
+#define VF_CURVE_POINTS 17
+
+/* The carrier ratio that selects the automatic gear shifting */
+#define CARRIER_RATIO_AUTO 0
+/* The carrier frequency that selects the synchronous carrier, locked to the sine wave */
+#define CARRIER_SYNCHRONOUS 0
+/* The widest spread of the randomized carrier, around the nominal pwm cycle {%} */
+#define CARRIER_SPREAD_MAX 50
+
+/* The highest gain of the DC bus feed-forward, reached at half of the nominal DC bus {1/65536} */
+#define BUS_GAIN_MAX (2 * MODULATION_FULL)
+
+/* The phase of the current sample within the pwm cycle, from the middle of the on-period {1/65536 pwm cycle} */
+#define SAMPLE_PHASE_ON_CENTER  0x0000
+#define SAMPLE_PHASE_OFF_CENTER 0x8000
+
+/* The default dead time between the high side and the low side of each three-phase leg {ns} */
+#define PWM_DEAD_TIME_NS 1000
+/* Convert nanoseconds into core clocks, rounding up so the dead time is never shorter */
+#define NS_TO_CLOCKS(ns) ((((unsigned long)(ns) * (SYSTEM_CLOCK_FREQ / 1000000)) + 999) / 1000)
 
 
 /* ***************PwmOuputController_Init******************
@@ -71,8 +194,199 @@ void PwmOuputController_Stop(void);
  */
 void PwmOuputController_UpdateFrequency(unsigned short freq);
 
+/* **********PwmOuputController_UpdateFrequencyFine************
+ * Update the frequency set to the motor operate, with sub-hertz resolution.
+ * The PWM_MODE_NCO outputs it exactly, the PWM_MODE_TABLE outputs the nearest whole pwm cycle length.
+ * A frequency of 0 is the idle: the pins stay LOW and a started motor stops. Any other frequency
+ *  is kept within the frequency bounds.
+ * Input: freq - The new frequency {unsigned long} {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: none
+ */
+void PwmOuputController_UpdateFrequencyFine(unsigned long freq);
+
+/* **********PwmOuputController_SetFrequencyBounds************
+ * Update the frequency bounds, kept within FREQUENCY_RANGE_LOWER and FREQUENCY_RANGE_UPPER.
+ *  The current frequency is brought within them right away.
+ * Input: lower - The lowest frequency, other than the idle {1/FREQUENCY_FINE_SCALE Hz}
+ *        upper - The highest frequency {1/FREQUENCY_FINE_SCALE Hz}
+ * Output: none
+ */
+void PwmOuputController_SetFrequencyBounds(unsigned long lower, unsigned long upper);
+
+/* **********PwmOuputController_GetLowerBound************
+ * Returns the lowest frequency, other than the idle, raised to PWM_TABLE_RANGE_LOWER
+ *  while the table mode of a PWM0 backend is selected
+ * Input: none
+ * Output: unsigned long - the frequency {1/FREQUENCY_FINE_SCALE Hz}
+ */
+unsigned long PwmOuputController_GetLowerBound(void);
+
+/* **********PwmOuputController_GetUpperBound************
+ * Returns the highest frequency
+ * Input: none
+ * Output: unsigned long - the frequency {1/FREQUENCY_FINE_SCALE Hz}
+ */
+unsigned long PwmOuputController_GetUpperBound(void);
+
+/* **********PwmOuputController_SetMode************
+ * Select the modulation mode, only allowed while the motor is stopped.
+ * The uDMA backend streams whole ton tables, so it always uses PWM_MODE_TABLE,
+ *  and the three-phase backend always uses PWM_MODE_NCO.
+ * Input: mode - The modulation mode {PwmMode}
+ * Output: none
+ */
+void PwmOuputController_SetMode(PwmMode mode);
+
+/* **********PwmOuputController_SetModulation************
+ * Select the modulation strategy of the three-phase backend,
+ *  only allowed while the motor is stopped.
+ * Input: modulation - The modulation strategy {PwmModulation}
+ * Output: none
+ */
+void PwmOuputController_SetModulation(PwmModulation modulation);
+
+/* **********PwmOuputController_SetVfCurve************
+ * Configure the volts per hertz curve that scales the sine wave. At and above the base
+ *  frequency the modulation index is full, below it follows the curve, raised by the boost
+ *  at 0 Hz. The new modulation index is applied right away.
+ * Input: curve - The V/f curve {VfCurve}
+ *        baseFrequency - The frequency of the rated voltage {Hz}
+ *        boost - The voltage at 0 Hz {0.1 % of the rated voltage}
+ * Output: none
+ */
+void PwmOuputController_SetVfCurve(VfCurve curve, unsigned short baseFrequency, unsigned short boost);
+
+/* **********PwmOuputController_SetOvermodulation************
+ * Enable or disable the overmodulation. Past the base frequency of the V/f curve the modulation
+ *  index keeps the V/f slope beyond MODULATION_FULL, and the DC bus feed-forward may raise it too,
+ *  up to the six-step of the modulation strategy. The sine wave is clipped at the whole pwm cycle
+ *  by the level that gives the commanded fundamental, so the amplitude rises continuously and
+ *  in phase until it becomes the square wave. The new modulation index is applied right away.
+ * Input: enable - true to allow the overmodulation, false to saturate at MODULATION_FULL
+ * Output: none
+ */
+void PwmOuputController_SetOvermodulation(bool enable);
+
+/* **********PwmOuputController_GetModulationIndex************
+ * Returns the modulation index applied to the current frequency
+ * Input: none
+ * Output: unsigned long - the modulation index {1/65536}, above MODULATION_FULL while overmodulated
+ */
+unsigned long PwmOuputController_GetModulationIndex(void);
+
+/* **********PwmOuputController_SetCarrierRatio************
+ * Select the amount of pwm cycles within the sine wave of the NCO mode.
+ * With CARRIER_RATIO_AUTO the ratio shifts among the gears that keep the carrier
+ *  between 3.39 and 7 kHz. A new ratio is only taken at a zero crossing of the sine wave.
+ * The table mode always outputs PWM_CYCLE_WITHIN_FULL_SINE pwm cycles.
+ * Input: ratio - The pwm cycles within the sine wave, or CARRIER_RATIO_AUTO
+ * Output: none
+ */
+void PwmOuputController_SetCarrierRatio(unsigned int ratio);
+
+/* **********PwmOuputController_GetCarrierRatio************
+ * Returns the carrier ratio of the current frequency
+ * Input: none
+ * Output: unsigned int - the pwm cycles within the sine wave, 0 with an asynchronous carrier
+ */
+unsigned int PwmOuputController_GetCarrierRatio(void);
+
+/* **********PwmOuputController_SetCarrierFrequency************
+ * Select an asynchronous carrier for the NCO mode: the pwm cycle is fixed whatever
+ *  the fundamental frequency, and the phase accumulator is sampled once per pwm cycle.
+ * With CARRIER_SYNCHRONOUS the carrier follows the carrier ratio again.
+ * The hardware backends keep the carrier at 1221 Hz or above.
+ * Input: freq - The carrier frequency {Hz}, or CARRIER_SYNCHRONOUS
+ * Output: none
+ */
+void PwmOuputController_SetCarrierFrequency(unsigned int freq);
+
+/* **********PwmOuputController_SetCarrierSpread************
+ * Randomize the pwm cycle of the NCO mode within a band around its nominal length, to spread the
+ *  switching energy over the spectrum. The phase accumulator advances by the length of each pwm cycle
+ *  and the ton follows it, so the frequency and the volt-seconds are the same as the fixed carrier.
+ * The table mode always outputs the fixed carrier.
+ * Input: band - The highest deviation of each pwm cycle {% of the nominal pwm cycle}, 0 for the fixed carrier
+ * Output: none
+ */
+void PwmOuputController_SetCarrierSpread(unsigned int band);
+
+/* **********PwmOuputController_SetDeadTime************
+ * Update the dead time between the high side and the low side of each three-phase leg,
+ *  inserted by the PWM dead-band generator (12.5 ns steps, up to 51 us).
+ * The single-phase backends never have both pins on, so they have no dead time.
+ * Input: ns - The dead time {ns}
+ * Output: none
+ */
+void PwmOuputController_SetDeadTime(unsigned int ns);
+
+/* **********PwmOuputController_SetDeadTimeCompensation************
+ * Enable or disable the dead time compensation of the three-phase legs. The HI time of
+ *  each leg is raised by the dead time while its current flows out of it and lowered while
+ *  it flows in, the current being the leg sine delayed by the given lag.
+ * Input: enable - true to compensate the dead time
+ *        currentLag - The lag of the current to the voltage of each leg {degrees}
+ * Output: none
+ */
+void PwmOuputController_SetDeadTimeCompensation(bool enable, unsigned short currentLag);
+
+/* **********PwmOuputController_SetBusCompensation************
+ * Enable or disable the DC bus feed-forward. The gain is updated from the ACQUISITION_BUS value
+ *  of each new frame of the drive acquisition, Ain0 (PE3) of the default channels, and the sine
+ *  wave is scaled by nominal / sample, so the fundamental voltage doesn't follow the ripple nor
+ *  the sag of the DC bus. The drive acquisition must be running, until its next frame the gain
+ *  stays at unity. The NCO mode raises the modulation index up to the full sine wave, or the
+ *  six-step with the overmodulation, the table mode raises each ton up to the whole pwm cycle.
+ *  The uDMA backend streams whole tables and isn't compensated.
+ * Input: enable - true to compensate the DC bus
+ *        nominal - The sample of the rated DC bus {0 to 4095}
+ * Output: none
+ */
+void PwmOuputController_SetBusCompensation(bool enable, unsigned int nominal);
+
+/* **********PwmOuputController_SetCurrentSampling************
+ * Select how the motor current ADC (ADC0 SS3) is triggered: by TIMER0A at its fixed
+ *  rate, or by the modulator once per pwm cycle at a phase from the middle of the
+ *  on-period, so the samples per sine wave follow the carrier ratio. In the middle
+ *  of the on- or the off-period the ripple crosses its average, and the sample is
+ *  the furthest from the switching edges. The hardware backend triggers from the
+ *  PWM0 generator 1, the three-phase one from the generator 0 and the Systick one
+ *  from the interrupt of the slot. The uDMA backend keeps TIMER0A.
+ * The ADC must have been initialized by the current capture.
+ * Input: synchronized - true to trigger the ADC from the modulator
+ *        phase - The sample from the middle of the on-period {1/65536 pwm cycle},
+ *                SAMPLE_PHASE_ON_CENTER or SAMPLE_PHASE_OFF_CENTER
+ * Output: none
+ */
+void PwmOuputController_SetCurrentSampling(bool synchronized, unsigned short phase);
+
+/* **********PwmOuputController_GetBusVoltage************
+ * Returns the last sample of the DC bus, taken while the feed-forward is enabled
+ * Input: none
+ * Output: unsigned int - the DC bus {0 to 4095}
+ */
+unsigned int PwmOuputController_GetBusVoltage(void);
+
 unsigned int PwmOuputController_GetCurrentTon(void);
 
+/* ************PwmOuputController_GetCpuLoad*******************
+ * Returns the share of the CPU spent into the pwm output interrupt
+ * of the selected backend since the last call to this function.
+ * Only measured with PWM_ISR_PROFILING, 0 without it
+ * Input: none
+ * Output: unsigned int - the CPU load {0.1 %}
+ */
+unsigned int PwmOuputController_GetCpuLoad(void);
+
+/* ************PwmOuputController_GetSystickWorstCycles*******************
+ * Returns the longest Systick Interrupt since the last call to this function, measured
+ * with the DWT cycle counter, and the slots the PendSV didn't calculate in time meanwhile.
+ * The late slots are always counted, the longest interrupt only with PWM_ISR_PROFILING
+ * Input: lateSlots - where to store the late slots, or 0
+ * Output: unsigned long - the longest Systick Interrupt {core clocks}
+ */
+unsigned long PwmOuputController_GetSystickWorstCycles(unsigned long *lateSlots);
+
 /* ************PwmOuputController_GetMotorState*******************
  * Returns the current motor state
  * Input: none
@@ -0,0 +1,64 @@
+/*
+ * SineTable.c
+ *
+ * The quarter sine wave holds sin(k * 180 / SINE_TABLE_POINTS) for k from 0 up to
+ *  SINE_TABLE_POINTS / 2 (90 degrees), in unsigned fixed point with 16 fractional bits.
+ * The peak 1.0 is stored as 65535 so it fits 16 bits; for any value multiplied by it
+ *  under 32768 the rounded result is the same as 1.0 would give.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "SineTable.h"
+
+/* The quarter sine wave, from 0 to 90 degrees */
+static const unsigned short _quarterSine[(SINE_TABLE_POINTS / 2) + 1] = {
+#if SINE_TABLE_POINTS == 36
+        0,  5712, 11380, 16962, 22415, 27697, 32768, 37590, 42126, 46341, 50203, 53684,
+    56756, 59396, 61584, 63303, 64540, 65287, 65535
+#elif SINE_TABLE_POINTS == 72
+        0,  2859,  5712,  8554, 11380, 14185, 16962, 19707, 22415, 25080, 27697, 30261,
+    32768, 35212, 37590, 39896, 42126, 44275, 46341, 48318, 50203, 51993, 53684, 55273,
+    56756, 58131, 59396, 60547, 61584, 62503, 63303, 63983, 64540, 64975, 65287, 65474,
+    65535
+#elif SINE_TABLE_POINTS == 144
+        0,  1430,  2859,  4286,  5712,  7135,  8554,  9970, 11380, 12785, 14185, 15577,
+    16962, 18339, 19707, 21066, 22415, 23753, 25080, 26394, 27697, 28986, 30261, 31522,
+    32768, 33998, 35212, 36410, 37590, 38752, 39896, 41021, 42126, 43211, 44275, 45319,
+    46341, 47341, 48318, 49273, 50203, 51111, 51993, 52851, 53684, 54491, 55273, 56028,
+    56756, 57457, 58131, 58777, 59396, 59986, 60547, 61080, 61584, 62058, 62503, 62918,
+    63303, 63658, 63983, 64277, 64540, 64773, 64975, 65146, 65287, 65396, 65474, 65520,
+    65535
+#elif SINE_TABLE_POINTS == 256
+        0,   804,  1608,  2412,  3216,  4019,  4821,  5623,  6424,  7224,  8022,  8820,
+     9616, 10411, 11204, 11996, 12785, 13573, 14359, 15143, 15924, 16703, 17479, 18253,
+    19024, 19792, 20557, 21320, 22078, 22834, 23586, 24335, 25080, 25821, 26558, 27291,
+    28020, 28745, 29466, 30182, 30893, 31600, 32303, 33000, 33692, 34380, 35062, 35738,
+    36410, 37076, 37736, 38391, 39040, 39683, 40320, 40951, 41576, 42194, 42806, 43412,
+    44011, 44604, 45190, 45769, 46341, 46906, 47464, 48015, 48559, 49095, 49624, 50146,
+    50660, 51166, 51665, 52156, 52639, 53114, 53581, 54040, 54491, 54934, 55368, 55794,
+    56212, 56621, 57022, 57414, 57798, 58172, 58538, 58896, 59244, 59583, 59914, 60235,
+    60547, 60851, 61145, 61429, 61705, 61971, 62228, 62476, 62714, 62943, 63162, 63372,
+    63572, 63763, 63944, 64115, 64277, 64429, 64571, 64704, 64827, 64940, 65043, 65137,
+    65220, 65294, 65358, 65413, 65457, 65492, 65516, 65531, 65535
+#else
+#error "SINE_TABLE_POINTS must be 36, 72, 144 or 256"
+#endif
+};
+
+/* ***************SineTable_HalfWave******************
+ * Returns one point of the half sine wave, the point i represents
+ *  sin((i + 1) * 180 / SINE_TABLE_POINTS), so the last point is sin(180) = 0
+ * Input: index - the point within the half sine wave {0 to SINE_TABLE_POINTS - 1}
+ * Output: unsigned short - the sine {1/65536}
+ */
+unsigned short SineTable_HalfWave(unsigned int index)
+{
+    unsigned int k = index + 1;
+
+    /* Beyond 90 degrees the half sine wave mirrors the quarter */
+    if(k > (SINE_TABLE_POINTS / 2)) k = SINE_TABLE_POINTS - k;
+
+    return _quarterSine[k];
+}
@@ -0,0 +1,33 @@
+/*
+ * SineTable.h
+ *
+ * A single sine table shared by the whole project, stored once in flash.
+ * Only a quarter of the sine wave is stored, the half sine wave is rebuilt
+ *  by symmetry: sin(180 - x) = sin(x).
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#ifndef SOURCE_MAIN_SINETABLE_H_
+#define SOURCE_MAIN_SINETABLE_H_
+
+/* The amount of points that represent the half sine wave (0 < x <= 180 degrees),
+ *  selected at build time {36, 72, 144 or 256}. The flash used by the table is
+ *  (SINE_TABLE_POINTS / 2 + 1) * 2 bytes */
+#ifndef SINE_TABLE_POINTS
+#define SINE_TABLE_POINTS 36
+#endif
+
+/* The amount of fractional bits of the table values (sin(x) * 65536, 1.0 stored as 65535) */
+#define SINE_TABLE_FRACTION_BITS 16
+
+/* ***************SineTable_HalfWave******************
+ * Returns one point of the half sine wave, the point i represents
+ *  sin((i + 1) * 180 / SINE_TABLE_POINTS), so the last point is sin(180) = 0
+ * Input: index - the point within the half sine wave {0 to SINE_TABLE_POINTS - 1}
+ * Output: unsigned short - the sine {1/65536}
+ */
+unsigned short SineTable_HalfWave(unsigned int index);
+
+#endif /* SOURCE_MAIN_SINETABLE_H_ */
@@ -0,0 +1,328 @@
+/*
+ * TonTableBank.c
+ *
+ * The ton tables of every pwm cycle length within the drive bounds, precalculated into flash.
+ * Each table was generated with the very same integer math of UpdateTonTable, over the
+ *  36 points half sine wave of SineTable.c:
+ *      ton[i] = (interruptsInPwmCycle * SineTable_HalfWave(i) + 0x8000) >> 16
+ * so selecting a table gives exactly the tons that would be calculated at runtime.
+ * The lengths go from 233280 / (72 * 90) to 233280 / (72 * 30), so every fine frequency
+ *  from 30 to 90 Hz has its table here, not only the whole hertz.
+ * Flash used: 73 tables * 37 words = 10804 bytes.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "TonTableBank.h"
+
+#if TON_TABLE_BANK
+
+static const TonTable _tonTableBank[TON_TABLE_BANK_LONGEST - TON_TABLE_BANK_SHORTEST + 1] = {
+    /* 36 interrupts */
+    {{   3,   6,   9,  12,  15,  18,  21,  23,  25,  28,  29,  31,
+        33,  34,  35,  35,  36,  36,  36,  35,  35,  34,  33,  31,
+        29,  28,  25,  23,  21,  18,  15,  12,   9,   6,   3,   0 }, 36},
+    /* 37 interrupts */
+    {{   3,   6,  10,  13,  16,  19,  21,  24,  26,  28,  30,  32,
+        34,  35,  36,  36,  37,  37,  37,  36,  36,  35,  34,  32,
+        30,  28,  26,  24,  21,  19,  16,  13,  10,   6,   3,   0 }, 37},
+    /* 38 interrupts */
+    {{   3,   7,  10,  13,  16,  19,  22,  24,  27,  29,  31,  33,
+        34,  36,  37,  37,  38,  38,  38,  37,  37,  36,  34,  33,
+        31,  29,  27,  24,  22,  19,  16,  13,  10,   7,   3,   0 }, 38},
+    /* 39 interrupts */
+    {{   3,   7,  10,  13,  16,  20,  22,  25,  28,  30,  32,  34,
+        35,  37,  38,  38,  39,  39,  39,  38,  38,  37,  35,  34,
+        32,  30,  28,  25,  22,  20,  16,  13,  10,   7,   3,   0 }, 39},
+    /* 40 interrupts */
+    {{   3,   7,  10,  14,  17,  20,  23,  26,  28,  31,  33,  35,
+        36,  38,  39,  39,  40,  40,  40,  39,  39,  38,  36,  35,
+        33,  31,  28,  26,  23,  20,  17,  14,  10,   7,   3,   0 }, 40},
+    /* 41 interrupts */
+    {{   4,   7,  11,  14,  17,  21,  24,  26,  29,  31,  34,  36,
+        37,  39,  40,  40,  41,  41,  41,  40,  40,  39,  37,  36,
+        34,  31,  29,  26,  24,  21,  17,  14,  11,   7,   4,   0 }, 41},
+    /* 42 interrupts */
+    {{   4,   7,  11,  14,  18,  21,  24,  27,  30,  32,  34,  36,
+        38,  39,  41,  41,  42,  42,  42,  41,  41,  39,  38,  36,
+        34,  32,  30,  27,  24,  21,  18,  14,  11,   7,   4,   0 }, 42},
+    /* 43 interrupts */
+    {{   4,   7,  11,  15,  18,  22,  25,  28,  30,  33,  35,  37,
+        39,  40,  42,  42,  43,  43,  43,  42,  42,  40,  39,  37,
+        35,  33,  30,  28,  25,  22,  18,  15,  11,   7,   4,   0 }, 43},
+    /* 44 interrupts */
+    {{   4,   8,  11,  15,  19,  22,  25,  28,  31,  34,  36,  38,
+        40,  41,  43,  43,  44,  44,  44,  43,  43,  41,  40,  38,
+        36,  34,  31,  28,  25,  22,  19,  15,  11,   8,   4,   0 }, 44},
+    /* 45 interrupts */
+    {{   4,   8,  12,  15,  19,  23,  26,  29,  32,  34,  37,  39,
+        41,  42,  43,  44,  45,  45,  45,  44,  43,  42,  41,  39,
+        37,  34,  32,  29,  26,  23,  19,  15,  12,   8,   4,   0 }, 45},
+    /* 46 interrupts */
+    {{   4,   8,  12,  16,  19,  23,  26,  30,  33,  35,  38,  40,
+        42,  43,  44,  45,  46,  46,  46,  45,  44,  43,  42,  40,
+        38,  35,  33,  30,  26,  23,  19,  16,  12,   8,   4,   0 }, 46},
+    /* 47 interrupts */
+    {{   4,   8,  12,  16,  20,  24,  27,  30,  33,  36,  39,  41,
+        43,  44,  45,  46,  47,  47,  47,  46,  45,  44,  43,  41,
+        39,  36,  33,  30,  27,  24,  20,  16,  12,   8,   4,   0 }, 47},
+    /* 48 interrupts */
+    {{   4,   8,  12,  16,  20,  24,  28,  31,  34,  37,  39,  42,
+        44,  45,  46,  47,  48,  48,  48,  47,  46,  45,  44,  42,
+        39,  37,  34,  31,  28,  24,  20,  16,  12,   8,   4,   0 }, 48},
+    /* 49 interrupts */
+    {{   4,   9,  13,  17,  21,  25,  28,  31,  35,  38,  40,  42,
+        44,  46,  47,  48,  49,  49,  49,  48,  47,  46,  44,  42,
+        40,  38,  35,  31,  28,  25,  21,  17,  13,   9,   4,   0 }, 49},
+    /* 50 interrupts */
+    {{   4,   9,  13,  17,  21,  25,  29,  32,  35,  38,  41,  43,
+        45,  47,  48,  49,  50,  50,  50,  49,  48,  47,  45,  43,
+        41,  38,  35,  32,  29,  25,  21,  17,  13,   9,   4,   0 }, 50},
+    /* 51 interrupts */
+    {{   4,   9,  13,  17,  22,  26,  29,  33,  36,  39,  42,  44,
+        46,  48,  49,  50,  51,  51,  51,  50,  49,  48,  46,  44,
+        42,  39,  36,  33,  29,  26,  22,  17,  13,   9,   4,   0 }, 51},
+    /* 52 interrupts */
+    {{   5,   9,  13,  18,  22,  26,  30,  33,  37,  40,  43,  45,
+        47,  49,  50,  51,  52,  52,  52,  51,  50,  49,  47,  45,
+        43,  40,  37,  33,  30,  26,  22,  18,  13,   9,   5,   0 }, 52},
+    /* 53 interrupts */
+    {{   5,   9,  14,  18,  22,  27,  30,  34,  37,  41,  43,  46,
+        48,  50,  51,  52,  53,  53,  53,  52,  51,  50,  48,  46,
+        43,  41,  37,  34,  30,  27,  22,  18,  14,   9,   5,   0 }, 53},
+    /* 54 interrupts */
+    {{   5,   9,  14,  18,  23,  27,  31,  35,  38,  41,  44,  47,
+        49,  51,  52,  53,  54,  54,  54,  53,  52,  51,  49,  47,
+        44,  41,  38,  35,  31,  27,  23,  18,  14,   9,   5,   0 }, 54},
+    /* 55 interrupts */
+    {{   5,  10,  14,  19,  23,  28,  32,  35,  39,  42,  45,  48,
+        50,  52,  53,  54,  55,  55,  55,  54,  53,  52,  50,  48,
+        45,  42,  39,  35,  32,  28,  23,  19,  14,  10,   5,   0 }, 55},
+    /* 56 interrupts */
+    {{   5,  10,  14,  19,  24,  28,  32,  36,  40,  43,  46,  48,
+        51,  53,  54,  55,  56,  56,  56,  55,  54,  53,  51,  48,
+        46,  43,  40,  36,  32,  28,  24,  19,  14,  10,   5,   0 }, 56},
+    /* 57 interrupts */
+    {{   5,  10,  15,  19,  24,  29,  33,  37,  40,  44,  47,  49,
+        52,  54,  55,  56,  57,  57,  57,  56,  55,  54,  52,  49,
+        47,  44,  40,  37,  33,  29,  24,  19,  15,  10,   5,   0 }, 57},
+    /* 58 interrupts */
+    {{   5,  10,  15,  20,  25,  29,  33,  37,  41,  44,  48,  50,
+        53,  55,  56,  57,  58,  58,  58,  57,  56,  55,  53,  50,
+        48,  44,  41,  37,  33,  29,  25,  20,  15,  10,   5,   0 }, 58},
+    /* 59 interrupts */
+    {{   5,  10,  15,  20,  25,  30,  34,  38,  42,  45,  48,  51,
+        53,  55,  57,  58,  59,  59,  59,  58,  57,  55,  53,  51,
+        48,  45,  42,  38,  34,  30,  25,  20,  15,  10,   5,   0 }, 59},
+    /* 60 interrupts */
+    {{   5,  10,  16,  21,  25,  30,  34,  39,  42,  46,  49,  52,
+        54,  56,  58,  59,  60,  60,  60,  59,  58,  56,  54,  52,
+        49,  46,  42,  39,  34,  30,  25,  21,  16,  10,   5,   0 }, 60},
+    /* 61 interrupts */
+    {{   5,  11,  16,  21,  26,  31,  35,  39,  43,  47,  50,  53,
+        55,  57,  59,  60,  61,  61,  61,  60,  59,  57,  55,  53,
+        50,  47,  43,  39,  35,  31,  26,  21,  16,  11,   5,   0 }, 61},
+    /* 62 interrupts */
+    {{   5,  11,  16,  21,  26,  31,  36,  40,  44,  47,  51,  54,
+        56,  58,  60,  61,  62,  62,  62,  61,  60,  58,  56,  54,
+        51,  47,  44,  40,  36,  31,  26,  21,  16,  11,   5,   0 }, 62},
+    /* 63 interrupts */
+    {{   5,  11,  16,  22,  27,  32,  36,  40,  45,  48,  52,  55,
+        57,  59,  61,  62,  63,  63,  63,  62,  61,  59,  57,  55,
+        52,  48,  45,  40,  36,  32,  27,  22,  16,  11,   5,   0 }, 63},
+    /* 64 interrupts */
+    {{   6,  11,  17,  22,  27,  32,  37,  41,  45,  49,  52,  55,
+        58,  60,  62,  63,  64,  64,  64,  63,  62,  60,  58,  55,
+        52,  49,  45,  41,  37,  32,  27,  22,  17,  11,   6,   0 }, 64},
+    /* 65 interrupts */
+    {{   6,  11,  17,  22,  27,  33,  37,  42,  46,  50,  53,  56,
+        59,  61,  63,  64,  65,  65,  65,  64,  63,  61,  59,  56,
+        53,  50,  46,  42,  37,  33,  27,  22,  17,  11,   6,   0 }, 65},
+    /* 66 interrupts */
+    {{   6,  11,  17,  23,  28,  33,  38,  42,  47,  51,  54,  57,
+        60,  62,  64,  65,  66,  66,  66,  65,  64,  62,  60,  57,
+        54,  51,  47,  42,  38,  33,  28,  23,  17,  11,   6,   0 }, 66},
+    /* 67 interrupts */
+    {{   6,  12,  17,  23,  28,  34,  38,  43,  47,  51,  55,  58,
+        61,  63,  65,  66,  67,  67,  67,  66,  65,  63,  61,  58,
+        55,  51,  47,  43,  38,  34,  28,  23,  17,  12,   6,   0 }, 67},
+    /* 68 interrupts */
+    {{   6,  12,  18,  23,  29,  34,  39,  44,  48,  52,  56,  59,
+        62,  64,  66,  67,  68,  68,  68,  67,  66,  64,  62,  59,
+        56,  52,  48,  44,  39,  34,  29,  23,  18,  12,   6,   0 }, 68},
+    /* 69 interrupts */
+    {{   6,  12,  18,  24,  29,  35,  40,  44,  49,  53,  57,  60,
+        63,  65,  67,  68,  69,  69,  69,  68,  67,  65,  63,  60,
+        57,  53,  49,  44,  40,  35,  29,  24,  18,  12,   6,   0 }, 69},
+    /* 70 interrupts */
+    {{   6,  12,  18,  24,  30,  35,  40,  45,  49,  54,  57,  61,
+        63,  66,  68,  69,  70,  70,  70,  69,  68,  66,  63,  61,
+        57,  54,  49,  45,  40,  35,  30,  24,  18,  12,   6,   0 }, 70},
+    /* 71 interrupts */
+    {{   6,  12,  18,  24,  30,  36,  41,  46,  50,  54,  58,  61,
+        64,  67,  69,  70,  71,  71,  71,  70,  69,  67,  64,  61,
+        58,  54,  50,  46,  41,  36,  30,  24,  18,  12,   6,   0 }, 71},
+    /* 72 interrupts */
+    {{   6,  13,  19,  25,  30,  36,  41,  46,  51,  55,  59,  62,
+        65,  68,  70,  71,  72,  72,  72,  71,  70,  68,  65,  62,
+        59,  55,  51,  46,  41,  36,  30,  25,  19,  13,   6,   0 }, 72},
+    /* 73 interrupts */
+    {{   6,  13,  19,  25,  31,  37,  42,  47,  52,  56,  60,  63,
+        66,  69,  71,  72,  73,  73,  73,  72,  71,  69,  66,  63,
+        60,  56,  52,  47,  42,  37,  31,  25,  19,  13,   6,   0 }, 73},
+    /* 74 interrupts */
+    {{   6,  13,  19,  25,  31,  37,  42,  48,  52,  57,  61,  64,
+        67,  70,  71,  73,  74,  74,  74,  73,  71,  70,  67,  64,
+        61,  57,  52,  48,  42,  37,  31,  25,  19,  13,   6,   0 }, 74},
+    /* 75 interrupts */
+    {{   7,  13,  19,  26,  32,  38,  43,  48,  53,  57,  61,  65,
+        68,  70,  72,  74,  75,  75,  75,  74,  72,  70,  68,  65,
+        61,  57,  53,  48,  43,  38,  32,  26,  19,  13,   7,   0 }, 75},
+    /* 76 interrupts */
+    {{   7,  13,  20,  26,  32,  38,  44,  49,  54,  58,  62,  66,
+        69,  71,  73,  75,  76,  76,  76,  75,  73,  71,  69,  66,
+        62,  58,  54,  49,  44,  38,  32,  26,  20,  13,   7,   0 }, 76},
+    /* 77 interrupts */
+    {{   7,  13,  20,  26,  33,  39,  44,  49,  54,  59,  63,  67,
+        70,  72,  74,  76,  77,  77,  77,  76,  74,  72,  70,  67,
+        63,  59,  54,  49,  44,  39,  33,  26,  20,  13,   7,   0 }, 77},
+    /* 78 interrupts */
+    {{   7,  14,  20,  27,  33,  39,  45,  50,  55,  60,  64,  68,
+        71,  73,  75,  77,  78,  78,  78,  77,  75,  73,  71,  68,
+        64,  60,  55,  50,  45,  39,  33,  27,  20,  14,   7,   0 }, 78},
+    /* 79 interrupts */
+    {{   7,  14,  20,  27,  33,  40,  45,  51,  56,  61,  65,  68,
+        72,  74,  76,  78,  79,  79,  79,  78,  76,  74,  72,  68,
+        65,  61,  56,  51,  45,  40,  33,  27,  20,  14,   7,   0 }, 79},
+    /* 80 interrupts */
+    {{   7,  14,  21,  27,  34,  40,  46,  51,  57,  61,  66,  69,
+        73,  75,  77,  79,  80,  80,  80,  79,  77,  75,  73,  69,
+        66,  61,  57,  51,  46,  40,  34,  27,  21,  14,   7,   0 }, 80},
+    /* 81 interrupts */
+    {{   7,  14,  21,  28,  34,  41,  46,  52,  57,  62,  66,  70,
+        73,  76,  78,  80,  81,  81,  81,  80,  78,  76,  73,  70,
+        66,  62,  57,  52,  46,  41,  34,  28,  21,  14,   7,   0 }, 81},
+    /* 82 interrupts */
+    {{   7,  14,  21,  28,  35,  41,  47,  53,  58,  63,  67,  71,
+        74,  77,  79,  81,  82,  82,  82,  81,  79,  77,  74,  71,
+        67,  63,  58,  53,  47,  41,  35,  28,  21,  14,   7,   0 }, 82},
+    /* 83 interrupts */
+    {{   7,  14,  21,  28,  35,  42,  48,  53,  59,  64,  68,  72,
+        75,  78,  80,  82,  83,  83,  83,  82,  80,  78,  75,  72,
+        68,  64,  59,  53,  48,  42,  35,  28,  21,  14,   7,   0 }, 83},
+    /* 84 interrupts */
+    {{   7,  15,  22,  29,  36,  42,  48,  54,  59,  64,  69,  73,
+        76,  79,  81,  83,  84,  84,  84,  83,  81,  79,  76,  73,
+        69,  64,  59,  54,  48,  42,  36,  29,  22,  15,   7,   0 }, 84},
+    /* 85 interrupts */
+    {{   7,  15,  22,  29,  36,  43,  49,  55,  60,  65,  70,  74,
+        77,  80,  82,  84,  85,  85,  85,  84,  82,  80,  77,  74,
+        70,  65,  60,  55,  49,  43,  36,  29,  22,  15,   7,   0 }, 85},
+    /* 86 interrupts */
+    {{   7,  15,  22,  29,  36,  43,  49,  55,  61,  66,  70,  74,
+        78,  81,  83,  85,  86,  86,  86,  85,  83,  81,  78,  74,
+        70,  66,  61,  55,  49,  43,  36,  29,  22,  15,   7,   0 }, 86},
+    /* 87 interrupts */
+    {{   8,  15,  23,  30,  37,  44,  50,  56,  62,  67,  71,  75,
+        79,  82,  84,  86,  87,  87,  87,  86,  84,  82,  79,  75,
+        71,  67,  62,  56,  50,  44,  37,  30,  23,  15,   8,   0 }, 87},
+    /* 88 interrupts */
+    {{   8,  15,  23,  30,  37,  44,  50,  57,  62,  67,  72,  76,
+        80,  83,  85,  87,  88,  88,  88,  87,  85,  83,  80,  76,
+        72,  67,  62,  57,  50,  44,  37,  30,  23,  15,   8,   0 }, 88},
+    /* 89 interrupts */
+    {{   8,  15,  23,  30,  38,  45,  51,  57,  63,  68,  73,  77,
+        81,  84,  86,  88,  89,  89,  89,  88,  86,  84,  81,  77,
+        73,  68,  63,  57,  51,  45,  38,  30,  23,  15,   8,   0 }, 89},
+    /* 90 interrupts */
+    {{   8,  16,  23,  31,  38,  45,  52,  58,  64,  69,  74,  78,
+        82,  85,  87,  89,  90,  90,  90,  89,  87,  85,  82,  78,
+        74,  69,  64,  58,  52,  45,  38,  31,  23,  16,   8,   0 }, 90},
+    /* 91 interrupts */
+    {{   8,  16,  24,  31,  38,  46,  52,  58,  64,  70,  75,  79,
+        82,  86,  88,  90,  91,  91,  91,  90,  88,  86,  82,  79,
+        75,  70,  64,  58,  52,  46,  38,  31,  24,  16,   8,   0 }, 91},
+    /* 92 interrupts */
+    {{   8,  16,  24,  31,  39,  46,  53,  59,  65,  70,  75,  80,
+        83,  86,  89,  91,  92,  92,  92,  91,  89,  86,  83,  80,
+        75,  70,  65,  59,  53,  46,  39,  31,  24,  16,   8,   0 }, 92},
+    /* 93 interrupts */
+    {{   8,  16,  24,  32,  39,  47,  53,  60,  66,  71,  76,  81,
+        84,  87,  90,  92,  93,  93,  93,  92,  90,  87,  84,  81,
+        76,  71,  66,  60,  53,  47,  39,  32,  24,  16,   8,   0 }, 93},
+    /* 94 interrupts */
+    {{   8,  16,  24,  32,  40,  47,  54,  60,  66,  72,  77,  81,
+        85,  88,  91,  93,  94,  94,  94,  93,  91,  88,  85,  81,
+        77,  72,  66,  60,  54,  47,  40,  32,  24,  16,   8,   0 }, 94},
+    /* 95 interrupts */
+    {{   8,  16,  25,  32,  40,  48,  54,  61,  67,  73,  78,  82,
+        86,  89,  92,  94,  95,  95,  95,  94,  92,  89,  86,  82,
+        78,  73,  67,  61,  54,  48,  40,  32,  25,  16,   8,   0 }, 95},
+    /* 96 interrupts */
+    {{   8,  17,  25,  33,  41,  48,  55,  62,  68,  74,  79,  83,
+        87,  90,  93,  95,  96,  96,  96,  95,  93,  90,  87,  83,
+        79,  74,  68,  62,  55,  48,  41,  33,  25,  17,   8,   0 }, 96},
+    /* 97 interrupts */
+    {{   8,  17,  25,  33,  41,  49,  56,  62,  69,  74,  79,  84,
+        88,  91,  94,  96,  97,  97,  97,  96,  94,  91,  88,  84,
+        79,  74,  69,  62,  56,  49,  41,  33,  25,  17,   8,   0 }, 97},
+    /* 98 interrupts */
+    {{   9,  17,  25,  34,  41,  49,  56,  63,  69,  75,  80,  85,
+        89,  92,  95,  97,  98,  98,  98,  97,  95,  92,  89,  85,
+        80,  75,  69,  63,  56,  49,  41,  34,  25,  17,   9,   0 }, 98},
+    /* 99 interrupts */
+    {{   9,  17,  26,  34,  42,  50,  57,  64,  70,  76,  81,  86,
+        90,  93,  96,  97,  99,  99,  99,  97,  96,  93,  90,  86,
+        81,  76,  70,  64,  57,  50,  42,  34,  26,  17,   9,   0 }, 99},
+    /* 100 interrupts */
+    {{   9,  17,  26,  34,  42,  50,  57,  64,  71,  77,  82,  87,
+        91,  94,  97,  98, 100, 100, 100,  98,  97,  94,  91,  87,
+        82,  77,  71,  64,  57,  50,  42,  34,  26,  17,   9,   0 }, 100},
+    /* 101 interrupts */
+    {{   9,  18,  26,  35,  43,  51,  58,  65,  71,  77,  83,  87,
+        92,  95,  98,  99, 101, 101, 101,  99,  98,  95,  92,  87,
+        83,  77,  71,  65,  58,  51,  43,  35,  26,  18,   9,   0 }, 101},
+    /* 102 interrupts */
+    {{   9,  18,  26,  35,  43,  51,  59,  66,  72,  78,  84,  88,
+        92,  96,  99, 100, 102, 102, 102, 100,  99,  96,  92,  88,
+        84,  78,  72,  66,  59,  51,  43,  35,  26,  18,   9,   0 }, 102},
+    /* 103 interrupts */
+    {{   9,  18,  27,  35,  44,  52,  59,  66,  73,  79,  84,  89,
+        93,  97,  99, 101, 103, 103, 103, 101,  99,  97,  93,  89,
+        84,  79,  73,  66,  59,  52,  44,  35,  27,  18,   9,   0 }, 103},
+    /* 104 interrupts */
+    {{   9,  18,  27,  36,  44,  52,  60,  67,  74,  80,  85,  90,
+        94,  98, 100, 102, 104, 104, 104, 102, 100,  98,  94,  90,
+        85,  80,  74,  67,  60,  52,  44,  36,  27,  18,   9,   0 }, 104},
+    /* 105 interrupts */
+    {{   9,  18,  27,  36,  44,  53,  60,  67,  74,  80,  86,  91,
+        95,  99, 101, 103, 105, 105, 105, 103, 101,  99,  95,  91,
+        86,  80,  74,  67,  60,  53,  44,  36,  27,  18,   9,   0 }, 105},
+    /* 106 interrupts */
+    {{   9,  18,  27,  36,  45,  53,  61,  68,  75,  81,  87,  92,
+        96, 100, 102, 104, 106, 106, 106, 104, 102, 100,  96,  92,
+        87,  81,  75,  68,  61,  53,  45,  36,  27,  18,   9,   0 }, 106},
+    /* 107 interrupts */
+    {{   9,  19,  28,  37,  45,  54,  61,  69,  76,  82,  88,  93,
+        97, 101, 103, 105, 107, 107, 107, 105, 103, 101,  97,  93,
+        88,  82,  76,  69,  61,  54,  45,  37,  28,  19,   9,   0 }, 107},
+    /* 108 interrupts */
+    {{   9,  19,  28,  37,  46,  54,  62,  69,  76,  83,  88,  94,
+        98, 101, 104, 106, 108, 108, 108, 106, 104, 101,  98,  94,
+        88,  83,  76,  69,  62,  54,  46,  37,  28,  19,   9,   0 }, 108}
+};
+
+/* ***************TonTableBank_Get******************
+ * Returns the precalculated ton table of one pwm cycle length
+ * Input: interrupts - the pwm cycle length {Systick Interrupts}
+ * Output: const TonTable* - the ton table, or 0 when the length is outside of the bank
+ */
+const TonTable* TonTableBank_Get(unsigned int interrupts)
+{
+    if((interrupts < TON_TABLE_BANK_SHORTEST) || (interrupts > TON_TABLE_BANK_LONGEST)) return 0;
+
+    return &_tonTableBank[interrupts - TON_TABLE_BANK_SHORTEST];
+}
+
+#endif
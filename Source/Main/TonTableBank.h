@@ -0,0 +1,46 @@
+/*
+ * TonTableBank.h
+ *
+ * The ton tables of every pwm cycle length within the drive bounds, precalculated into flash,
+ *  so a frequency change only selects a table instead of calculating it.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#ifndef SOURCE_MAIN_TONTABLEBANK_H_
+#define SOURCE_MAIN_TONTABLEBANK_H_
+
+#include "PwmOutputController.h"
+#include "SineTable.h"
+
+/* Enable (1) or disable (0) the precalculated ton tables, they are
+ *  only available for the 36 points sine table */
+#ifndef TON_TABLE_BANK
+#if SINE_TABLE_POINTS == 36
+#define TON_TABLE_BANK 1
+#else
+#define TON_TABLE_BANK 0
+#endif
+#endif
+
+/* The frequencies covered by the bank {Hz} */
+#define TON_TABLE_BANK_LOWER 30
+#define TON_TABLE_BANK_UPPER 90
+/* Their pwm cycle lengths, 233280 / (72 * wf), the bank holds every length in between {Systick Interrupts} */
+#define TON_TABLE_BANK_SHORTEST 36
+#define TON_TABLE_BANK_LONGEST 108
+
+#if TON_TABLE_BANK && (SINE_TABLE_POINTS != 36)
+#error "The ton table bank was generated for SINE_TABLE_POINTS 36, set TON_TABLE_BANK to 0"
+#endif
+
+/* ***************TonTableBank_Get******************
+ * Returns the precalculated ton table of one pwm cycle length, so any fine frequency
+ *  within the bank finds its table, not only the whole hertz
+ * Input: interrupts - the pwm cycle length {Systick Interrupts}
+ * Output: const TonTable* - the ton table, or 0 when the length is outside of the bank
+ */
+const TonTable* TonTableBank_Get(unsigned int interrupts);
+
+#endif /* SOURCE_MAIN_TONTABLEBANK_H_ */
@@ -9,11 +9,12 @@
 #include "../DeviceDrivers/LEDs.h"
 #include "../DeviceDrivers/Keyboard.h"
 #include "../DeviceDrivers/UART.h"
-#include "../DeviceDrivers/ADCSWTrigger.h"
-#include "../DeviceDrivers/Timer0.h"
 #include "../DeviceDrivers/Debug.h"
 #include "VariableFrequencyManager.h"
 #include "PwmOutputController.h"
+#include "FrequencyRamp.h"
+#include "CurrentCapture.h"
+#include "DriveAcquisition.h"
 #include "DisplayManager.h"
 #include <stdbool.h>
 
@@ -24,8 +25,8 @@
 /* Execute the initialize routine  */
 void InitializeRoutine(void);
 
-/* Take one sample from the motor current and send it through UART0 */
-void CurrentSampleHook(void);
+/* Send the RMS of the last block of the motor current through UART0, once per block */
+void SendCurrentRms(void);
 
 /* Execute the normal routine  */
 void NormalRoutine(void);
@@ -33,9 +34,12 @@ void NormalRoutine(void);
 /* Execute the configuration routine */
 void ConfigRoutine(void);
 
-/* Update smoothly the sine wave natural frequency */
+/* Follow the frequency ramp until it reaches the selected frequency */
 void UpdateRoutine(void);
 
+/* Stop the motor and bring the frequency to zero */
+void StopRoutine(void);
+
 /*  */
 void checkBounds(void);
 
@@ -50,10 +54,13 @@ static MotorState _lastMotorStatus = SM_MOTOR_INITIAL;
 static unsigned short _selectedFrequency = 60;
 /* The current fundamental frequency to the sine wave used to generate smooth updates*/
 static unsigned short _actualFrequency = 0;
+/* The bounds of the selected frequency */
+static unsigned short _lowerBound = LOWER_BOUND;
+static unsigned short _upperBound = UPPER_BOUND;
 /* Flag that enable the smooth update between two different frequencies */
 static bool _smoothUpdateEnabled = true;
-/*  */
-volatile unsigned long ADCvalue;
+/* The blocks of the motor current whose RMS was sent */
+static unsigned long _sentCurrentBlocks = 0;
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -75,22 +82,43 @@ void VariableFrequencyManager_Init(void)
     LEDs_Init();
     Keyboard_Init();
     PwmOuputController_Init(_actualFrequency);
+    FrequencyRamp_Init((unsigned long)_actualFrequency * FREQUENCY_FINE_SCALE);
 
     UART_Init();
-    ADC0_InitSWTriggerSeq3_Ch1();
 
-    /* Initialize timer0 (1800 Hz) = (~90*20)
-     * 1800 Hz allows us to read at least 20 times per cycle
-     * into the highest frequency, that is 90 Hz
-     * 80MHz/1800 = 44444.44...
-     * Maximum is 115200/32 = 3600*/
-    Timer0_Init(&CurrentSampleHook, 44444);
-//    Timer0_Init(&CurrentSampleHook, 80000000);
+#if CURRENT_CAPTURE_ENABLED
+    /* Capture the motor current in blocks of 256 samples moved by the uDMA,
+     * one sample in the middle of the on-period of every pwm cycle, so the
+     * switching ripple doesn't alias into it (72 per sine wave in table mode).
+     * The UART can't keep up with every sample (115200/32 = 3600 at most),
+     * so only the RMS of each block is sent, from the main loop */
+    CurrentCapture_Init(0);
+    PwmOuputController_SetCurrentSampling(true, SAMPLE_PHASE_ON_CENTER);
+#endif
+
+#if DRIVE_ACQUISITION_ENABLED
+    /* Both phase currents, the DC bus and the temperature once per control period */
+    DriveAcquisition_Init(0, 0, 0);
+#endif
 
     Debug_Init();
 
 }
 
+/* ********VariableFrequencyManager_SetBounds**********
+ * Update the bounds of the selected frequency, kept within
+ * the frequency bounds of the pwm output
+ * Input: lower - the lowest selectable frequency {Hz}
+ *        upper - the highest selectable frequency {Hz}
+ * Output: none
+ */
+void VariableFrequencyManager_SetBounds(unsigned short lower, unsigned short upper)
+{
+    _lowerBound = lower;
+    _upperBound = upper;
+    checkBounds();
+}
+
 /* ********VariableFrequencyManager_Run**********
  * This function execute the full logic once
  * Input: none
@@ -115,6 +143,10 @@ void VariableFrequencyManager_Run(void)
         default:
             break;
     }
+
+#if CURRENT_CAPTURE_ENABLED
+    SendCurrentRms();
+#endif
 }
 
 
@@ -143,16 +175,16 @@ void NormalRoutine(void)
     switch(Keyboard_In()) {
         case KEY_ONE:
             PwmOuputController_Start();
+            /* The ramp runs by itself, UpdateRoutine only follows it */
+            if(_smoothUpdateEnabled == true) FrequencyRamp_MoveTo((unsigned long)_selectedFrequency * FREQUENCY_FINE_SCALE);
+            else FrequencyRamp_SetFrequency((unsigned long)_selectedFrequency * FREQUENCY_FINE_SCALE);
             _lastMotorStatus = SM_MOTOR_UPDATING;
             DisplayManager_UpdatedMotorState(_lastMotorStatus);
             _state = SM_UPDATING;
             LEDs_Blue();
             break;
         case KEY_TWO:
-            PwmOuputController_Stop();
-            _actualFrequency = 0;
-            DisplayManager_UpdateActualFrequency(_actualFrequency);
-            PwmOuputController_UpdateFrequency(_actualFrequency);
+            StopRoutine();
             break;
         case KEY_THREE:
             DisplayManager_ConfigInfo(); // Display on screen all the configuration information
@@ -200,93 +232,79 @@ void ConfigRoutine(void)
 
 }
 
-/* Update smoothly the sine wave natural frequency */
+/* Follow the frequency ramp until it reaches the selected frequency.
+ * The ramp is paced by its own timer, so the keyboard is still debounced and the
+ *  display is only updated when the integer frequency changes. */
 void UpdateRoutine(void)
 {
+    bool running = FrequencyRamp_IsRunning();
+    unsigned short actual = FrequencyRamp_GetFrequency() / FREQUENCY_FINE_SCALE;
 
-    int i = 0, j=0;
-    short deltaFreq = _selectedFrequency - _actualFrequency;
-
-    if(_smoothUpdateEnabled == true)
+    if(Keyboard_In() == KEY_TWO)
     {
-        if(deltaFreq > 0)
-        {
-            for (i = 0; i < deltaFreq; i++) {
-                if(Keyboard_InNoDebounce() == KEY_TWO)
-                {
-                    PwmOuputController_Stop();
-                    _actualFrequency = 0;
-                    DisplayManager_UpdateActualFrequency(_actualFrequency);
-                    PwmOuputController_UpdateFrequency(_actualFrequency);
-                    break;
-                }
-                else
-                {
-                    _actualFrequency++;
-                    DisplayManager_UpdateActualFrequency(_actualFrequency);
-                    PwmOuputController_UpdateFrequency(_actualFrequency);
-                    for (j = 0; j < 100000; ++j);
-                }
-
-            }
-        }
-        else
-        {
-            for (i = 0; i > deltaFreq; i--) {
-                if(Keyboard_InNoDebounce() == KEY_TWO)
-                {
-                    PwmOuputController_Stop();
-                    _actualFrequency = 0;
-                    DisplayManager_UpdateActualFrequency(_actualFrequency);
-                    PwmOuputController_UpdateFrequency(_actualFrequency);
-                    break;
-                }
-                else
-                {
-                    _actualFrequency--;
-                    DisplayManager_UpdateActualFrequency(_actualFrequency);
-                    PwmOuputController_UpdateFrequency(_actualFrequency);
-                    for (j = 0; j < 100000; ++j);
-                }
-
-            }
-        }
+        StopRoutine();
+        _state = SM_NORMAL;
+        return;
     }
-    else
+
+    if(actual != _actualFrequency)
     {
-        _actualFrequency = _selectedFrequency;
+        _actualFrequency = actual;
         DisplayManager_UpdateActualFrequency(_actualFrequency);
-        PwmOuputController_UpdateFrequency(_actualFrequency);
     }
 
-    _state = SM_NORMAL;
+    if(!running) _state = SM_NORMAL;
 
 }
 
+/* Stop the motor and bring the frequency to zero, cancelling any ramp */
+void StopRoutine(void)
+{
+    PwmOuputController_Stop();
+    FrequencyRamp_SetFrequency(0);
+    _actualFrequency = 0;
+    DisplayManager_UpdateActualFrequency(_actualFrequency);
+}
+
 /* **************checkBounds*********************
  * This functions checks and update the current
  * timers values, according to their relations
- * with the specified bounds for them.
+ * with the selection bounds, narrowed to the bounds
+ * of the pwm output rounded inwards to whole Hz.
  * Input: none
  * Output: none
  */
 void checkBounds(void) {
-    if(_selectedFrequency > UPPER_BOUND) {
-        _selectedFrequency = UPPER_BOUND;
-    } else if(_selectedFrequency < LOWER_BOUND) {
-        _selectedFrequency = LOWER_BOUND;
+    unsigned short upper = PwmOuputController_GetUpperBound() / FREQUENCY_FINE_SCALE;
+    unsigned short lower = (PwmOuputController_GetLowerBound() + FREQUENCY_FINE_SCALE - 1) / FREQUENCY_FINE_SCALE;
+
+    if(_upperBound < upper) upper = _upperBound;
+    if(_lowerBound > lower) lower = _lowerBound;
+
+    if(_selectedFrequency > upper) {
+        _selectedFrequency = upper;
+    } else if(_selectedFrequency < lower) {
+        _selectedFrequency = lower;
     }
 }
 
-/* **************ReadADCHook*********************
- * Take one sample from the motor current and send it through UART0
+/* **************SendCurrentRms*********************
+ * Send the RMS of the last block of the motor current through UART0 when a new
+ *  block was captured. The UART waits for room in its FIFO, so it is done from
+ *  the main loop and not from the ADC0 SS3 interrupt; a block finished while the
+ *  main loop is busy elsewhere is only represented by the last one. Nothing is
+ *  sent until the first block, so without the capture it never sends.
  * Input: none
  * Output: none
  */
-void CurrentSampleHook(void)
+void SendCurrentRms(void)
 {
-    ADCvalue = ADC0_InSeq3();
-    UART_OutUDec(ADCvalue);
+    unsigned long blocks = CurrentCapture_GetBlockCount();
+
+    if(blocks == _sentCurrentBlocks) return;
+    _sentCurrentBlocks = blocks;
+
+    UART_OutUDec(CurrentCapture_GetRms());
     //UART_OutUDec(PwmOuputController_GetCurrentTon());
     UART_OutChar('|'); //This is the byte that synchronize with the Labview
 }
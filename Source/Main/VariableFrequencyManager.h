@@ -8,9 +8,22 @@
 #ifndef SOURCE_MAIN_VARIABLEFREQUENCYMANAGER_H_
 #define SOURCE_MAIN_VARIABLEFREQUENCYMANAGER_H_
 
+/* The default bounds of the selected frequency {Hz} */
 #define UPPER_BOUND 90
 #define LOWER_BOUND 30
 
+/* Enable (1) or disable (0) the capture of the motor current: the ADC0 SS3, the uDMA channel 17 and the
+ *  trigger of the current sampling by the modulator are only taken with it, and the RMS of each block
+ *  is sent through UART0 */
+#ifndef CURRENT_CAPTURE_ENABLED
+#define CURRENT_CAPTURE_ENABLED 0
+#endif
+/* Enable (1) or disable (0) the drive acquisition of both phase currents, the DC bus and the temperature,
+ *  the ADC0 and ADC1 SS0 triggered by TIMER3A once per control period */
+#ifndef DRIVE_ACQUISITION_ENABLED
+#define DRIVE_ACQUISITION_ENABLED 0
+#endif
+
 typedef enum {SM_INITIALIZING, SM_NORMAL, SM_CONFIGURING, SM_UPDATING} StateMachine;
 
 /* ********VariableFrequencyManager_Init**********
@@ -21,6 +34,15 @@ typedef enum {SM_INITIALIZING, SM_NORMAL, SM_CONFIGURING, SM_UPDATING} StateMach
  */
 void VariableFrequencyManager_Init(void);
 
+/* ********VariableFrequencyManager_SetBounds**********
+ * Update the bounds of the selected frequency, kept within
+ * the frequency bounds of the pwm output
+ * Input: lower - the lowest selectable frequency {Hz}
+ *        upper - the highest selectable frequency {Hz}
+ * Output: none
+ */
+void VariableFrequencyManager_SetBounds(unsigned short lower, unsigned short upper);
+
 /* ********VariableFrequencyManager_Run**********
  * This function execute the full logic once
  * Input: none
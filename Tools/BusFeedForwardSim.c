@@ -0,0 +1,198 @@
+/*
+ * BusFeedForwardSim.c
+ *
+ * Runs the DC bus feed-forward of the Systick backend on the host, the real
+ *  controller fed with frames of the real drive acquisition at ACQUISITION_FREQ.
+ *  The DC bus sags and ripples at 100 Hz, as a rectified 50 Hz mains, and each
+ *  frame carries the bus at its control period. Every pwm cycle the PendSV
+ *  calculates is then output against the bus of its on-period: its volt-seconds,
+ *  ton * bus, are compared with the ones of the same ton of the table at the
+ *  nominal bus, summed over each half sine wave, the fundamental voltage the
+ *  feed-forward has to hold. A linear V/f curve keeps the modulation index at
+ *  2/3, at the full sine wave the tons near the peak could not be raised.
+ *
+ * The gain is held over 1, 2, 4 and 8 frames, the acquisition handing only every
+ *  n-th frame, to show what updating it less often costs in ripple rejection, and
+ *  a flat bus gives the floor of the error, the ton rounded to whole interrupts.
+ *  The cost is the amount of gain updates: the pwm cycles of the table mode at
+ *  60 Hz are slower than the frames and at 200 Hz faster, where the former read
+ *  of the bus at every pwm cycle recomputed the same gain. Its Cortex-M4 cycles
+ *  are an estimate from the technical reference manual, not a measurement.
+ *
+ * Checked: the feed-forward cuts the error of the ripple to under a third,
+ *  holding the gain over more frames never rejects better, and the gain is
+ *  updated once per new frame at most, fewer times than the pwm cycles at 200 Hz.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/bus_feed_forward_sim.out Tools/BusFeedForwardSim.c Tools/HostTarget.c -lm
+ *      Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/bus_feed_forward_sim.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/DriveAcquisition.h"
+#include "Source/Main/PwmOutputController.h"
+#include <math.h>
+#include <stdio.h>
+
+#if PWM_OUTPUT_BACKEND != PWM_BACKEND_SYSTICK
+#error "The simulation runs the Systick backend"
+#endif
+
+/* The rated DC bus and its ripple, peak to peak {sample, %} */
+#define BUS_NOMINAL 3000
+#define BUS_RIPPLE 10
+#define RIPPLE_FREQ 100
+/* The simulated time, and the start left out while the first frames come {s} */
+#define SIM_TIME 0.5
+#define SETTLE_TIME 0.02
+/* The estimated Cortex-M4 cycles of a gain update, the two calls into the drive acquisition,
+ *  the UDIV and the stores, and of a pwm cycle without a new frame, one call and a compare */
+#define UPDATE_CYCLES 40
+#define CHECK_CYCLES 12
+
+/* The internals of the controller under check */
+extern SystickState _systick;
+extern MotorState _motorState;
+extern unsigned int _tonIndex;
+extern const volatile TonTable * volatile _activeTonTable;
+void PendSV_Handler(void);
+void AcquisitionPeriodTask(const unsigned short *samples);
+
+/* What one run found */
+typedef struct
+{
+    double error;               // the rms error of the volt-seconds of the half sine waves {%}
+    unsigned long cycles;       // the pwm cycles output
+    unsigned long frames;       // the frames handed to the controller
+    unsigned long updates;      // the gain updates
+} Simulated;
+
+/* The DC bus at a time, down to BUS_RIPPLE % below the nominal with the full ripple,
+ *  and flat at the same mean without it */
+static double Bus(double time, unsigned int ripple)
+{
+    return BUS_NOMINAL * (1.0 - (BUS_RIPPLE / 200.0) + ((ripple / 200.0) * cos(2 * M_PI * RIPPLE_FREQ * time)));
+}
+
+/* Output SIM_TIME of the table mode at a frequency, handing every hold-th frame */
+static Simulated Run(unsigned short freq, bool compensate, unsigned int hold, unsigned int ripple)
+{
+    unsigned short samples[ACQUISITION_MAX_CHANNELS];
+    unsigned long frame = 0;
+    unsigned long periods = 0;
+    unsigned long counted = 0;
+    unsigned int inWindow = 0;
+    double ideal = 0;
+    double delivered = 0;
+    double pendTime = 0;        // when the PendSV runs, the start of the slot being output
+    double slotStart = 0;       // when the slot it calculates starts
+    double squares = 0;
+    unsigned int i;
+    Simulated simulated = {0, 0, 0, 0};
+
+    DriveAcquisition_Init(0, 0, 0);
+    PwmOuputController_Init(freq);
+    /* The modulation index at 2/3 of the full sine wave, so the tons have room to be raised */
+    PwmOuputController_SetVfCurve(VF_CURVE_LINEAR, (freq * 3) / 2, 0);
+    PwmOuputController_SetBusCompensation(compensate, BUS_NOMINAL);
+    PwmOuputController_Start();
+
+    while(slotStart < SIM_TIME)
+    {
+        unsigned int ton;
+
+        /* The frames of the control periods up to the PendSV */
+        while(((double)frame / ACQUISITION_FREQ) <= pendTime)
+        {
+            if((frame % hold) == 0)
+            {
+                unsigned short bus = (unsigned short)(Bus((double)frame / ACQUISITION_FREQ, ripple) + 0.5);
+                for(i=0; i<ACQUISITION_MAX_CHANNELS; i++) samples[i] = bus;
+                AcquisitionPeriodTask(samples);
+                if(pendTime >= SETTLE_TIME) simulated.frames++;
+            }
+            frame++;
+        }
+
+        PendSV_Handler();
+        if(( DriveAcquisition_GetPeriods() != periods ) && compensate && ( pendTime >= SETTLE_TIME )) simulated.updates++;
+        periods = DriveAcquisition_GetPeriods();
+
+        /* The slot against the bus of the middle of its on-period, summed over each half sine wave */
+        ton = _activeTonTable->tonTable[_tonIndex];
+        if(( _motorState == SM_MOTOR_STARTED ) && ( slotStart >= SETTLE_TIME ))
+        {
+            ideal += (double)ton * BUS_NOMINAL;
+            delivered += _systick.next.ton * Bus(slotStart + (_systick.next.ton / 2.0 / INTERRUPT_FREQ), ripple);
+            if(++inWindow == (PWM_CYCLE_WITHIN_FULL_SINE / 2))
+            {
+                squares += ((delivered - ideal) / ideal) * ((delivered - ideal) / ideal);
+                counted++;
+                inWindow = 0;
+                ideal = 0;
+                delivered = 0;
+            }
+        }
+        if(slotStart >= SETTLE_TIME) simulated.cycles++;
+
+        pendTime = slotStart;
+        slotStart += (double)_systick.next.interrupts / INTERRUPT_FREQ;
+    }
+    PwmOuputController_Stop();
+    while(_motorState != SM_MOTOR_STOPPED) PendSV_Handler();
+
+    simulated.error = (counted > 0) ? (100.0 * sqrt(squares / counted)) : 0;
+    return simulated;
+}
+
+/* Print one run, with the estimated cycles per second of the feed-forward */
+static void Print(const char *name, unsigned short freq, unsigned int hold, const Simulated *simulated)
+{
+    double seconds = SIM_TIME - SETTLE_TIME;
+    double cycles = ((simulated->updates * UPDATE_CYCLES) + ((simulated->cycles - simulated->updates) * CHECK_CYCLES)) / seconds;
+
+    printf("%-14s %3u Hz, gain held %u frames: %5.2f%% rms, %6.0f pwm cycles/s, %5.0f frames/s, %5.0f updates/s, ~%.2f%% CPU\n",
+           name, freq, hold, simulated->error, simulated->cycles / seconds, simulated->frames / seconds,
+           simulated->updates / seconds, 100.0 * cycles / SYSTEM_CLOCK_FREQ);
+}
+
+int main(void)
+{
+    static const unsigned int holds[] = {1, 2, 4, 8};
+    Simulated off, flat, held[4], fast;
+    bool worse = true;
+    unsigned int i;
+
+    HostTarget_Init();
+
+    off = Run(60, false, 1, BUS_RIPPLE);
+    printf("%-14s %3u Hz: %5.2f%% rms\n", "uncompensated", 60, off.error);
+    flat = Run(60, true, 1, 0);
+    Print("flat bus", 60, 1, &flat);
+    for(i=0; i<4; i++)
+    {
+        held[i] = Run(60, true, holds[i], BUS_RIPPLE);
+        Print("compensated", 60, holds[i], &held[i]);
+        if(( i > 0 ) && ( held[i].error < held[i - 1].error )) worse = false;
+    }
+    fast = Run(200, true, 1, BUS_RIPPLE);
+    Print("compensated", 200, 1, &fast);
+    printf("the former update at every pwm cycle: %.0f updates/s, ~%.2f%% CPU at 60 Hz, %.0f updates/s, ~%.2f%% CPU at 200 Hz\n",
+           held[0].cycles / (SIM_TIME - SETTLE_TIME), 100.0 * held[0].cycles * UPDATE_CYCLES / (SIM_TIME - SETTLE_TIME) / SYSTEM_CLOCK_FREQ,
+           fast.cycles / (SIM_TIME - SETTLE_TIME), 100.0 * fast.cycles * UPDATE_CYCLES / (SIM_TIME - SETTLE_TIME) / SYSTEM_CLOCK_FREQ);
+
+    HostTarget_Check((held[0].error * 3) < off.error, "the feed-forward cuts the error of the ripple and the sag to under a third");
+    HostTarget_Check(worse, "holding the gain over more frames never rejects the ripple better");
+    HostTarget_Check(held[0].updates <= held[0].frames, "60 Hz: the gain is updated once per new frame at most");
+    HostTarget_Check(( fast.updates <= fast.frames ) && ( fast.updates < fast.cycles ),
+                     "200 Hz: the gain is updated once per new frame, fewer times than the pwm cycles");
+
+    return HostTarget_Result("BusFeedForwardSim");
+}
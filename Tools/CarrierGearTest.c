@@ -0,0 +1,153 @@
+/*
+ * CarrierGearTest.c
+ *
+ * Runs the NCO mode of the Systick backend on the host, its PendSV once per
+ *  pwm cycle, with the automatic carrier ratio.
+ *
+ * Checked at every gear boundary, going up and coming back down: the gear
+ *  shifts up just above the highest frequency of the gear and back only 1/32
+ *  below it; a new ratio is only taken on the pwm cycle after a zero crossing
+ *  of the sine wave, within one sine wave of the request; the phase
+ *  accumulator always advances by the increment of the pwm cycle it outputs,
+ *  so there is no phase jump. A sweep of the whole fine frequency range, up
+ *  and down in 0.01 Hz steps, checks the carrier stays within 3.39 to 7 kHz
+ *  from 3 Hz up, and reports the real carrier of whole Systick Interrupts.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/carrier_gear_test.out Tools/CarrierGearTest.c Tools/HostTarget.c
+ *      Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/carrier_gear_test.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/PwmOutputController.h"
+#include <stdio.h>
+
+#if PWM_OUTPUT_BACKEND != PWM_BACKEND_SYSTICK
+#error "The test runs the Systick backend"
+#endif
+
+/* The gears of the automatic carrier ratio, as PwmOutputController.c holds them */
+#define GEARS 8
+static const unsigned int _ratios[GEARS] = {1152, 576, 288, 144, 72, 36, 18, 9};
+static const unsigned long _highest[GEARS - 1] = {607, 1215, 2430, 4861, 9722, 19444, 38888};
+/* The carrier band from 3 Hz up {Hz}: 7 kHz at the top of a gear, half of it once shifted up,
+ *  down to 1/32 less before shifting back */
+#define CARRIER_LOWEST 3390
+#define CARRIER_HIGHEST 7000
+
+/* The internals of the controller under check */
+extern const volatile NcoSettings * volatile _activeNco;
+extern const volatile NcoSettings * volatile _pendingNco;
+extern unsigned long _ncoPhase;
+extern bool _ncoZeroCrossed;
+void PendSV_Handler(void);
+
+static unsigned long _shifts = 0;
+static unsigned long _shiftsOffZero = 0;
+static unsigned long _phaseJumps = 0;
+
+/* One pwm cycle, watching the ratio and the phase accumulator */
+static void PwmCycle(void)
+{
+    unsigned int ratio = _activeNco->carrierRatio;
+    bool crossed = _ncoZeroCrossed;
+    unsigned long phase = _ncoPhase;
+
+    PendSV_Handler();
+
+    if(_activeNco->carrierRatio != ratio)
+    {
+        _shifts++;
+        if(!crossed) _shiftsOffZero++;
+    }
+    if((_ncoPhase - phase) != _activeNco->phaseIncrement) _phaseJumps++;
+}
+
+/* Move to a frequency and output it until its ratio is taken, at most one sine wave of the slowest ratio */
+static unsigned int MoveTo(unsigned long freq)
+{
+    unsigned long cycle;
+
+    PwmOuputController_UpdateFrequencyFine(freq);
+    for(cycle=0; ( cycle < (2 * _ratios[0]) ) && ( _pendingNco != 0 ); cycle++) PwmCycle();
+
+    return PwmOuputController_GetCarrierRatio();
+}
+
+int main(void)
+{
+    char message[100];
+    unsigned long freq;
+    unsigned long below;
+    unsigned long carrier;
+    unsigned long lowest = 0xFFFFFFFF;
+    unsigned long highest = 0;
+    unsigned long realLowest = 0xFFFFFFFF;
+    unsigned long realHighest = 0;
+    unsigned long outOfBand = 0;
+    unsigned long real;
+    unsigned long step;
+    int pass;
+    int gear;
+
+    HostTarget_Init();
+    PwmOuputController_Init(0);
+    PwmOuputController_SetMode(PWM_MODE_NCO);
+    PwmOuputController_SetCarrierRatio(CARRIER_RATIO_AUTO);
+    PwmOuputController_UpdateFrequencyFine(FREQUENCY_RANGE_LOWER);
+    PwmOuputController_Start();
+    PwmCycle();
+    HostTarget_Check(Control_GetMotorState() == SM_MOTOR_STARTED, "the motor starts");
+    HostTarget_Check(MoveTo(FREQUENCY_RANGE_LOWER) == _ratios[0], "the lowest frequency is on the first gear");
+    /* The start takes the first settings right away */
+    _shifts = 0;
+    _shiftsOffZero = 0;
+
+    for(gear=0; gear<(GEARS - 1); gear++)
+    {
+        below = _highest[gear] - (_highest[gear] >> 5);
+
+        sprintf(message, "%lu: the gear %u stays up to its highest frequency", _highest[gear], _ratios[gear]);
+        HostTarget_Check(MoveTo(_highest[gear]) == _ratios[gear], message);
+        sprintf(message, "%lu: the gear shifts up to %u just above it", _highest[gear] + 1, _ratios[gear + 1]);
+        HostTarget_Check(MoveTo(_highest[gear] + 1) == _ratios[gear + 1], message);
+        sprintf(message, "%lu: the gear %u stays down to 1/32 below", below, _ratios[gear + 1]);
+        HostTarget_Check(MoveTo(below) == _ratios[gear + 1], message);
+        sprintf(message, "%lu: the gear shifts back to %u beyond it", below - 1, _ratios[gear]);
+        HostTarget_Check(MoveTo(below - 1) == _ratios[gear], message);
+        sprintf(message, "%lu: the gear shifts up again to %u", _highest[gear] + 1, _ratios[gear + 1]);
+        HostTarget_Check(MoveTo(_highest[gear] + 1) == _ratios[gear + 1], message);
+    }
+    printf("%lu ratio shifts at the gear boundaries, %lu off a zero crossing, %lu phase jumps\n", _shifts, _shiftsOffZero, _phaseJumps);
+    HostTarget_Check(_shifts == (GEARS - 1) * 3, "every boundary shifts up, back and up again");
+    HostTarget_Check(_shiftsOffZero == 0, "the ratio only shifts on the pwm cycle after a zero crossing");
+    HostTarget_Check(_phaseJumps == 0, "the phase accumulator never jumps");
+
+    /* The carrier of the ratio published for every frequency, up and down the range */
+    for(pass=0; pass<2; pass++)
+    {
+        for(step=0; step<=(FREQUENCY_RANGE_UPPER - 300); step++)
+        {
+            freq = (pass == 0) ? (300 + step) : (FREQUENCY_RANGE_UPPER - step);
+            PwmOuputController_UpdateFrequencyFine(freq);
+            carrier = (_pendingNco->carrierRatio * freq) / FREQUENCY_FINE_SCALE;
+            real = INTERRUPT_FREQ / _pendingNco->interruptsInPwmCycle;
+            if(( carrier < CARRIER_LOWEST ) || ( carrier > CARRIER_HIGHEST )) outOfBand++;
+            if(carrier < lowest) lowest = carrier;
+            if(carrier > highest) highest = carrier;
+            if(real < realLowest) realLowest = real;
+            if(real > realHighest) realHighest = real;
+        }
+    }
+    printf("carrier from 3 Hz up: %lu to %lu Hz, of whole Systick Interrupts %lu to %lu Hz\n", lowest, highest, realLowest, realHighest);
+    HostTarget_Check(outOfBand == 0, "the carrier stays within 3.39 to 7 kHz from 3 Hz up");
+
+    return HostTarget_Result("CarrierGearTest");
+}
@@ -0,0 +1,234 @@
+/*
+ * CarrierSpreadBench.c
+ *
+ * Runs the NCO mode of the Systick backend on the host, every Systick
+ *  Interrupt and PendSV run as on the target, with the fixed and the
+ *  randomized carrier. The load voltage is the difference of the pins PB0 and
+ *  PB1, sampled at each Systick Interrupt.
+ *
+ * Checked: at every fine frequency of the range the increment per Systick
+ *  Interrupt, held in 32 bits, is the exact one within its last fractional
+ *  bit; with the randomized carrier the phase accumulator tracks the real
+ *  time of the pwm cycles output, so the frequency doesn't drift. The
+ *  spectrum of 2^17 samples reports the fundamental and the highest component
+ *  from 2 to 16 kHz in 20 Hz bands, 60 Hz at the carrier ratio 72: the band of
+ *  10 % lowers it by more than 6 dB and the fundamental stays within 1 %.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/carrier_spread_bench.out Tools/CarrierSpreadBench.c Tools/HostTarget.c -lm
+ *      Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/carrier_spread_bench.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/PwmOutputController.h"
+#include "tm4c123gh6pm.h"
+#include <math.h>
+#include <stdio.h>
+
+#if PWM_OUTPUT_BACKEND != PWM_BACKEND_SYSTICK
+#error "The benchmark runs the Systick backend"
+#endif
+
+/* The operating point: 60 Hz at the carrier ratio 72 */
+#define BENCH_FREQUENCY 6000        // {1/FREQUENCY_FINE_SCALE Hz}
+#define BENCH_RATIO 72
+/* The samples of the spectrum, one per Systick Interrupt, and the ones left before them */
+#define SAMPLES_BITS 17
+#define SAMPLES (1UL << SAMPLES_BITS)
+#define SETTLE_TICKS 10000
+/* The band searched for the highest component and the width of its bands {Hz} */
+#define BAND_LOWER 2000
+#define BAND_UPPER 16000
+#define BAND_WIDTH 20
+
+/* The internals of the controller under check */
+extern const volatile NcoSettings * volatile _pendingNco;
+extern const volatile NcoSettings * volatile _activeNco;
+extern unsigned long _ncoPhase;
+extern long _ncoDeviation;
+void SysTick_Handler(void);
+void PendSV_Handler(void);
+
+/* What one run measured */
+typedef struct
+{
+    double fundamental;     // the fundamental of the load voltage {of the bus}
+    double highest;         // the highest component of the bands {of the bus}
+    double highestAt;       // the lower edge of its band {Hz}
+    double phaseError;      // the drift of the phase accumulator from the real time {sine waves}
+} Result;
+
+static double _re[SAMPLES];
+static double _im[SAMPLES];
+/* The phase accumulator unwrapped and the Systick Interrupts of the pwm cycles it advanced by */
+static double _phase;
+static unsigned long long _cycleInterrupts;
+
+/* One Systick Interrupt, followed by the PendSV when it was pended, following the phase accumulator */
+static double Tick(void)
+{
+    unsigned long phase;
+
+    SysTick_Handler();
+    if(NVIC_INT_CTRL_R & NVIC_INT_CTRL_PEND_SV)
+    {
+        NVIC_INT_CTRL_R &= ~NVIC_INT_CTRL_PEND_SV;
+        phase = _ncoPhase;
+        PendSV_Handler();
+        if(_ncoPhase != phase)
+        {
+            _phase += (double)(unsigned long)(_ncoPhase - phase);
+            _cycleInterrupts += _activeNco->interruptsInPwmCycle + _ncoDeviation;
+        }
+    }
+
+    return (GPIO_PORTB_DATA_BITS_R[0x01] ? 1 : 0) - (GPIO_PORTB_DATA_BITS_R[0x02] ? 1 : 0);
+}
+
+/* In place radix-2 FFT of the samples */
+static void Fft(void)
+{
+    unsigned long i;
+    unsigned long j = 0;
+    unsigned long bit;
+    unsigned long length;
+    unsigned long k;
+    double t;
+
+    for(i=1; i<SAMPLES; i++)
+    {
+        for(bit=SAMPLES >> 1; j & bit; bit >>= 1) j ^= bit;
+        j |= bit;
+        if(i < j)
+        {
+            t = _re[i]; _re[i] = _re[j]; _re[j] = t;
+            t = _im[i]; _im[i] = _im[j]; _im[j] = t;
+        }
+    }
+    for(length=2; length<=SAMPLES; length <<= 1)
+    {
+        double angle = -2 * M_PI / length;
+        for(i=0; i<SAMPLES; i+=length)
+        {
+            for(k=0; k<(length / 2); k++)
+            {
+                double wr = cos(angle * k);
+                double wi = sin(angle * k);
+                unsigned long a = i + k;
+                unsigned long b = a + (length / 2);
+                double br = (_re[b] * wr) - (_im[b] * wi);
+                double bi = (_re[b] * wi) + (_im[b] * wr);
+                _re[b] = _re[a] - br;
+                _im[b] = _im[a] - bi;
+                _re[a] += br;
+                _im[a] += bi;
+            }
+        }
+    }
+}
+
+/* The amplitude of the components from one frequency up to another {Hz}, from the power of their bins */
+static double Band(double lower, double upper)
+{
+    double resolution = (double)INTERRUPT_FREQ / SAMPLES;
+    unsigned long bin;
+    double power = 0;
+
+    for(bin=(unsigned long)ceil(lower / resolution); (bin * resolution) < upper; bin++)
+    {
+        power += (_re[bin] * _re[bin]) + (_im[bin] * _im[bin]);
+    }
+    return 2 * sqrt(power) / SAMPLES;
+}
+
+/* Output the operating point with one band of the randomized carrier and take its spectrum */
+static Result Run(unsigned int spread)
+{
+    double perInterrupt = 4294967296.0 * BENCH_FREQUENCY * PWM_CLOCKS_PER_INTERRUPT / ((double)SYSTEM_CLOCK_FREQ * FREQUENCY_FINE_SCALE);
+    double lower;
+    double band;
+    unsigned long tick;
+    Result result;
+
+    PwmOuputController_SetCarrierSpread(spread);
+    PwmOuputController_UpdateFrequencyFine(BENCH_FREQUENCY);
+    PwmOuputController_Start();
+    for(tick=0; tick<SETTLE_TICKS; tick++) Tick();
+
+    _phase = 0;
+    _cycleInterrupts = 0;
+    for(tick=0; tick<SAMPLES; tick++)
+    {
+        _re[tick] = Tick();
+        _im[tick] = 0;
+    }
+    result.phaseError = fabs(_phase - (perInterrupt * _cycleInterrupts)) / 4294967296.0;
+
+    PwmOuputController_Stop();
+    while(Control_GetMotorState() != SM_MOTOR_STOPPED) Tick();
+
+    Fft();
+    result.fundamental = Band((BENCH_FREQUENCY / FREQUENCY_FINE_SCALE) - (BAND_WIDTH / 2), (BENCH_FREQUENCY / FREQUENCY_FINE_SCALE) + (BAND_WIDTH / 2));
+    result.highest = 0;
+    result.highestAt = 0;
+    for(lower=BAND_LOWER; lower<BAND_UPPER; lower+=BAND_WIDTH)
+    {
+        band = Band(lower, lower + BAND_WIDTH);
+        if(band > result.highest)
+        {
+            result.highest = band;
+            result.highestAt = lower;
+        }
+    }
+    printf("spread %2u %%: fundamental %.4f, highest component %.4f at %5.0f Hz, phase drift %.2e sine waves\n",
+           spread, result.fundamental, result.highest, result.highestAt, result.phaseError);
+
+    return result;
+}
+
+int main(void)
+{
+    unsigned long freq;
+    unsigned long wrong = 0;
+    double exact;
+    Result fixed;
+    Result spread10;
+    Result spread25;
+
+    HostTarget_Init();
+    PwmOuputController_Init(0);
+    PwmOuputController_SetMode(PWM_MODE_NCO);
+    PwmOuputController_SetCarrierRatio(BENCH_RATIO);
+
+    /* The increment per Systick Interrupt of every fine frequency, with the band that keeps it for the most */
+    PwmOuputController_SetCarrierSpread(CARRIER_SPREAD_MAX);
+    for(freq=FREQUENCY_RANGE_LOWER; freq<=FREQUENCY_RANGE_UPPER; freq++)
+    {
+        PwmOuputController_UpdateFrequencyFine(freq);
+        exact = (double)_pendingNco->phaseIncrement / _pendingNco->interruptsInPwmCycle;
+        if(fabs((_pendingNco->incrementPerUnit / 256.0) - exact) >= (1 / 256.0)) wrong++;
+    }
+    printf("%lu fine frequencies with the increment per Systick Interrupt off its exact value\n", wrong);
+    HostTarget_Check(wrong == 0, "the increment per Systick Interrupt fits 32 bits at every frequency");
+
+    fixed = Run(0);
+    spread10 = Run(10);
+    spread25 = Run(25);
+    printf("highest component at 10 %%: %.1f dB, at 25 %%: %.1f dB\n",
+           20 * log10(spread10.highest / fixed.highest), 20 * log10(spread25.highest / fixed.highest));
+
+    HostTarget_Check(spread10.phaseError < 1e-3, "the randomized carrier of 10 % tracks the real time");
+    HostTarget_Check(spread25.phaseError < 1e-3, "the randomized carrier of 25 % tracks the real time");
+    HostTarget_Check(spread10.highest < (fixed.highest / 2), "the band of 10 % lowers the highest component by more than 6 dB");
+    HostTarget_Check(fabs(spread10.fundamental - fixed.fundamental) < (0.01 * fixed.fundamental), "the band of 10 % keeps the fundamental");
+    HostTarget_Check(fabs(spread25.fundamental - fixed.fundamental) < (0.01 * fixed.fundamental), "the band of 25 % keeps the fundamental");
+
+    return HostTarget_Result("CarrierSpreadBench");
+}
@@ -0,0 +1,433 @@
+/*
+ * CurrentBlockModel.c
+ *
+ * Register model of the block capture of the motor current: the ADC0 SS3
+ *  puts one sample into its FIFO at every trigger and the uDMA channel 17
+ *  moves it, from the control structures the real ADCT0ATrigger.c and uDMA.c
+ *  leave, into the blocks of the real CurrentCapture.c in ping-pong mode.
+ *  When a structure finishes the interrupt is raised some samples later, its
+ *  latency, and the consumer reads the block handed to it some samples after
+ *  that, the time its task lasts. Each sample is its own number, so a block
+ *  read after the uDMA started writing it again, or a block lost, shows as a
+ *  break of the sequence.
+ * With the decimation selected the software interrupt the ADC0 SS3 one
+ *  requests runs some samples later, below it, and the main context selects
+ *  a CIC and a FIR filter in turn while it isn't running.
+ * The time spent in the ADC0 SS3 interrupt is then compared with the one of
+ *  the per-sample interrupts the driver still offers, with a consumer that
+ *  measures the same statistics one sample at a time. The handlers, with the
+ *  toggles of Debug_TooglePin_2 that bracket them on the scope, are timed in
+ *  host TSC cycles per block; the entry and the exit of each interrupt are
+ *  added as the Cortex-M4 cycles of the technical reference manual, an
+ *  estimate and not a measurement.
+ *
+ * Checked: while the latency plus the task stay within one block every block
+ *  is handed whole and in order; beyond it the model shows the torn blocks,
+ *  and a latency beyond one block lets the uDMA reach the structure not armed
+ *  again, which stops the capture. The ADC0 SS3 interrupt leaves the
+ *  decimation to the software interrupt, and every block is decimated exactly
+ *  as a reference filter of its own does, the new filter from the first block
+ *  after each selection. The block mode takes one interrupt per block instead
+ *  of CURRENT_BLOCK_SAMPLES, gives the statistics of the per-sample consumer,
+ *  and spends less time in its interrupt per block, with and without their
+ *  entries and exits.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/current_block_model.out Tools/CurrentBlockModel.c Tools/HostTarget.c
+ *      Source/Main/CurrentCapture.c Source/Main/DecimationFilter.c
+ *      Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/uDMA.c Source/DeviceDrivers/Debug.c
+ *      Source/DeviceDrivers/SWInterrupt.c
+ *  Tools/current_block_model.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/DeviceDrivers/ADCT0ATrigger.h"
+#include "Source/Main/CurrentCapture.h"
+#include "Source/Main/PwmOutputController.h"
+#include "tm4c123gh6pm.h"
+#include <stdio.h>
+
+/* The uDMA channel of the ADC0 SS3 and the blocks captured by each run */
+#define CHANNEL 17
+#define BLOCKS 400
+/* The interrupt number of the software interrupt and the blocks between two selections of a filter */
+#define SW_INTERRUPT_NUMBER 51
+#define SELECTION_BLOCKS 25
+/* The blocks timed of each mode, and the Cortex-M4 cycles of the entry and the exit of an interrupt:
+ *  12 of the stacking and 10 of the unstacking, without tail-chaining */
+#define TIMED_BLOCKS 2000
+#define EXCEPTION_CYCLES 22
+
+/* The interrupt of the uDMA done, as the ADC0 SS3 vector, and the software interrupt */
+void ADC0Seq3_Handler(void);
+void ADC1Seq3_Handler(void);
+
+/* The triangle of 15 taps selected in turn with the 3rd order CIC */
+static const short _triangleTaps[] = {512, 1024, 1536, 2048, 2560, 3072, 3584, 4096, 3584, 3072, 2560, 2048, 1536, 1024, 512};
+
+/* One timing of the interrupt and the consumer {samples} */
+typedef struct
+{
+    unsigned long latency;      // from the end of a block to the interrupt
+    unsigned long task;         // from the interrupt to the end of the read of the block
+} Timing;
+
+/* What one run found */
+typedef struct
+{
+    unsigned long verified;     // the blocks read
+    unsigned long broken;       // the blocks that break the sequence of the samples
+    unsigned long lost;         // the samples the stopped channel didn't move
+} Found;
+
+/* What the timing of both modes found */
+typedef struct
+{
+    double sampleCycles;        // the host cycles of the per-sample interrupts of one block
+    double blockCycles;         // the host cycles of the interrupt of one block
+    unsigned long wrong;        // the blocks whose statistics differ between both modes
+} Timed;
+
+/* What one run with the decimation found */
+typedef struct
+{
+    unsigned long decimated;    // the blocks decimated
+    unsigned long wrong;        // the decimations off the reference
+    unsigned long inInterrupt;  // the decimations published by the ADC0 SS3 interrupt
+    unsigned long selections;   // the filters selected
+} Decimated;
+
+static bool _alternate;
+static bool _stopped;
+static unsigned long _sample;
+static const volatile unsigned short *_handed;
+static unsigned long _handedAt;
+static long _lastValue;
+static unsigned long _sampleSum;
+static unsigned long long _sampleSquares;
+static unsigned int _sampleLowest;
+static unsigned int _sampleHighest;
+static unsigned int _sampleCount;
+static unsigned int _sampleRms;
+
+/* The square root of the current capture, the per-sample consumer takes the same one */
+unsigned long SquareRoot(unsigned long value);
+
+/* The consumer of the blocks, it reads the block when its task ends */
+static void BlockConsumer(const volatile unsigned short *block)
+{
+    _handed = block;
+    _handedAt = _sample;
+}
+
+/* The per-sample consumer, it measures the RMS of each block one sample at a time */
+static void SampleConsumer(unsigned long sample)
+{
+    unsigned long mean;
+    unsigned long long meanSquare;
+
+    _sampleSum += sample;
+    _sampleSquares += sample * sample;
+    if(sample < _sampleLowest) _sampleLowest = sample;
+    if(sample > _sampleHighest) _sampleHighest = sample;
+    if(++_sampleCount == CURRENT_BLOCK_SAMPLES)
+    {
+        mean = (_sampleSum + (CURRENT_BLOCK_SAMPLES / 2)) / CURRENT_BLOCK_SAMPLES;
+        meanSquare = _sampleSquares / CURRENT_BLOCK_SAMPLES;
+        meanSquare = (meanSquare > ((unsigned long long)mean * mean)) ? (meanSquare - ((unsigned long long)mean * mean)) : 0;
+        _sampleRms = SquareRoot((unsigned long)meanSquare);
+        _sampleSum = 0;
+        _sampleSquares = 0;
+        _sampleLowest = 0xFFF;
+        _sampleHighest = 0;
+        _sampleCount = 0;
+    }
+}
+
+static unsigned long long ReadTsc(void)
+{
+    return __builtin_ia32_rdtsc();
+}
+
+/* A 12-bit sample of a current with its ripple, so both modes measure some RMS */
+static unsigned short CurrentSample(unsigned long sample)
+{
+    return (unsigned short)((2048 + ((sample * 37) % 1024) - 512) & 0xFFF);
+}
+
+/* Move one sample through the current control structure, true when it finishes */
+static bool ServeChannel(unsigned short value)
+{
+    unsigned long *entry = (unsigned long *)UDMA_CTLBASE_R + (CHANNEL * 4) + (_alternate ? 128 : 0);
+    unsigned long remaining;
+
+    /* The uDMA stops the channel at a structure that wasn't armed again, and the FIFO overflows */
+    if(_stopped || ((entry[2] & UDMA_CHCTL_XFERMODE_M) == UDMA_CHCTL_XFERMODE_STOP))
+    {
+        _stopped = true;
+        return false;
+    }
+    remaining = ((entry[2] & UDMA_CHCTL_XFERSIZE_M) >> UDMA_CHCTL_XFERSIZE_S) + 1;
+    *(volatile unsigned short *)(entry[1] - ((remaining - 1) * 2)) = value;
+    remaining--;
+    if(remaining == 0)
+    {
+        entry[2] &= ~(UDMA_CHCTL_XFERSIZE_M | UDMA_CHCTL_XFERMODE_M);
+        _alternate = !_alternate;
+    }
+    else
+    {
+        entry[2] = (entry[2] & ~UDMA_CHCTL_XFERSIZE_M) | ((remaining - 1) << UDMA_CHCTL_XFERSIZE_S);
+    }
+    UDMA_ALTSET_R = _alternate ? (1 << CHANNEL) : 0;
+    return (remaining == 0);
+}
+
+/* Check a block continues the sequence of the samples read before it */
+static bool ContinuesSequence(const volatile unsigned short *block)
+{
+    bool whole = true;
+    int i;
+
+    for(i=0; i<CURRENT_BLOCK_SAMPLES; i++)
+    {
+        if(( _lastValue >= 0 ) && ( block[i] != ((_lastValue + 1) & 0xFFF) )) whole = false;
+        _lastValue = block[i];
+    }
+    return whole;
+}
+
+/* Capture BLOCKS blocks with one timing */
+static Found Run(const Timing *timing)
+{
+    bool pending = false;
+    unsigned long due = 0;
+    Found found = {0, 0, 0};
+
+    CurrentCapture_Init(&BlockConsumer);
+    _alternate = false;
+    _stopped = false;
+    _handed = 0;
+    _lastValue = -1;
+    UDMA_ALTSET_R = 0;
+
+    for(_sample=0; _sample<(BLOCKS * CURRENT_BLOCK_SAMPLES); _sample++)
+    {
+        if(_stopped) found.lost++;
+        /* A second done before the interrupt runs is the same pending interrupt */
+        if(ServeChannel(_sample & 0xFFF) && !pending)
+        {
+            pending = true;
+            due = _sample + timing->latency;
+        }
+        if(pending && ( _sample >= due ))
+        {
+            pending = false;
+            ADC0Seq3_Handler();
+        }
+        if(( _handed != 0 ) && ( _sample >= (_handedAt + timing->task) ))
+        {
+            if(!ContinuesSequence(_handed)) found.broken++;
+            found.verified++;
+            _handed = 0;
+        }
+    }
+
+    printf("latency %3lu + task %3lu samples of %u: %3lu blocks read, %3lu broken, %6lu samples lost\n",
+           timing->latency, timing->task, CURRENT_BLOCK_SAMPLES, found.verified, found.broken, found.lost);
+
+    return found;
+}
+
+/* Load a reference filter, the CIC or the FIR, and select the same one for the capture */
+static void SelectFilter(DecimationFilter *reference, bool fir)
+{
+    if(fir)
+    {
+        DecimationFilter_InitFir(reference, _triangleTaps, sizeof(_triangleTaps) / sizeof(_triangleTaps[0]), 8);
+        CurrentCapture_SetFirDecimation(_triangleTaps, sizeof(_triangleTaps) / sizeof(_triangleTaps[0]), 8);
+    }
+    else
+    {
+        DecimationFilter_InitCic(reference, 3, 4);
+        CurrentCapture_SetOversampling(1, 3, 4);
+    }
+}
+
+/* Capture BLOCKS blocks decimated, the software interrupt runs delay samples after it is requested */
+static Decimated RunDecimation(unsigned long delay)
+{
+    static DecimationFilter reference;
+    unsigned short expected[CURRENT_FILTERED_SAMPLES];
+    const unsigned short *filtered;
+    const unsigned short *before;
+    const volatile unsigned short *block = 0;
+    unsigned int count;
+    unsigned int outputs;
+    unsigned int i;
+    bool pending = false;
+    bool fir = false;
+    unsigned long due = 0;
+    unsigned long blocks = 0;
+    Decimated decimated = {0, 0, 0, 0};
+
+    CurrentCapture_Init(&BlockConsumer);
+    _alternate = false;
+    _stopped = false;
+    _handed = 0;
+    UDMA_ALTSET_R = 0;
+    NVIC_SW_TRIG_R = 0;
+    SelectFilter(&reference, fir);
+
+    for(_sample=0; _sample<(BLOCKS * CURRENT_BLOCK_SAMPLES); _sample++)
+    {
+        if(ServeChannel(_sample & 0xFFF))
+        {
+            before = CurrentCapture_GetFiltered(&count);
+            ADC0Seq3_Handler();
+            if(CurrentCapture_GetFiltered(&count) != before) decimated.inInterrupt++;
+            block = _handed;
+            _handed = 0;
+            blocks++;
+        }
+        if(NVIC_SW_TRIG_R == SW_INTERRUPT_NUMBER)
+        {
+            NVIC_SW_TRIG_R = 0;
+            pending = true;
+            due = _sample + delay;
+        }
+        if(pending && ( _sample >= due ))
+        {
+            pending = false;
+            ADC1Seq3_Handler();
+            outputs = DecimationFilter_Process(&reference, block, CURRENT_BLOCK_SAMPLES, expected);
+            filtered = CurrentCapture_GetFiltered(&count);
+            if(count != outputs) decimated.wrong++;
+            else
+            {
+                for(i=0; i<count; i++) if(filtered[i] != expected[i]) break;
+                if(i < count) decimated.wrong++;
+            }
+            decimated.decimated++;
+        }
+        /* The main context runs while no interrupt is pending */
+        if(!pending && ( blocks == SELECTION_BLOCKS ))
+        {
+            blocks = 0;
+            fir = !fir;
+            SelectFilter(&reference, fir);
+            decimated.selections++;
+        }
+    }
+
+    CurrentCapture_SetOversampling(1, 0, 0);
+    printf("decimation %3lu samples after the block: %3lu blocks decimated, %lu off the reference, %lu by the ADC0 SS3 interrupt, %lu filters selected\n",
+           delay, decimated.decimated, decimated.wrong, decimated.inInterrupt, decimated.selections);
+
+    return decimated;
+}
+
+/* Time TIMED_BLOCKS blocks in both modes, the per-sample interrupts of a block together and the
+ *  block one alone, and compare the RMS of every block */
+static Timed TimeInterrupts(void)
+{
+    unsigned long long start;
+    unsigned long long sampleTotal = 0;
+    unsigned long long blockTotal = 0;
+    unsigned long block;
+    unsigned int i;
+    unsigned int rms[TIMED_BLOCKS];
+    Timed timed = {0, 0, 0};
+
+    ADC0_InitTimer0ATriggerSeq3_Ch1(&SampleConsumer, SYSTEM_CLOCK_FREQ / CURRENT_SAMPLE_FREQ);
+    _sampleSum = 0;
+    _sampleSquares = 0;
+    _sampleLowest = 0xFFF;
+    _sampleHighest = 0;
+    _sampleCount = 0;
+    for(block=0; block<TIMED_BLOCKS; block++)
+    {
+        start = ReadTsc();
+        for(i=0; i<CURRENT_BLOCK_SAMPLES; i++)
+        {
+            ADC0_SSFIFO3_R = CurrentSample((block * CURRENT_BLOCK_SAMPLES) + i);
+            ADC0Seq3_Handler();
+        }
+        sampleTotal += ReadTsc() - start;
+        rms[block] = _sampleRms;
+    }
+
+    CurrentCapture_Init(0);
+    _alternate = false;
+    _stopped = false;
+    UDMA_ALTSET_R = 0;
+    for(_sample=0; _sample<(TIMED_BLOCKS * CURRENT_BLOCK_SAMPLES); _sample++)
+    {
+        if(ServeChannel(CurrentSample(_sample)))
+        {
+            start = ReadTsc();
+            ADC0Seq3_Handler();
+            blockTotal += ReadTsc() - start;
+            if(CurrentCapture_GetRms() != rms[_sample / CURRENT_BLOCK_SAMPLES]) timed.wrong++;
+        }
+    }
+
+    timed.sampleCycles = (double)sampleTotal / TIMED_BLOCKS;
+    timed.blockCycles = (double)blockTotal / TIMED_BLOCKS;
+    printf("per-sample: %u interrupts, %7.1f host cycles + %u of entries and exits per block\n",
+           CURRENT_BLOCK_SAMPLES, timed.sampleCycles, CURRENT_BLOCK_SAMPLES * EXCEPTION_CYCLES);
+    printf("block mode: 1 interrupt, %7.1f host cycles + %u of entry and exit per block, %.0f%% less time in the interrupts\n",
+           timed.blockCycles, EXCEPTION_CYCLES,
+           100.0 * (1.0 - ((timed.blockCycles + EXCEPTION_CYCLES) / (timed.sampleCycles + (CURRENT_BLOCK_SAMPLES * EXCEPTION_CYCLES)))));
+    printf("at %u Hz: %u interrupts/s against %.1f, the entries and exits alone %.2f%% of the CPU against %.3f%%\n",
+           CURRENT_SAMPLE_FREQ, CURRENT_SAMPLE_FREQ, (double)CURRENT_SAMPLE_FREQ / CURRENT_BLOCK_SAMPLES,
+           100.0 * CURRENT_SAMPLE_FREQ * EXCEPTION_CYCLES / SYSTEM_CLOCK_FREQ,
+           100.0 * CURRENT_SAMPLE_FREQ * EXCEPTION_CYCLES / CURRENT_BLOCK_SAMPLES / SYSTEM_CLOCK_FREQ);
+
+    return timed;
+}
+
+int main(void)
+{
+    /* Within one block, the last one up to its last sample */
+    static const Timing within[] = {{10, 50}, {128, 120}, {200, CURRENT_BLOCK_SAMPLES - 201}};
+    static const Timing torn = {150, 150};
+    static const Timing late = {CURRENT_BLOCK_SAMPLES + 44, 0};
+    Found found;
+    Timed timed;
+    unsigned int i;
+
+    HostTarget_Init();
+
+    for(i=0; i<(sizeof(within) / sizeof(within[0])); i++)
+    {
+        found = Run(&within[i]);
+        HostTarget_Check(found.verified >= (BLOCKS - 1), "within one block every block is handed");
+        HostTarget_Check(found.broken == 0, "within one block every block is whole and in order");
+        HostTarget_Check(found.lost == 0, "within one block no sample is lost");
+    }
+
+    found = Run(&torn);
+    HostTarget_Check(found.broken > 0, "the model shows the blocks torn past one block");
+    found = Run(&late);
+    HostTarget_Check(found.lost > 0, "the model shows the capture stopped by a latency past one block");
+
+    for(i=0; i<2; i++)
+    {
+        Decimated decimated = RunDecimation(i ? (CURRENT_BLOCK_SAMPLES - 1) : 10);
+        HostTarget_Check(decimated.decimated >= (BLOCKS - 1), "every block is decimated by the software interrupt");
+        HostTarget_Check(decimated.inInterrupt == 0, "the ADC0 SS3 interrupt doesn't decimate");
+        HostTarget_Check(( decimated.wrong == 0 ) && ( decimated.selections > 0 ), "every decimation is the one of the filter selected before it");
+    }
+
+    timed = TimeInterrupts();
+    HostTarget_Check(timed.wrong == 0, "the block mode gives the RMS of the per-sample consumer");
+    HostTarget_Check(timed.blockCycles < timed.sampleCycles, "the block mode spends less time in its interrupt per block");
+    HostTarget_Check(( timed.blockCycles + EXCEPTION_CYCLES ) < ( timed.sampleCycles + (CURRENT_BLOCK_SAMPLES * EXCEPTION_CYCLES) ),
+                     "the block mode spends less time in its interrupt per block with the entries and exits");
+
+    return HostTarget_Result("CurrentBlockModel");
+}
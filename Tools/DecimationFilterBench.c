@@ -0,0 +1,202 @@
+/*
+ * DecimationFilterBench.c
+ *
+ * Runs the decimation filter on the host, its inner loop through the portable
+ *  SMLAD, and compares it with a direct convolution of the taps in their own
+ *  order over the whole stream of inputs, blocks of random 12-bit samples fed
+ *  one after the other as the current capture does.
+ *
+ * Checked: every CIC order with every factor that fits, a FIR with negative
+ *  taps and an odd amount of taps give the outputs of the reference bit for
+ *  bit across the blocks; the full scale input comes out as 4095 << 4 and the
+ *  CIC filters reject a sine wave at the output rate, their first zero. The
+ *  cycles are host TSC cycles per output sample; the SMLAD per output, taps / 2,
+ *  are what the Cortex-M4F loop costs, where CurrentCapture_GetFilterCycles
+ *  measures it.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/decimation_filter_bench.out Tools/DecimationFilterBench.c Tools/HostTarget.c -lm
+ *      Source/Main/DecimationFilter.c
+ *  Tools/decimation_filter_bench.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/DecimationFilter.h"
+#include <math.h>
+#include <stdio.h>
+
+/* The blocks of each comparison and their samples, as the current capture */
+#define BLOCKS 8
+#define BLOCK_SAMPLES 256
+/* The blocks timed of each filter */
+#define BENCH_BLOCKS 20000
+
+/* A FIR with negative taps, DC gain 32768, and a triangle of 15 taps */
+static const short _negativeTaps[] = {-512, 0, 3072, 8192, 11264, 8192, 3072, 0, -512};
+static const short _triangleTaps[] = {512, 1024, 1536, 2048, 2560, 3072, 3584, 4096, 3584, 3072, 2560, 2048, 1536, 1024, 512};
+
+/* What one comparison found */
+typedef struct
+{
+    unsigned long outputs;      // the outputs compared
+    unsigned long wrong;        // the ones off the reference
+    double cycles;              // host TSC cycles per output
+} Compared;
+
+static unsigned short _inputs[BLOCKS * BLOCK_SAMPLES];
+static unsigned short _outputs[BLOCK_SAMPLES];
+static unsigned long _seed = 12345;
+
+static unsigned long long ReadTsc(void)
+{
+    return __builtin_ia32_rdtsc();
+}
+
+/* A pseudo random 12-bit sample */
+static unsigned short Random12(void)
+{
+    _seed = (_seed * 1103515245UL) + 12345UL;
+    return (unsigned short)((_seed >> 16) & 0xFFF);
+}
+
+/* The taps of a filter in their own order, from its reversed ones */
+static unsigned int Taps(const DecimationFilter *filter, long *taps)
+{
+    unsigned int i;
+
+    for(i=0; i<filter->taps; i++) taps[i] = filter->coefficients.values[filter->taps - 1 - i];
+    return filter->taps;
+}
+
+/* The reference output that ends at one input of the stream, the inputs before the stream are 0 */
+static unsigned short Reference(const long *taps, unsigned int count, const unsigned short *stream, unsigned long last)
+{
+    long long acc = 0;
+    unsigned int k;
+
+    for(k=0; (k < count) && (k <= last); k++) acc += taps[k] * (long long)stream[last - k];
+    acc = (acc + (1LL << (14 - DECIMATION_EXTRA_BITS))) >> (15 - DECIMATION_EXTRA_BITS);
+    return (acc < 0) ? 0 : ((acc > 0xFFFF) ? 0xFFFF : (unsigned short)acc);
+}
+
+/* Filter BLOCKS blocks of the inputs and compare every output with the reference, then time it */
+static Compared Compare(DecimationFilter *filter, const char *name)
+{
+    long taps[DECIMATION_MAX_TAPS];
+    unsigned int count = Taps(filter, taps);
+    unsigned int block;
+    unsigned int outputs;
+    unsigned int i;
+    unsigned long long start;
+    unsigned long sink = 0;
+    Compared compared = {0, 0, 0};
+
+    for(block=0; block<BLOCKS; block++)
+    {
+        outputs = DecimationFilter_Process(filter, &_inputs[block * BLOCK_SAMPLES], BLOCK_SAMPLES, _outputs);
+        for(i=0; i<outputs; i++)
+        {
+            unsigned long last = (block * BLOCK_SAMPLES) + ((i + 1) * filter->factor) - 1;
+            if(_outputs[i] != Reference(taps, count, _inputs, last)) compared.wrong++;
+            compared.outputs++;
+        }
+    }
+
+    start = ReadTsc();
+    for(block=0; block<BENCH_BLOCKS; block++)
+    {
+        outputs = DecimationFilter_Process(filter, &_inputs[(block % BLOCKS) * BLOCK_SAMPLES], BLOCK_SAMPLES, _outputs);
+        sink += _outputs[0];
+    }
+    compared.cycles = (double)(ReadTsc() - start) / ((double)BENCH_BLOCKS * outputs);
+
+    printf("%-14s factor %2u, %2u taps: %4lu outputs, %lu off the reference, %2u SMLAD and %6.1f host cycles per output (%lu)\n",
+           name, filter->factor, filter->taps, compared.outputs, compared.wrong, filter->taps / 2, compared.cycles, sink & 1);
+
+    return compared;
+}
+
+/* The highest output of a constant input, once the filter is filled */
+static unsigned short FullScale(DecimationFilter *filter)
+{
+    unsigned int outputs = 0;
+    unsigned int i;
+
+    for(i=0; i<BLOCK_SAMPLES; i++) _inputs[i] = 4095;
+    for(i=0; i<2; i++) outputs = DecimationFilter_Process(filter, _inputs, BLOCK_SAMPLES, _outputs);
+    return _outputs[outputs - 1];
+}
+
+/* The highest distance from the mid scale of the outputs of a sine wave at the output rate */
+static unsigned int OutputRateRipple(DecimationFilter *filter)
+{
+    unsigned int outputs = 0;
+    unsigned int ripple = 0;
+    unsigned int i;
+
+    for(i=0; i<BLOCK_SAMPLES; i++) _inputs[i] = (unsigned short)(2048 + floor((2000 * sin(2 * M_PI * i / filter->factor)) + 0.5));
+    for(i=0; i<2; i++) outputs = DecimationFilter_Process(filter, _inputs, BLOCK_SAMPLES, _outputs);
+    for(i=0; i<outputs; i++)
+    {
+        unsigned int distance = (_outputs[i] > (2048 << DECIMATION_EXTRA_BITS)) ? (_outputs[i] - (2048 << DECIMATION_EXTRA_BITS)) : ((2048 << DECIMATION_EXTRA_BITS) - _outputs[i]);
+        if(distance > ripple) ripple = distance;
+    }
+    return ripple;
+}
+
+int main(void)
+{
+    static DecimationFilter filter;
+    char name[40];
+    char message[120];
+    unsigned int order;
+    unsigned int factor;
+    unsigned int i;
+    Compared compared;
+
+    HostTarget_Init();
+
+    for(i=0; i<(BLOCKS * BLOCK_SAMPLES); i++) _inputs[i] = Random12();
+
+    for(order=1; order<=DECIMATION_MAX_CIC_ORDER; order++)
+    {
+        for(factor=2; factor<=16; factor*=2)
+        {
+            HostTarget_Check(DecimationFilter_InitCic(&filter, order, factor), "the CIC filter fits");
+            sprintf(name, "CIC order %u", order);
+            compared = Compare(&filter, name);
+            sprintf(message, "CIC order %u factor %u: every output is the reference", order, factor);
+            HostTarget_Check(( compared.outputs == (BLOCKS * BLOCK_SAMPLES / factor) ) && ( compared.wrong == 0 ), message);
+        }
+    }
+    HostTarget_Check(!DecimationFilter_InitCic(&filter, 4, 32), "a CIC filter past the taps is refused");
+
+    HostTarget_Check(DecimationFilter_InitFir(&filter, _negativeTaps, sizeof(_negativeTaps) / sizeof(_negativeTaps[0]), 2), "the FIR fits");
+    compared = Compare(&filter, "FIR negative");
+    HostTarget_Check(compared.wrong == 0, "the FIR with negative taps gives the reference");
+    HostTarget_Check(DecimationFilter_InitFir(&filter, _triangleTaps, sizeof(_triangleTaps) / sizeof(_triangleTaps[0]), 8), "the FIR fits");
+    compared = Compare(&filter, "FIR triangle");
+    HostTarget_Check(compared.wrong == 0, "the FIR of an odd amount of taps gives the reference");
+
+    /* The random inputs are used up, the scale and the zeros of the CIC filters come last */
+    for(order=1; order<=DECIMATION_MAX_CIC_ORDER; order++)
+    {
+        unsigned short full;
+        unsigned int ripple;
+
+        DecimationFilter_InitCic(&filter, order, 8);
+        full = FullScale(&filter);
+        DecimationFilter_InitCic(&filter, order, 8);
+        ripple = OutputRateRipple(&filter);
+        printf("CIC order %u factor 8: full scale %u, sine wave at the output rate within %u of the mid scale\n", order, full, ripple);
+        sprintf(message, "CIC order %u: the full scale input comes out as 4095 << 4", order);
+        HostTarget_Check(full == (4095 << DECIMATION_EXTRA_BITS), message);
+        sprintf(message, "CIC order %u: the sine wave at the output rate is rejected", order);
+        HostTarget_Check(ripple <= (1 << DECIMATION_EXTRA_BITS), message);
+    }
+
+    return HostTarget_Result("DecimationFilterBench");
+}
@@ -0,0 +1,221 @@
+/*
+ * DriveAcquisitionModel.c
+ *
+ * Register model of the drive acquisition: the real ADCT3ATrigger.c is built
+ *  into this program with the SS0 FIFOs of both ADCs replaced by queues the
+ *  model fills at each control period, and the raw interrupt flags by reads
+ *  that count the polls. The model then raises the SS0 interrupts of the
+ *  period in either order, or loses the ADC1 sequence of a period, and the
+ *  real DriveAcquisition.c builds the frames. Each sample is the analog input
+ *  of its channel and the period it was taken in, so a frame that mixes two
+ *  periods or puts a channel at the wrong position shows.
+ *
+ * Checked: whichever sequence ends first, every period is handed once as a
+ *  whole frame in the order of the list, by the interrupt of the sequence
+ *  that ends last; a period the ADC1 sequence missed is dropped and the next
+ *  one is whole; neither interrupt polls the other ADC; every FIFO is read
+ *  exactly down to empty. The same with the channels of ADC0 only.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/drive_acquisition_model.out Tools/DriveAcquisitionModel.c Tools/HostTarget.c
+ *      Source/Main/DriveAcquisition.c
+ *  Tools/drive_acquisition_model.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "tm4c123gh6pm.h"
+#include <stdio.h>
+
+/* The periods of each run and the polls of a raw flag that mean an interrupt is waiting */
+#define PERIODS 300
+#define POLL_LIMIT 1000
+
+/* The FIFOs and the raw flags of both SS0, read through the model */
+static volatile unsigned long *FifoRead(unsigned int adc);
+static volatile unsigned long *RisRead(unsigned int adc);
+#undef ADC0_SSFIFO0_R
+#undef ADC1_SSFIFO0_R
+#undef ADC0_RIS_R
+#undef ADC1_RIS_R
+#define ADC0_SSFIFO0_R (*FifoRead(0))
+#define ADC1_SSFIFO0_R (*FifoRead(1))
+#define ADC0_RIS_R (*RisRead(0))
+#define ADC1_RIS_R (*RisRead(1))
+#include "Source/DeviceDrivers/ADCT3ATrigger.c"
+#include "Source/Main/DriveAcquisition.h"
+
+/* How the SS0 interrupts of one period are raised */
+typedef enum {
+    ORDER_ADC0_FIRST,
+    ORDER_ADC1_FIRST,
+    ORDER_ADC1_MISSED,  // the ADC1 sequence missed the trigger, the next period raises ADC0 first
+    ORDERS
+} Order;
+
+/* What one run found */
+typedef struct
+{
+    unsigned long expected;     // the periods that should be handed
+    unsigned long handed;       // the frames handed
+    unsigned long broken;       // the frames with a value of another channel or period
+    unsigned long early;        // the frames handed before the last sequence of the period ended
+    unsigned long polls;        // the reads of a raw flag
+    unsigned long fifoErrors;   // the FIFO reads past the samples, and the samples left
+} Found;
+
+static const AcquisitionChannel *_channels;
+static unsigned int _count;
+static unsigned short _fifo[2][ADC_SEQ0_STEPS];
+static unsigned int _fifoCount[2];
+static unsigned int _fifoRead[2];
+static volatile unsigned long _fifoValue;
+static volatile unsigned long _risValue;
+static unsigned long _period;
+static bool _lastEnded;
+static Found _found;
+
+/* Pop one sample of the FIFO of an ADC */
+static volatile unsigned long *FifoRead(unsigned int adc)
+{
+    if(_fifoRead[adc] < _fifoCount[adc]) _fifoValue = _fifo[adc][_fifoRead[adc]++];
+    else
+    {
+        _fifoValue = 0;
+        _found.fifoErrors++;
+    }
+    return &_fifoValue;
+}
+
+/* A raw flag, read as set after POLL_LIMIT polls so a waiting interrupt doesn't hang the model */
+static volatile unsigned long *RisRead(unsigned int adc)
+{
+    (void)adc;
+    _found.polls++;
+    _risValue = (_found.polls % POLL_LIMIT) ? 0 : 0x01;
+    return &_risValue;
+}
+
+/* The sample of one channel in one period */
+static unsigned short Sample(unsigned int input, unsigned long period)
+{
+    return (unsigned short)((input << 8) | (period & 0xFF));
+}
+
+/* The consumer of the frames, checks every value against its channel and the period */
+static void FrameConsumer(const AcquisitionFrame *frame)
+{
+    unsigned int i;
+
+    _found.handed++;
+    if(!_lastEnded) _found.early++;
+    for(i=0; i<_count; i++)
+    {
+        if(frame->values[i] != Sample(_channels[i].input, _period))
+        {
+            _found.broken++;
+            break;
+        }
+    }
+}
+
+/* Convert the sequence of one ADC: its FIFO holds the samples of the period */
+static void Convert(unsigned int adc)
+{
+    unsigned int i;
+
+    _fifoCount[adc] = 0;
+    _fifoRead[adc] = 0;
+    for(i=0; i<_count; i++)
+    {
+        if(_channels[i].adc == adc) _fifo[adc][_fifoCount[adc]++] = Sample(_channels[i].input, _period);
+    }
+}
+
+/* Raise the SS0 interrupt of one ADC and check its FIFO was read down to empty */
+static void Raise(unsigned int adc, bool last)
+{
+    _lastEnded = last;
+    if(adc == 0) ADC0Seq0_Handler();
+    else ADC1Seq0_Handler();
+    if(_fifoRead[adc] != _fifoCount[adc]) _found.fifoErrors++;
+}
+
+/* Acquire PERIODS periods of a list, raising the interrupts in turn in every order */
+static Found Run(const AcquisitionChannel *channels, unsigned int count, const char *name)
+{
+    bool adc1 = false;
+    unsigned int i;
+
+    _channels = channels;
+    _count = count;
+    for(i=0; i<count; i++) if(channels[i].adc == ACQUISITION_ADC1) adc1 = true;
+    _found = (Found){0, 0, 0, 0, 0, 0};
+    DriveAcquisition_Init(channels, count, &FrameConsumer);
+
+    for(_period=0; _period<PERIODS; _period++)
+    {
+        Order order = (Order)(_period % ORDERS);
+
+        Convert(0);
+        if(!adc1)
+        {
+            _found.expected++;
+            Raise(0, true);
+        }
+        else if(order == ORDER_ADC0_FIRST)
+        {
+            Convert(1);
+            _found.expected++;
+            Raise(0, false);
+            Raise(1, true);
+        }
+        else if(order == ORDER_ADC1_FIRST)
+        {
+            Convert(1);
+            _found.expected++;
+            Raise(1, false);
+            Raise(0, true);
+        }
+        else
+        {
+            /* The ADC0 sequence alone, the period can't be handed */
+            Raise(0, false);
+        }
+    }
+
+    printf("%-9s: %3lu periods handed of %3lu, %lu broken, %lu early, %lu polls, %lu FIFO errors\n",
+           name, _found.handed, _found.expected, _found.broken, _found.early, _found.polls, _found.fifoErrors);
+
+    return _found;
+}
+
+int main(void)
+{
+    /* Both ADCs interleaved, ADC1 first in the list, with the temperature sensor */
+    static const AcquisitionChannel interleaved[] = {
+        {ACQUISITION_ADC1, 5}, {ACQUISITION_ADC0, 1}, {ACQUISITION_ADC0, ADC_CHANNEL_TEMP},
+        {ACQUISITION_ADC1, 2}, {ACQUISITION_ADC0, 9}, {ACQUISITION_ADC1, 11}, {ACQUISITION_ADC1, 0}
+    };
+    static const AcquisitionChannel adc0Only[] = {
+        {ACQUISITION_ADC0, 3}, {ACQUISITION_ADC0, 0}, {ACQUISITION_ADC0, 7}
+    };
+    Found found;
+
+    HostTarget_Init();
+
+    found = Run(interleaved, sizeof(interleaved) / sizeof(interleaved[0]), "both ADCs");
+    HostTarget_Check(found.handed == found.expected, "both ADCs: every period both sequences ended is handed once");
+    HostTarget_Check(found.broken == 0, "both ADCs: every frame is whole, of one period and in the order of the list");
+    HostTarget_Check(found.early == 0, "both ADCs: the frame is handed by the sequence that ends last");
+    HostTarget_Check(found.polls == 0, "both ADCs: neither interrupt polls the other ADC");
+    HostTarget_Check(found.fifoErrors == 0, "both ADCs: every FIFO is read down to empty");
+
+    found = Run(adc0Only, sizeof(adc0Only) / sizeof(adc0Only[0]), "ADC0 only");
+    HostTarget_Check(( found.handed == PERIODS ) && ( found.broken == 0 ), "ADC0 only: every period is handed whole");
+    HostTarget_Check(( found.polls == 0 ) && ( found.fifoErrors == 0 ), "ADC0 only: the FIFO is read down to empty without polls");
+
+    return HostTarget_Result("DriveAcquisitionModel");
+}
@@ -0,0 +1,236 @@
+/*
+ * FrequencyRangeSweep.c
+ *
+ * Sweeps the table and the NCO mode of the Systick backend on the host from
+ *  0.5 to 400 Hz, the PendSV run once per pwm cycle, and measures at each
+ *  frequency the resolution and the distortion of the output.
+ *
+ * The output is rebuilt at the resolution of the Systick Interrupt, +1 while
+ *  the HI pin is on, -1 while the LOW pin is, 0 otherwise, over 4 whole sine
+ *  waves after the first one. Its harmonics come from the DFT at the output
+ *  frequency, each pulse of a pwm cycle added in closed form, so even the
+ *  6480 interrupts per pwm cycle of 0.5 Hz cost one term per harmonic. The
+ *  resolution is the length of the pwm cycle, the ton steps by one Systick
+ *  Interrupt of it; the table mode outputs the frequency of its whole pwm
+ *  cycle length, INTERRUPT_FREQ / (72 * interrupts), the NCO mode the exact
+ *  one on average. The THD goes up to the 40th harmonic, which takes in the
+ *  carrier of the low carrier ratios, and below the carrier, the harmonics
+ *  under half the carrier ratio, what the motor inductance doesn't filter.
+ *
+ * Checked: the table mode has 6480 interrupts per pwm cycle at 0.5 Hz and 8 at
+ *  400 Hz, the NCO mode with the automatic carrier never less than its 7 kHz
+ *  carrier, 33; both output the full sine wave at every frequency and keep the
+ *  THD below the carrier under 3 % up to 90 Hz; below 30 Hz the NCO mode has
+ *  less than half the THD of the table mode, bound by its 36 points; going to
+ *  0 Hz stops the motor through the idle slots, with the pins LOW.
+ *
+ * Above 90 Hz neither mode holds it. The table mode is down to 8 interrupts
+ *  per pwm cycle, about 5 % at 400 Hz, and outputs the frequency of its whole
+ *  pwm cycle, 405 Hz. The NCO mode keeps the exact frequency, but its top gears
+ *  only have 9 to 36 pwm cycles per sine wave, up to 16 % below the carrier.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/frequency_range_sweep.out Tools/FrequencyRangeSweep.c Tools/HostTarget.c -lm
+ *      Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/frequency_range_sweep.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/PwmOutputController.h"
+#include "tm4c123gh6pm.h"
+#include <math.h>
+#include <stdio.h>
+
+#if PWM_OUTPUT_BACKEND != PWM_BACKEND_SYSTICK
+#error "The sweep runs the Systick backend"
+#endif
+
+/* The sine waves measured, after the first one, and the highest harmonic of the THD */
+#define SINE_WAVES 4
+#define HARMONICS 40
+/* The fewest interrupts per pwm cycle of the NCO mode, its 7 kHz carrier at the top of a gear */
+#define NCO_LEAST_INTERRUPTS (INTERRUPT_FREQ / 7000)
+/* The highest THD below the carrier up to 90 Hz {%} */
+#define THD_MAX 3.0
+/* The top of the former drive range and the frequencies below which the NCO mode
+ *  halves the distortion of the table mode {1/FREQUENCY_FINE_SCALE Hz} */
+#define DRIVE_UPPER 9000
+#define LOW_FREQUENCIES 3000
+
+/* The internals of the controller under check */
+extern SystickState _systick;
+extern MotorState _motorState;
+extern const volatile TonTable * volatile _activeTonTable;
+void PendSV_Handler(void);
+
+/* What one frequency gave */
+typedef struct
+{
+    double frequency;           // the output frequency {Hz}
+    unsigned int least;         // the shortest pwm cycle {Systick Interrupts}
+    unsigned int most;          // the longest pwm cycle {Systick Interrupts}
+    double fundamental;         // the amplitude of the fundamental {DC bus}
+    double thd;                 // up to the HARMONICS-th harmonic {%}
+    unsigned int ratio;         // the pwm cycles per sine wave
+    double baseband;            // the THD of the harmonics below half the carrier ratio {%}
+} Swept;
+
+/* The fine frequencies of the sweep {1/FREQUENCY_FINE_SCALE Hz} */
+static const unsigned long _frequencies[] = {50, 100, 200, 500, 1000, 3000, 6000, 9000, 15000, 20000, 30000, 40000};
+#define FREQUENCIES (sizeof(_frequencies) / sizeof(_frequencies[0]))
+
+static double _re[HARMONICS + 1];
+static double _im[HARMONICS + 1];
+
+/* Add a pulse of a sign from a sample on, ton samples long, to the DFT at the harmonics of a frequency:
+ *  the sum of e^(-jwn) over the pulse is e^(-jw start) (1 - e^(-jw ton)) / (1 - e^(-jw)) */
+static void AddPulse(double frequency, unsigned long long start, unsigned int ton, double sign)
+{
+    unsigned int k;
+
+    if(ton == 0) return;
+    for(k=1; k<=HARMONICS; k++)
+    {
+        double w = (2 * M_PI * k * frequency) / INTERRUPT_FREQ;
+        double numRe = 1 - cos(w * ton), numIm = sin(w * ton);
+        double denRe = 1 - cos(w), denIm = sin(w);
+        double den = (denRe * denRe) + (denIm * denIm);
+        double sumRe = ((numRe * denRe) + (numIm * denIm)) / den;
+        double sumIm = ((numIm * denRe) - (numRe * denIm)) / den;
+        double phase = -w * (double)start;
+
+        _re[k] += sign * ((sumRe * cos(phase)) - (sumIm * sin(phase)));
+        _im[k] += sign * ((sumRe * sin(phase)) + (sumIm * cos(phase)));
+    }
+}
+
+/* Output one frequency in one mode and measure it */
+static Swept Sweep(PwmMode mode, unsigned long freq)
+{
+    unsigned long long samples = 0;
+    unsigned long long length;
+    unsigned long long skip = 0;
+    double harmonics = 0;
+    unsigned int k;
+    double baseband = 0;
+    Swept swept = {0, 0xFFFFFFFF, 0, 0, 0, 0, 0};
+
+    PwmOuputController_Init(60);
+    PwmOuputController_SetMode(mode);
+    PwmOuputController_SetCarrierRatio((mode == PWM_MODE_NCO) ? CARRIER_RATIO_AUTO : PWM_CYCLE_WITHIN_FULL_SINE);
+    PwmOuputController_UpdateFrequencyFine(freq);
+    PwmOuputController_Start();
+    while(_motorState != SM_MOTOR_STARTED) PendSV_Handler();
+
+    if(mode == PWM_MODE_TABLE) swept.frequency = (double)INTERRUPT_FREQ / (PWM_CYCLE_WITHIN_FULL_SINE * _activeTonTable->interruptsInPwmCycle);
+    else swept.frequency = (double)freq / FREQUENCY_FINE_SCALE;
+    length = (unsigned long long)floor((SINE_WAVES * INTERRUPT_FREQ / swept.frequency) + 0.5);
+
+    /* The first sine wave is left out, then the pulses until the whole sine waves are over */
+    while(skip < (INTERRUPT_FREQ / swept.frequency))
+    {
+        skip += _systick.next.interrupts;
+        PendSV_Handler();
+    }
+    for(k=0; k<=HARMONICS; k++) _re[k] = _im[k] = 0;
+    while(samples < length)
+    {
+        unsigned int interrupts = _systick.next.interrupts;
+        unsigned int ton = _systick.next.ton;
+        double sign = (_systick.next.pin == &GPIO_PORTB_DATA_BITS_R[0x01]) ? 1.0 : -1.0;
+
+        if((samples + ton) > length) ton = length - samples;
+        AddPulse(swept.frequency, samples, ton, sign);
+        if(interrupts < swept.least) swept.least = interrupts;
+        if(interrupts > swept.most) swept.most = interrupts;
+        samples += interrupts;
+        PendSV_Handler();
+    }
+
+    swept.fundamental = 2 * sqrt((_re[1] * _re[1]) + (_im[1] * _im[1])) / length;
+    swept.ratio = (unsigned int)floor(((double)INTERRUPT_FREQ / (swept.frequency * swept.least)) + 0.5);
+    for(k=2; k<=HARMONICS; k++)
+    {
+        harmonics += (_re[k] * _re[k]) + (_im[k] * _im[k]);
+        if((k * 2) < swept.ratio) baseband += (_re[k] * _re[k]) + (_im[k] * _im[k]);
+    }
+    swept.thd = 100.0 * (2 * sqrt(harmonics) / length) / swept.fundamental;
+    swept.baseband = 100.0 * (2 * sqrt(baseband) / length) / swept.fundamental;
+
+    PwmOuputController_Stop();
+    while(_motorState != SM_MOTOR_STOPPED) PendSV_Handler();
+
+    return swept;
+}
+
+/* Run at a frequency, then go to 0 Hz: the motor must stop through idle slots */
+static bool StopsAtZero(PwmMode mode)
+{
+    unsigned int slot;
+    bool idle = true;
+
+    PwmOuputController_Init(60);
+    PwmOuputController_SetMode(mode);
+    PwmOuputController_Start();
+    for(slot=0; slot<200; slot++) PendSV_Handler();
+    if(_motorState != SM_MOTOR_STARTED) return false;
+
+    /* The running sine wave is finished first, then only idle slots */
+    PwmOuputController_UpdateFrequencyFine(0);
+    for(slot=0; ( slot < 2000 ) && ( _motorState != SM_MOTOR_STOPPED ); slot++) PendSV_Handler();
+    for(slot=0; slot<200; slot++)
+    {
+        PendSV_Handler();
+        if(( _systick.next.ton != 0 ) || ( _systick.next.interrupts == 0 ) || ( _motorState != SM_MOTOR_STOPPED )) idle = false;
+    }
+    return idle;
+}
+
+int main(void)
+{
+    static const char *names[] = {"table", "NCO"};
+    Swept swept[2][FREQUENCIES];
+    bool full = true;
+    bool ncoLeast = true;
+    bool baseband = true;
+    bool lowHalved = true;
+    unsigned int mode;
+    unsigned int i;
+
+    HostTarget_Init();
+
+    printf("mode   requested   output   interrupts per pwm cycle  ton step  ratio  fundamental  THD (2-%d)  below the carrier\n", HARMONICS);
+    for(mode=0; mode<2; mode++)
+    {
+        for(i=0; i<FREQUENCIES; i++)
+        {
+            Swept *s = &swept[mode][i];
+
+            *s = Sweep((mode == 0) ? PWM_MODE_TABLE : PWM_MODE_NCO, _frequencies[i]);
+            printf("%-5s  %6.2f Hz  %7.2f Hz  %6u to %6u          %6.3f%%  %5u  %8.4f     %6.2f%%     %6.2f%%\n",
+                   names[mode], (double)_frequencies[i] / FREQUENCY_FINE_SCALE, s->frequency, s->least, s->most,
+                   100.0 / s->least, s->ratio, s->fundamental, s->thd, s->baseband);
+            if(fabs(s->fundamental - 1.0) > 0.02) full = false;
+            if(( _frequencies[i] <= DRIVE_UPPER ) && ( s->baseband > THD_MAX )) baseband = false;
+            if(( mode == 1 ) && ( s->least < NCO_LEAST_INTERRUPTS )) ncoLeast = false;
+            if(( mode == 1 ) && ( _frequencies[i] < LOW_FREQUENCIES ) && ( (s->baseband * 2) > swept[0][i].baseband )) lowHalved = false;
+        }
+    }
+
+    HostTarget_Check(( swept[0][0].least == 6480 ) && ( swept[0][0].most == 6480 ), "the table mode has 6480 interrupts per pwm cycle at 0.5 Hz");
+    HostTarget_Check(( swept[0][FREQUENCIES - 1].least == 8 ) && ( swept[0][FREQUENCIES - 1].most == 8 ), "the table mode has 8 interrupts per pwm cycle at 400 Hz");
+    HostTarget_Check(ncoLeast, "the NCO mode never has a pwm cycle shorter than its 7 kHz carrier, 33 interrupts");
+    HostTarget_Check(full, "both modes output the full sine wave at every frequency");
+    HostTarget_Check(baseband, "both modes keep the THD below the carrier under 3 % up to 90 Hz");
+    HostTarget_Check(lowHalved, "below 30 Hz the NCO mode has less than half the THD of the table mode");
+    HostTarget_Check(StopsAtZero(PWM_MODE_TABLE), "table mode: 0 Hz stops the motor through the idle slots");
+    HostTarget_Check(StopsAtZero(PWM_MODE_NCO), "NCO mode: 0 Hz stops the motor through the idle slots");
+
+    return HostTarget_Result("FrequencyRangeSweep");
+}
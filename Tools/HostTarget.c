@@ -0,0 +1,105 @@
+/*
+ * HostTarget.c
+ *
+ * The register regions of the TM4C123 mapped as memory on the host,
+ *  and the checks counted by the host programs.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "driverlib/interrupt.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+/* The regions of the memory map that hold registers */
+#define PERIPHERAL_BASE      0x40000000
+#define PERIPHERAL_SIZE      0x00100000
+#define CORE_PERIPHERAL_BASE 0xE0000000
+#define CORE_PERIPHERAL_SIZE 0x00100000
+
+static bool _masked = false;
+static unsigned long _checks = 0;
+static unsigned long _failures = 0;
+
+/* Map one region at its own address, there is no way to go on without it */
+static void MapRegion(unsigned long base, unsigned long size)
+{
+    void *region = mmap((void *)base, size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+    if(region != (void *)base)
+    {
+        fprintf(stderr, "HostTarget: can't map the registers at 0x%08lx\n", base);
+        exit(2);
+    }
+}
+
+/* ***************HostTarget_Init******************
+ * Map the register regions of the TM4C123 as zeroed memory
+ * Input: none
+ * Output: none
+ */
+void HostTarget_Init(void)
+{
+    if(sizeof(long) != 4)
+    {
+        fprintf(stderr, "HostTarget: build with -m32, the target long is 32 bits\n");
+        exit(2);
+    }
+    MapRegion(PERIPHERAL_BASE, PERIPHERAL_SIZE);
+    MapRegion(CORE_PERIPHERAL_BASE, CORE_PERIPHERAL_SIZE);
+}
+
+/* The driverlib calls used by the modules under check */
+bool IntMasterEnable(void)
+{
+    bool masked = _masked;
+    _masked = false;
+    return masked;
+}
+
+bool IntMasterDisable(void)
+{
+    bool masked = _masked;
+    _masked = true;
+    return masked;
+}
+
+/* ***************HostTarget_InterruptsMasked******************
+ * Evaluate if the code under check has masked the interrupts
+ * Input: none
+ * Output: bool - true between IntMasterDisable and IntMasterEnable
+ */
+bool HostTarget_InterruptsMasked(void)
+{
+    return _masked;
+}
+
+/* ***************HostTarget_Check******************
+ * Count one check, printing the message when it fails
+ * Input: ok - the result of the check
+ *        message - what was checked
+ * Output: none
+ */
+void HostTarget_Check(bool ok, const char *message)
+{
+    _checks++;
+    if(!ok)
+    {
+        _failures++;
+        if(_failures <= 20) printf("FAIL: %s\n", message);
+    }
+}
+
+/* ***************HostTarget_Result******************
+ * Print the summary of the checks
+ * Input: name - the name of the program
+ * Output: int - the exit status, 0 when every check passed
+ */
+int HostTarget_Result(const char *name)
+{
+    printf("%s: %lu checks, %lu failed\n", name, _checks, _failures);
+    return (_failures == 0) ? 0 : 1;
+}
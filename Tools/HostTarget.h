@@ -0,0 +1,53 @@
+/*
+ * HostTarget.h
+ *
+ * Lets the device drivers and the main modules run unchanged on a 32 bits
+ *  host, so their register accesses can be checked by the host programs of
+ *  this folder. The peripheral (0x40000000) and the core peripheral
+ *  (0xE0000000) regions are mapped as plain memory at their own addresses:
+ *  every register reads back the last value written, and the programs model
+ *  whatever the hardware would do between two accesses.
+ *
+ * The long of the target is 32 bits wide, so the programs must be built
+ *  with -m32. Every program has its build line at its header, run from the
+ *  repository root. The folder is excluded from the CCS build.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#ifndef TOOLS_HOSTTARGET_H_
+#define TOOLS_HOSTTARGET_H_
+
+#include <stdbool.h>
+
+/* ***************HostTarget_Init******************
+ * Map the register regions of the TM4C123 as zeroed memory
+ * Input: none
+ * Output: none
+ */
+void HostTarget_Init(void);
+
+/* ***************HostTarget_InterruptsMasked******************
+ * Evaluate if the code under check has masked the interrupts
+ * Input: none
+ * Output: bool - true between IntMasterDisable and IntMasterEnable
+ */
+bool HostTarget_InterruptsMasked(void);
+
+/* ***************HostTarget_Check******************
+ * Count one check, printing the message when it fails
+ * Input: ok - the result of the check
+ *        message - what was checked
+ * Output: none
+ */
+void HostTarget_Check(bool ok, const char *message);
+
+/* ***************HostTarget_Result******************
+ * Print the summary of the checks
+ * Input: name - the name of the program
+ * Output: int - the exit status, 0 when every check passed
+ */
+int HostTarget_Result(const char *name);
+
+#endif /* TOOLS_HOSTTARGET_H_ */
@@ -0,0 +1,244 @@
+/*
+ * PwmStreamModel.c
+ *
+ * Register model of the uDMA backend (PWM_BACKEND_UDMA): TIMER1A/B, the uDMA
+ *  channels 20/21 in ping-pong mode and the PWM0 generator 0 are modeled from
+ *  their registers while the real PwmOutputController.c, PWM.c, Timer1.c and
+ *  uDMA.c drive them, and the output of every pwm cycle is compared with the
+ *  order of UpdateIndex, HI/LOW swap at index 35 included.
+ *
+ * The generator takes LOAD and CMPA/B at its counter = 0, the timers take
+ *  their interval at the timeout and every timeout moves one item of the
+ *  current control structure of each channel, 20 before 21. The task runs
+ *  when the channel 21 finishes a structure. Each sine cycle must come from a
+ *  single ton table, with its own pwm cycle length, the counter = 0 must keep
+ *  the same lead on the timeout and no channel may reach a stopped structure.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -DPWM_OUTPUT_BACKEND=2 -I. -ITools -o Tools/pwm_stream_model.out Tools/PwmStreamModel.c Tools/HostTarget.c
+ *      Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/pwm_stream_model.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/PwmOutputController.h"
+#include "Source/DeviceDrivers/PWM.h"
+#include "tm4c123gh6pm.h"
+#include <stdio.h>
+
+#if PWM_OUTPUT_BACKEND != PWM_BACKEND_UDMA
+#error "Build the stream model with -DPWM_OUTPUT_BACKEND=2"
+#endif
+
+/* The clocks the counter = 0 leads the timeout, from the back to back restart */
+#define RESTART_LEAD 4
+/* The sine cycles modeled */
+#define SINE_CYCLES 12
+/* The uDMA channels of the HI and the LOW pins */
+#define CHANNEL_HI  20
+#define CHANNEL_LOW 21
+
+/* The internals of the controller used as the reference */
+extern unsigned int _interruptsInPwmCycle;
+extern unsigned int _tonIndex;
+extern PwmPin _pwmPin;
+extern const volatile TonTable * volatile _pendingTonTable;
+void UpdateIndex(void);
+void UpdateTonTable(volatile TonTable *table);
+void Timer1B_Handler(void);
+
+/* The output expected for one frequency: the HI time of both pins along one sine cycle */
+typedef struct
+{
+    unsigned long freq;
+    unsigned long period;
+    unsigned long hi[72];
+    unsigned long low[72];
+} Expected;
+
+/* The output of one pwm cycle */
+typedef struct
+{
+    unsigned long period;
+    unsigned long hi;
+    unsigned long low;
+} Cycle;
+
+static Expected _expected[8];
+static int _expectedCount = 0;
+static Cycle _cycles[(SINE_CYCLES + 2) * 72];
+static int _cycleCount = 0;
+static bool _alternate[32];
+
+/* The width of one ton as UpdateStreamedTables converts it */
+static unsigned long StreamedWidth(unsigned int ton, unsigned long period)
+{
+    unsigned long width = ton * PWM_CLOCKS_PER_INTERRUPT;
+    if(width >= period) width = period - 1;
+    return width;
+}
+
+/* Set a frequency and remember its output, along the order of UpdateIndex */
+static void SetFrequency(unsigned long freq)
+{
+    TonTable table;
+    Expected *expected = &_expected[_expectedCount++];
+    unsigned int index = _tonIndex;
+    PwmPin pin = _pwmPin;
+    const volatile TonTable *pending = _pendingTonTable;
+    int k;
+
+    PwmOuputController_UpdateFrequencyFine(freq);
+    UpdateTonTable(&table);
+    expected->freq = freq;
+    expected->period = _interruptsInPwmCycle * PWM_CLOCKS_PER_INTERRUPT;
+
+    /* UpdateIndex only swaps tables at index 35, none is pending meanwhile */
+    pending = _pendingTonTable;
+    _pendingTonTable = 0;
+    _tonIndex = 0;
+    _pwmPin = PWM_PIN_HI;
+    for(k=0; k<72; k++)
+    {
+        unsigned long width = StreamedWidth(table.tonTable[_tonIndex], expected->period);
+        expected->hi[k] = (_pwmPin == PWM_PIN_HI) ? width : 0;
+        expected->low[k] = (_pwmPin == PWM_PIN_LOW) ? width : 0;
+        UpdateIndex();
+    }
+    _tonIndex = index;
+    _pwmPin = pin;
+    _pendingTonTable = pending;
+}
+
+/* The HI time of a streamed comparator: HI from the comparator down to 0 */
+static unsigned long ComparatorWidth(unsigned long compare, unsigned long period)
+{
+    return (compare < period) ? (compare + 1) : 0;
+}
+
+/* Move one item of the current control structure of a channel, true when it finishes */
+static bool ServeChannel(unsigned long channel)
+{
+    unsigned long *entry = (unsigned long *)UDMA_CTLBASE_R + (channel * 4) + (_alternate[channel] ? 128 : 0);
+    unsigned long remaining = ((entry[2] & UDMA_CHCTL_XFERSIZE_M) >> UDMA_CHCTL_XFERSIZE_S) + 1;
+
+    if((entry[2] & UDMA_CHCTL_XFERMODE_M) == UDMA_CHCTL_XFERMODE_STOP)
+    {
+        HostTarget_Check(false, "a channel reached a structure that wasn't armed again");
+        return false;
+    }
+    *(volatile unsigned long *)entry[1] = *(unsigned long *)(entry[0] - ((remaining - 1) * 4));
+    remaining--;
+    if(remaining == 0)
+    {
+        entry[2] &= ~(UDMA_CHCTL_XFERSIZE_M | UDMA_CHCTL_XFERMODE_M);
+        _alternate[channel] = !_alternate[channel];
+    }
+    else
+    {
+        entry[2] = (entry[2] & ~UDMA_CHCTL_XFERSIZE_M) | ((remaining - 1) << UDMA_CHCTL_XFERSIZE_S);
+    }
+    UDMA_ALTSET_R = (_alternate[CHANNEL_HI] ? (1 << CHANNEL_HI) : 0) | (_alternate[CHANNEL_LOW] ? (1 << CHANNEL_LOW) : 0);
+    return (remaining == 0);
+}
+
+/* The main loop between two pwm cycles: frequency changes, two of them back to back */
+static void MainContext(int cycle)
+{
+    if(cycle == (2 * 72) + 10) SetFrequency(4500);
+    if(cycle == (4 * 72) + 50) { SetFrequency(5000); SetFrequency(3750); }
+    if(cycle == (7 * 72) + 71) SetFrequency(9000);
+    if(cycle == (9 * 72) + 3)  SetFrequency(3000);
+}
+
+/* Find the frequency whose output is the sine cycle starting at a pwm cycle */
+static int MatchSineCycle(int first)
+{
+    int e, k;
+    for(e=0; e<_expectedCount; e++)
+    {
+        bool same = true;
+        for(k=0; (k<72) && same; k++)
+        {
+            same = (_cycles[first + k].hi == _expected[e].hi[k]) && (_cycles[first + k].low == _expected[e].low[k]);
+            /* The last pwm cycle may already have the length of the next sine cycle */
+            if(k < 71) same = same && (_cycles[first + k].period == _expected[e].period);
+        }
+        if(same) return e;
+    }
+    return -1;
+}
+
+int main(void)
+{
+    unsigned long zero = 0;
+    unsigned long timeout;
+    unsigned long interval;
+    int cycle, first, e, last = -1;
+    char message[128];
+
+    HostTarget_Init();
+    PwmOuputController_Init(0);
+    SetFrequency(6000);
+    PwmOuputController_Start();
+    HostTarget_Check(Control_GetMotorState() == SM_MOTOR_STARTED, "the streaming starts");
+    HostTarget_Check(!HostTarget_InterruptsMasked(), "the interrupts are unmasked after the start");
+
+    /* The generator restarts at the clock 0, the timers RESTART_LEAD clocks later from their interval */
+    _alternate[CHANNEL_HI] = false;
+    _alternate[CHANNEL_LOW] = false;
+    UDMA_ALTSET_R = 0;
+    timeout = RESTART_LEAD + TIMER1_TAILR_R + 1;
+
+    for(cycle=0; cycle<(SINE_CYCLES * 72) + 2; cycle++)
+    {
+        /* The counter = 0 takes the period and both comparators */
+        unsigned long period = PWM0_0_LOAD_R + 1;
+        _cycles[cycle].period = period;
+        _cycles[cycle].hi = ComparatorWidth(PWM0_0_CMPA_R, period);
+        _cycles[cycle].low = ComparatorWidth(PWM0_0_CMPB_R, period);
+
+        /* The first timeout comes one period after the restart */
+        if(cycle > 0)
+        {
+            HostTarget_Check(timeout == zero + RESTART_LEAD, "the counter = 0 keeps its lead on the timeout");
+            interval = TIMER1_TAILR_R + 1;
+            HostTarget_Check(TIMER1_TBILR_R == TIMER1_TAILR_R, "both timers have the same interval");
+            ServeChannel(CHANNEL_HI);
+            if(ServeChannel(CHANNEL_LOW)) Timer1B_Handler();
+            timeout += interval;
+        }
+        zero += period;
+        MainContext(cycle);
+    }
+    _cycleCount = cycle;
+
+    /* The first value is moved at the first timeout and output from the next counter = 0 */
+    for(first=2; first + 72 <= _cycleCount; first += 72)
+    {
+        e = MatchSineCycle(first);
+        sprintf(message, "the sine cycle from the pwm cycle %d comes from a single ton table", first);
+        HostTarget_Check(e >= 0, message);
+        if(e < 0) continue;
+        sprintf(message, "the sine cycle from the pwm cycle %d isn't an older frequency", first);
+        HostTarget_Check(e >= last, message);
+        last = e;
+        /* The last pwm cycle is OFF on both pins, whatever its length */
+        HostTarget_Check((_cycles[first + 71].hi == 0) && (_cycles[first + 71].low == 0), "the last pwm cycle is OFF");
+        printf("pwm cycles %4d-%4d: %5lu.%02lu Hz, %5lu clocks\n", first, first + 71,
+               _expected[e].freq / 100, _expected[e].freq % 100, _expected[e].period);
+    }
+    HostTarget_Check(last == _expectedCount - 1, "the last frequency is output");
+
+    PwmOuputController_Stop();
+    HostTarget_Check(Control_GetMotorState() == SM_MOTOR_STOPPED, "the streaming stops");
+    HostTarget_Check((PWM0_0_CMPA_R == PWM_STREAM_OFF) && (PWM0_0_CMPB_R == PWM_STREAM_OFF), "both pins are LOW after the stop");
+
+    return HostTarget_Result("PwmStreamModel");
+}
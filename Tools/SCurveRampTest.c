@@ -0,0 +1,249 @@
+/*
+ * SCurveRampTest.c
+ *
+ * Runs the frequency ramp on the host, its TIMER2 tick called directly, and
+ *  records the frequency output at every tick, from before the command until
+ *  after the ramp ends.
+ *
+ * The ramp rate is the slope of the frequency (the acceleration of the motor)
+ *  and the jerk limits the change of that slope, so with the S-curve profile
+ *  the slope must be continuous: zero at both ends, never above the rate, and
+ *  changing by at most the jerk. The frequency is output in whole fine units,
+ *  so both are checked over windows of W ticks, where the truncation adds at
+ *  most 2 fine units:
+ *      slope   (f[k + W] - f[k]) / W                  <= rate + 2 / W
+ *      change  |f[k + W] - 2 * f[k] + f[k - W]|       <= jerk * W^2 + 2
+ *  and the slope of the first and the last window, at the ends of the ramp,
+ *  is within the one the jerk reaches from zero, jerk * W / 2. The ramp takes
+ *  the target as soon as the truncated frequency reaches it, up to
+ *  sqrt(2 / jerk) ticks before the end of the S-curve, which adds
+ *  sqrt(2 * jerk) to the slope of the last window.
+ * Checked too: the ramp ends exactly on the target, never goes back, and
+ *  lasts the time of the ideal S-curve within 3 ticks, rounded to whole ticks
+ *  and truncated at its end. Moves retargeted in the middle, while the
+ *  acceleration rises, at the rate or towards a target left behind, keep the
+ *  same slope and jerk checks across the new command and end on the new
+ *  target; only the one left behind goes back, once. The same checks on the linear profile are shown
+ *  to catch its slope jumps. Within narrowed bounds the ramp only holds
+ *  frequencies the pwm output really outputs: a target above the upper bound
+ *  ends on it, and a ramp down to the idle goes to 0 from the lower bound.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/s_curve_ramp_test.out Tools/SCurveRampTest.c Tools/HostTarget.c -lm
+ *      Source/Main/FrequencyRamp.c Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/s_curve_ramp_test.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/FrequencyRamp.h"
+#include "Source/Main/PwmOutputController.h"
+#include <math.h>
+#include <stdio.h>
+
+/* The window of the slope checks {ticks} and the ticks recorded around the ramp */
+#define WINDOW 10
+#define MAX_TICKS 4096
+
+/* The internals of the ramp under check, and the frequency the pwm output took */
+void RampTick(void);
+extern unsigned long _fineFrequency;
+
+/* One ramp command, and the one that may replace it in the middle */
+typedef struct
+{
+    unsigned long from;         // {1/FREQUENCY_FINE_SCALE Hz}
+    unsigned long to;           // {1/FREQUENCY_FINE_SCALE Hz}
+    unsigned int rate;          // {Hz/s}
+    unsigned int jerk;          // {Hz/s^2}
+    unsigned long retargetTick; // the tick of the new command, 0 for none
+    unsigned long retarget;     // the new target {1/FREQUENCY_FINE_SCALE Hz}
+} Move;
+
+/* What the checks of one ramp found */
+typedef struct
+{
+    unsigned long ticks;        // the ticks the ramp lasted
+    double idealTicks;          // the ticks of the ideal S-curve
+    double slope;               // the highest slope {1/FREQUENCY_FINE_SCALE Hz per tick}
+    double change;              // the highest change of the slope over a window {1/FREQUENCY_FINE_SCALE Hz}
+    double endSlope;            // the highest slope of the first and the last window
+    bool reached;               // if it ended exactly on the target
+    unsigned int reversals;     // the times the frequency turned back
+} Checked;
+
+static unsigned long _record[MAX_TICKS];
+
+/* Run one ramp, WINDOW ticks of the start frequency before it and after its end */
+static Checked Run(const Move *move, RampProfile profile)
+{
+    /* The rate {fine units per tick} and the jerk {fine units per tick^2} */
+    double rate = (double)move->rate * FREQUENCY_FINE_SCALE / RAMP_TICK_FREQ;
+    double jerk = (double)move->jerk * FREQUENCY_FINE_SCALE / ((double)RAMP_TICK_FREQ * RAMP_TICK_FREQ);
+    double distance = (move->to > move->from) ? (double)(move->to - move->from) : (double)(move->from - move->to);
+    unsigned long to = (move->retargetTick != 0) ? move->retarget : move->to;
+    unsigned long count = 0;
+    unsigned long tick;
+    int direction = 0;
+    Checked checked;
+
+    FrequencyRamp_Init(move->from);
+    FrequencyRamp_SetRates(move->rate, move->rate);
+    FrequencyRamp_SetProfile(profile, move->jerk);
+    for(tick=0; tick<WINDOW; tick++) _record[count++] = FrequencyRamp_GetFrequency();
+    FrequencyRamp_MoveTo(move->to);
+    while(FrequencyRamp_IsRunning() && ( count < (MAX_TICKS - WINDOW) ))
+    {
+        if(( move->retargetTick != 0 ) && ( count == (WINDOW + move->retargetTick) )) FrequencyRamp_MoveTo(move->retarget);
+        RampTick();
+        _record[count++] = FrequencyRamp_GetFrequency();
+    }
+    checked.ticks = count - WINDOW;
+    for(tick=0; tick<WINDOW; tick++)
+    {
+        RampTick();
+        _record[count++] = FrequencyRamp_GetFrequency();
+    }
+
+    /* The ideal S-curve: the rate reached in rate / jerk, or a triangle of 2 * sqrt(D / jerk) */
+    if(distance >= ((rate * rate) / jerk)) checked.idealTicks = (distance / rate) + (rate / jerk);
+    else checked.idealTicks = 2 * sqrt(distance / jerk);
+
+    checked.reached = ( _record[count - 1] == to ) && ( _record[count - WINDOW - 1] == to );
+    checked.reversals = 0;
+    checked.slope = 0;
+    checked.change = 0;
+    for(tick=1; tick<count; tick++)
+    {
+        int step = (_record[tick] > _record[tick - 1]) ? 1 : ((_record[tick] < _record[tick - 1]) ? -1 : 0);
+        if(( step != 0 ) && ( direction != 0 ) && ( step != direction )) checked.reversals++;
+        if(step != 0) direction = step;
+    }
+    for(tick=0; (tick + WINDOW)<count; tick++)
+    {
+        double slope = fabs((double)_record[tick + WINDOW] - (double)_record[tick]) / WINDOW;
+        if(slope > checked.slope) checked.slope = slope;
+        if(tick >= WINDOW)
+        {
+            double change = fabs((double)_record[tick + WINDOW] - (2.0 * _record[tick]) + (double)_record[tick - WINDOW]);
+            if(change > checked.change) checked.change = change;
+        }
+    }
+    /* From the last frequency before the command, and up to the last one of the ramp */
+    checked.endSlope = fabs((double)_record[(2 * WINDOW) - 1] - (double)_record[WINDOW - 1]) / WINDOW;
+    if((fabs((double)_record[count - WINDOW - 1] - (double)_record[count - (2 * WINDOW) - 1]) / WINDOW) > checked.endSlope)
+    {
+        checked.endSlope = fabs((double)_record[count - WINDOW - 1] - (double)_record[count - (2 * WINDOW) - 1]) / WINDOW;
+    }
+
+    printf("%-6s %5.2f -> %5.2f Hz at %2u Hz/s, %3u Hz/s^2: %4lu ticks (ideal %7.2f), slope %6.2f (end %5.2f), change %6.2f\n",
+           (profile == RAMP_PROFILE_SCURVE) ? "scurve" : "linear", move->from / (double)FREQUENCY_FINE_SCALE,
+           move->to / (double)FREQUENCY_FINE_SCALE, move->rate, move->jerk, checked.ticks, checked.idealTicks,
+           checked.slope, checked.endSlope, checked.change);
+    if(move->retargetTick != 0)
+    {
+        printf("       retargeted to %5.2f Hz at tick %lu, ends at %5.2f Hz, %u reversals\n", move->retarget / (double)FREQUENCY_FINE_SCALE,
+               move->retargetTick, _record[count - 1] / (double)FREQUENCY_FINE_SCALE, checked.reversals);
+    }
+
+    return checked;
+}
+
+/* Ramp a linear move within the bounds, returns if every frequency held was the one output */
+static bool RunBounded(unsigned long from, unsigned long to, unsigned long *last, unsigned long *ticks)
+{
+    bool output = true;
+
+    FrequencyRamp_Init(from);
+    FrequencyRamp_SetRates(20, 20);
+    FrequencyRamp_SetProfile(RAMP_PROFILE_LINEAR, 0);
+    FrequencyRamp_MoveTo(to);
+    for(*ticks=0; FrequencyRamp_IsRunning() && ( *ticks < MAX_TICKS ); (*ticks)++)
+    {
+        RampTick();
+        if(FrequencyRamp_GetFrequency() != _fineFrequency) output = false;
+    }
+    *last = FrequencyRamp_GetFrequency();
+    return output;
+}
+
+int main(void)
+{
+    static const Move moves[] = {
+        /* up and down reaching the rate, too short to reach it, and a steep jerk */
+        {3000, 6000, 20,  40,   0,    0},
+        {6000, 3000, 20,  40,   0,    0},
+        {3000, 3100, 20,  40,   0,    0},
+        {9000, 8950, 10, 100,   0,    0},
+        {3000, 9000, 30, 600,   0,    0},
+        /* retargeted while the acceleration rises, at the rate further and back behind */
+        {3000, 6000, 20,  40,  30, 3600},
+        {3000, 6000, 20,  40, 100, 8000},
+        {3000, 6000, 20,  40, 100, 3500},
+        {6000, 3000, 20,  40,  80, 5500}
+    };
+    char message[120];
+    Checked checked;
+    unsigned int i;
+
+    HostTarget_Init();
+    PwmOuputController_Init(30);
+
+    for(i=0; i<(sizeof(moves) / sizeof(moves[0])); i++)
+    {
+        const Move *move = &moves[i];
+        double rate = (double)move->rate * FREQUENCY_FINE_SCALE / RAMP_TICK_FREQ;
+        double jerk = (double)move->jerk * FREQUENCY_FINE_SCALE / ((double)RAMP_TICK_FREQ * RAMP_TICK_FREQ);
+
+        unsigned long to = (move->retargetTick != 0) ? move->retarget : move->to;
+        bool behind;
+
+        /* A target left behind is on the other side of the frequency at the new command */
+        checked = Run(move, RAMP_PROFILE_SCURVE);
+        behind = (move->retargetTick != 0) && (( move->to > move->from ) != ( move->retarget > _record[WINDOW + move->retargetTick - 1] ));
+        sprintf(message, "%lu -> %lu: the ramp ends exactly on the target", move->from, to);
+        HostTarget_Check(checked.reached, message);
+        sprintf(message, "%lu -> %lu: the frequency only goes back for a target left behind", move->from, to);
+        HostTarget_Check(checked.reversals == (behind ? 1 : 0), message);
+        sprintf(message, "%lu -> %lu: the slope stays within the rate", move->from, to);
+        HostTarget_Check(checked.slope <= (rate + (2.0 / WINDOW)), message);
+        sprintf(message, "%lu -> %lu: the slope changes within the jerk", move->from, to);
+        HostTarget_Check(checked.change <= ((jerk * WINDOW * WINDOW) + 2), message);
+        sprintf(message, "%lu -> %lu: the slope starts and ends from zero", move->from, to);
+        HostTarget_Check(checked.endSlope <= ((jerk * WINDOW / 2) + sqrt(2 * jerk) + (2.0 / WINDOW)), message);
+        if(move->retargetTick == 0)
+        {
+            sprintf(message, "%lu -> %lu: the ramp lasts the ideal S-curve within 3 ticks", move->from, to);
+            HostTarget_Check(fabs(checked.ticks - checked.idealTicks) <= 3, message);
+        }
+    }
+
+    /* The linear profile jumps to the whole rate, the same checks catch it */
+    checked = Run(&moves[0], RAMP_PROFILE_LINEAR);
+    HostTarget_Check(checked.change > ((moves[0].jerk * FREQUENCY_FINE_SCALE * WINDOW * WINDOW) / ((double)RAMP_TICK_FREQ * RAMP_TICK_FREQ)) + 2,
+                     "the check catches the slope jump of the linear profile");
+
+    /* The bounds of the drive, 20 to 50 Hz */
+    {
+        unsigned long last, ticks;
+        bool output;
+
+        PwmOuputController_SetFrequencyBounds(2000, 5000);
+        output = RunBounded(3000, 8000, &last, &ticks);
+        printf("bounded 30.00 -> 80.00 Hz: ends at %.2f Hz after %lu ticks\n", last / (double)FREQUENCY_FINE_SCALE, ticks);
+        HostTarget_Check(output, "a target above the upper bound: every frequency held is the one output");
+        HostTarget_Check(( last == 5000 ) && ( ticks == 100 ), "a target above the upper bound ends on it");
+        output = RunBounded(3000, 0, &last, &ticks);
+        printf("bounded 30.00 ->  0.00 Hz: ends at %.2f Hz after %lu ticks\n", last / (double)FREQUENCY_FINE_SCALE, ticks);
+        HostTarget_Check(output, "a ramp to the idle: every frequency held is the one output");
+        HostTarget_Check(( last == 0 ) && ( ticks == 51 ), "a ramp to the idle goes to 0 from the lower bound");
+        PwmOuputController_SetFrequencyBounds(FREQUENCY_RANGE_LOWER, FREQUENCY_RANGE_UPPER);
+    }
+
+    return HostTarget_Result("SCurveRampTest");
+}
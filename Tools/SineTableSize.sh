@@ -0,0 +1,47 @@
+#!/bin/sh
+#
+# SineTableSize.sh
+#
+# Reports the flash taken by the sine table in every object that holds one,
+#  before and after the shared quarter-wave table. The objects are built for
+#  the host without optimization, as the CCS Debug configuration does; a double
+#  and an unsigned short have the same size on the host and on the Cortex-M4F.
+#
+# Run from the repository root:
+#  sh Tools/SineTableSize.sh [the revision before the shared table]
+#
+#  Created on: Oct 17, 2026
+#      Author: GMAGRI
+#
+
+BEFORE=${1:-5f5dd5e}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+# The units that included the table with PwmOutputController.h
+UNITS="DisplayManager PwmOutputController VariableFrequencyManager"
+
+# Sum the sizes of the given symbols over the objects of the given units
+TableBytes() {
+    total=0
+    for unit in $3; do
+        gcc -m32 -O0 -ffreestanding -c -I"$1" -I"$1/Source/DeviceDrivers" -ITools $4 \
+            -o "$WORK/$unit.o" "$1/Source/Main/$unit.c" || exit 1
+        size=$(nm -S -t d "$WORK/$unit.o" | awk -v symbol="$2" '$4 == symbol { print $2 + 0 }')
+        if [ -n "$size" ]; then
+            echo "    $unit.o $2 $size B"
+            total=$((total + size))
+        fi
+    done
+    echo "    total $total B"
+}
+
+mkdir "$WORK/before"
+git archive "$BEFORE" Source tm4c123gh6pm.h | tar -x -C "$WORK/before"
+echo "before ($BEFORE):"
+TableBytes "$WORK/before" _SinOutTable "$UNITS"
+
+for points in 36 72 144 256; do
+    echo "after, SINE_TABLE_POINTS $points:"
+    TableBytes . _quarterSine "SineTable $UNITS" -DSINE_TABLE_POINTS=$points
+done
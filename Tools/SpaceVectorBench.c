@@ -0,0 +1,207 @@
+/*
+ * SpaceVectorBench.c
+ *
+ * Runs the three-phase backend on the host with the sine and with the space
+ *  vector modulation, its PWM0 generator 0 task once per pwm cycle, and takes
+ *  the pole voltages of the three legs from the LOAD and CMPA registers the
+ *  task leaves, averaged over each pwm cycle {bus voltage}. The line-to-line
+ *  voltages U-V, V-W and W-U are analyzed over whole sine waves: their
+ *  fundamental, and the THD of the harmonics 2 to 40, below the carrier at
+ *  the default ratio of 72 pwm cycles per sine wave. The pulses themselves and
+ *  the dead time are left out, ThreePhaseWaveform.c checks them.
+ *
+ * Both modulations run at the full modulation index, where the space vector
+ *  reaches the whole DC bus in the line voltage and the sine sqrt(3)/2 of it,
+ *  and the space vector again at the index of the same line voltage of the
+ *  sine, to compare their THD at the same fundamental.
+ *
+ * The cost is the loading of one pwm cycle, LoadThreePhaseCycle, timed on the
+ *  host in TSC cycles per carrier period. The space vector reads the sine
+ *  table twice against the three legs of the sine, each scaled by the index,
+ *  and comes out about a quarter cheaper. On the target the profiling build,
+ *  PWM_ISR_PROFILING, measures the whole task in the CPU load.
+ *
+ * Checked: the space vector line voltage is 2/sqrt(3) times the sine one at
+ *  the full modulation index, and the same at its reduced index; the three
+ *  line voltages have the same fundamental; the THD of both modulations is
+ *  under 1 % and the space vector one is not above the sine one by more than
+ *  0.1 %, both about 0.03 %, the rounding of the sine table and the widths.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -DPWM_OUTPUT_BACKEND=3 -I. -ITools -o Tools/space_vector_bench.out Tools/SpaceVectorBench.c
+ *      Tools/HostTarget.c -lm Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/space_vector_bench.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/PwmOutputController.h"
+#include "tm4c123gh6pm.h"
+#include <math.h>
+#include <stdio.h>
+
+#if PWM_OUTPUT_BACKEND != PWM_BACKEND_THREE_PHASE
+#error "Build with -DPWM_OUTPUT_BACKEND=3"
+#endif
+
+/* The sine waves analyzed of each run, and the highest harmonic in the THD */
+#define SINE_WAVES 20
+#define HIGHEST_HARMONIC 40
+/* More pwm cycles than the sine waves analyzed can take */
+#define MAX_CYCLES 65536
+/* The pwm cycles loaded in each timing */
+#define BENCH_CYCLES 200000
+/* The base frequency of the space vector at the line voltage of the sine: the frequency over sqrt(3)/2 {Hz} */
+#define SAME_VOLTAGE_BASE(freq) ((unsigned short)(((freq) * 2 / sqrt(3)) + 0.5))
+
+/* The internals of the controller under check */
+void ThreePhaseCycleTask(void);
+void LoadThreePhaseCycle(void);
+
+/* What one run found */
+typedef struct
+{
+    double fundamental[3];      // the fundamental of the line voltages U-V, V-W and W-U {bus voltage}
+    double thd;                 // the THD of the line voltage U-V {%}
+    double cycles;              // the host TSC cycles of LoadThreePhaseCycle per pwm cycle
+    unsigned long pwmCycles;    // the pwm cycles within the sine waves analyzed
+} Analyzed;
+
+/* The pwm cycles output: their start and the pole voltages of the legs {clocks, bus voltage} */
+static double _cycleStart[MAX_CYCLES + 1];
+static double _poles[MAX_CYCLES][3];
+static unsigned long _cycles;
+
+static unsigned long long ReadTsc(void)
+{
+    return __builtin_ia32_rdtsc();
+}
+
+/* The amplitude of one harmonic of a line voltage (0 to 2, U-V, V-W and W-U) over the clocks
+ *  0..window, the voltage is constant within each pwm cycle so the integral is exact */
+static double Harmonic(int line, unsigned int harmonic, double window)
+{
+    double omega = 2 * M_PI * harmonic * SINE_WAVES / window;
+    double re = 0;
+    double im = 0;
+    unsigned long cycle;
+
+    for(cycle=0; cycle<_cycles; cycle++)
+    {
+        double t0 = _cycleStart[cycle];
+        double t1 = _cycleStart[cycle + 1];
+        double v = _poles[cycle][line] - _poles[cycle][(line + 1) % 3];
+        if(t1 > window) t1 = window;
+        if(t1 <= t0) break;
+        re += v * (sin(omega * t1) - sin(omega * t0)) / omega;
+        im += v * (cos(omega * t1) - cos(omega * t0)) / omega;
+    }
+    return 2 * sqrt((re * re) + (im * im)) / window;
+}
+
+/* Output SINE_WAVES sine waves of one modulation at a frequency and analyze the line voltages,
+ *  then time the loading of the pwm cycles */
+static Analyzed Run(PwmModulation modulation, unsigned short freq, unsigned short baseFrequency)
+{
+    volatile unsigned long *cmps[3] = {&PWM0_0_CMPA_R, &PWM0_1_CMPA_R, &PWM0_2_CMPA_R};
+    double window = (double)SYSTEM_CLOCK_FREQ * SINE_WAVES / freq;
+    double clock = 0;
+    double squares = 0;
+    unsigned long long start;
+    unsigned long load;
+    unsigned int harmonic;
+    unsigned long i;
+    int leg;
+    Analyzed analyzed;
+
+    PwmOuputController_Init(freq);
+    PwmOuputController_SetModulation(modulation);
+    PwmOuputController_SetVfCurve((baseFrequency == 0) ? VF_CURVE_NONE : VF_CURVE_LINEAR, baseFrequency, 0);
+    PwmOuputController_Start();
+
+    /* The counter = 0 interrupt that starts the motor, it loads the first pwm cycle */
+    ThreePhaseCycleTask();
+    _cycles = 0;
+    while(( clock < window ) && ( _cycles < MAX_CYCLES ))
+    {
+        load = PWM0_0_LOAD_R;
+        PWM0_CTL_R = 0;
+        _cycleStart[_cycles] = clock;
+        for(leg=0; leg<3; leg++) _poles[_cycles][leg] = ((double)*cmps[leg] / load) - 0.5;
+        clock += 2.0 * load;
+        _cycles++;
+        _cycleStart[_cycles] = clock;
+        ThreePhaseCycleTask();
+    }
+
+    for(leg=0; leg<3; leg++) analyzed.fundamental[leg] = Harmonic(leg, 1, window);
+    for(harmonic=2; harmonic<=HIGHEST_HARMONIC; harmonic++)
+    {
+        double amplitude = Harmonic(0, harmonic, window);
+        squares += amplitude * amplitude;
+    }
+    analyzed.thd = 100.0 * sqrt(squares) / analyzed.fundamental[0];
+    analyzed.pwmCycles = _cycles;
+
+    start = ReadTsc();
+    for(i=0; i<BENCH_CYCLES; i++) LoadThreePhaseCycle();
+    analyzed.cycles = (double)(ReadTsc() - start) / BENCH_CYCLES;
+
+    PwmOuputController_Stop();
+    while(Control_GetMotorState() != SM_MOTOR_STOPPED) ThreePhaseCycleTask();
+
+    return analyzed;
+}
+
+static void Print(const char *name, unsigned short freq, const Analyzed *analyzed)
+{
+    printf("%-15s %2u Hz: carrier %4lu Hz, line fundamental %.4f %.4f %.4f of the bus, THD %.3f%%, %5.1f host cycles per pwm cycle\n",
+           name, freq, analyzed->pwmCycles * freq / SINE_WAVES, analyzed->fundamental[0], analyzed->fundamental[1], analyzed->fundamental[2],
+           analyzed->thd, analyzed->cycles);
+}
+
+int main(void)
+{
+    static const unsigned short freqs[] = {30, 60, 90};
+    char message[120];
+    unsigned int i;
+    int line;
+
+    HostTarget_Init();
+
+    for(i=0; i<(sizeof(freqs) / sizeof(freqs[0])); i++)
+    {
+        Analyzed sine = Run(PWM_MODULATION_SPWM, freqs[i], 0);
+        Analyzed space = Run(PWM_MODULATION_SVPWM, freqs[i], 0);
+        Analyzed same = Run(PWM_MODULATION_SVPWM, freqs[i], SAME_VOLTAGE_BASE(freqs[i]));
+        double sameIndex = (double)freqs[i] / SAME_VOLTAGE_BASE(freqs[i]);
+
+        Print("SPWM", freqs[i], &sine);
+        Print("SVPWM", freqs[i], &space);
+        Print("SVPWM reduced", freqs[i], &same);
+        printf("%2u Hz: SVPWM/SPWM line voltage %.4f, the space vector costs %+.1f host cycles per pwm cycle\n",
+               freqs[i], space.fundamental[0] / sine.fundamental[0], space.cycles - sine.cycles);
+
+        sprintf(message, "%u Hz: the space vector line voltage is 2/sqrt(3) times the sine one", freqs[i]);
+        HostTarget_Check(fabs((space.fundamental[0] / sine.fundamental[0]) - (2 / sqrt(3))) < 0.005, message);
+        sprintf(message, "%u Hz: at its reduced index the space vector has the line voltage of the sine", freqs[i]);
+        HostTarget_Check(fabs((same.fundamental[0] / sine.fundamental[0]) - (sameIndex * 2 / sqrt(3))) < 0.005, message);
+        for(line=1; line<3; line++)
+        {
+            sprintf(message, "%u Hz: the three line voltages have the same fundamental", freqs[i]);
+            HostTarget_Check(( fabs(sine.fundamental[line] - sine.fundamental[0]) < (1e-3 * sine.fundamental[0]) ) &&
+                             ( fabs(space.fundamental[line] - space.fundamental[0]) < (1e-3 * space.fundamental[0]) ), message);
+        }
+        sprintf(message, "%u Hz: the THD of both modulations is under 1 %%", freqs[i]);
+        HostTarget_Check(( sine.thd < 1.0 ) && ( space.thd < 1.0 ) && ( same.thd < 1.0 ), message);
+        sprintf(message, "%u Hz: the space vector THD is not above the sine one by more than 0.1 %%", freqs[i]);
+        HostTarget_Check(( space.thd < (sine.thd + 0.1) ) && ( same.thd < (sine.thd + 0.1) ), message);
+    }
+
+    return HostTarget_Result("SpaceVectorBench");
+}
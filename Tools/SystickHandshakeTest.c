@@ -0,0 +1,182 @@
+/*
+ * SystickHandshakeTest.c
+ *
+ * Runs the table mode of the Systick backend on the host with the Systick
+ *  Interrupt raised by an interval timer signal, preempting the PendSV that
+ *  the main context runs whenever it is pended, as the lowest priority one.
+ *  Each signal runs the Systick Interrupt up to the end of the current slot.
+ *
+ * Checked: every slot the Systick Interrupt takes is a whole slot the PendSV
+ *  finished, in the order they were calculated, none skipped nor taken twice;
+ *  the PendSV being preempted in the middle of the next slot makes a late
+ *  LOW slot instead. The same run is repeated taking the next slot without
+ *  the handshake, as the Systick Interrupt formerly did, so the check is shown
+ *  to catch the slots taken twice or torn.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/systick_handshake_test.out Tools/SystickHandshakeTest.c Tools/HostTarget.c
+ *      Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/systick_handshake_test.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/PwmOutputController.h"
+#include "tm4c123gh6pm.h"
+#include <signal.h>
+#include <stdio.h>
+#include <sys/time.h>
+
+#if PWM_OUTPUT_BACKEND != PWM_BACKEND_SYSTICK
+#error "The test runs the Systick backend"
+#endif
+
+/* The slots taken by each run, and the period of the interval timer {us} */
+#define SLOTS 100000
+#define PREEMPTION_PERIOD 20
+
+/* The internals of the controller under check */
+extern MotorState _motorState;
+extern SystickState _systick;
+extern unsigned long _lateSlots;
+void SysTick_Handler(void);
+void PendSV_Handler(void);
+
+/* A Systick slot */
+typedef struct
+{
+    bool low;               // the pin, PB1 instead of PB0
+    unsigned int ton;
+    unsigned int interrupts;
+} Slot;
+
+/* The slots the PendSV calculated and the ones the Systick Interrupt took, in order */
+static Slot _calculated[SLOTS + 1];
+static Slot _taken[SLOTS];
+static volatile unsigned long _calculatedCount = 0;
+static volatile unsigned long _takenCount = 0;
+static volatile bool _handshake = true;
+static volatile bool _inPendSV = false;
+static unsigned long _preemptionsInPendSV = 0;
+
+/* The Systick Interrupt up to the end of the current slot, preempting the main context */
+static void SimulatedInterrupt(int signal)
+{
+    unsigned long late;
+
+    (void)signal;
+    if(_takenCount >= SLOTS) return;
+    if(_inPendSV) _preemptionsInPendSV++;
+    do
+    {
+        late = _lateSlots;
+        /* The former Systick Interrupt took the next slot whatever the PendSV was doing */
+        if(!_handshake) _systick.nextReady = true;
+        SysTick_Handler();
+    } while(_systick.counter != 1);
+
+    if(_lateSlots == late)
+    {
+        _taken[_takenCount].low = _systick.cycle.pin != &GPIO_PORTB_DATA_BITS_R[0x01];
+        _taken[_takenCount].ton = _systick.cycle.ton;
+        _taken[_takenCount].interrupts = _systick.cycle.interrupts;
+        _takenCount++;
+    }
+}
+
+/* Start or stop the interval timer that raises the simulated interrupt */
+static void SetPreemption(bool enable)
+{
+    struct itimerval timer;
+
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = enable ? PREEMPTION_PERIOD : 0;
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_REAL, &timer, 0);
+}
+
+/* Record the next slot the PendSV left */
+static void RecordCalculated(void)
+{
+    _calculated[_calculatedCount].low = _systick.next.pin != &GPIO_PORTB_DATA_BITS_R[0x01];
+    _calculated[_calculatedCount].ton = _systick.next.ton;
+    _calculated[_calculatedCount].interrupts = _systick.next.interrupts;
+    _calculatedCount++;
+}
+
+/* Run the motor until SLOTS slots are taken, and count the ones that are not the calculated ones in order */
+static unsigned long Run(bool handshake)
+{
+    unsigned long wrong = 0;
+    unsigned long slot;
+
+    PwmOuputController_Init(60);
+    _handshake = handshake;
+    _calculatedCount = 0;
+    _takenCount = 0;
+    _lateSlots = 0;
+    _preemptionsInPendSV = 0;
+    /* The first idle slot, being output, and the one after it, both loaded by the initialization */
+    _calculated[0].low = false;
+    _calculated[0].ton = _systick.cycle.ton;
+    _calculated[0].interrupts = _systick.cycle.interrupts;
+    _calculatedCount = 1;
+    RecordCalculated();
+    PwmOuputController_Start();
+
+    SetPreemption(true);
+    while(( _takenCount < SLOTS ) && ( _calculatedCount < SLOTS ))
+    {
+        if(NVIC_INT_CTRL_R & NVIC_INT_CTRL_PEND_SV)
+        {
+            NVIC_INT_CTRL_R &= ~NVIC_INT_CTRL_PEND_SV;
+            _inPendSV = true;
+            PendSV_Handler();
+            _inPendSV = false;
+            RecordCalculated();
+        }
+    }
+    SetPreemption(false);
+
+    for(slot=0; slot<_takenCount; slot++)
+    {
+        if(( _taken[slot].low != _calculated[slot].low ) || ( _taken[slot].ton != _calculated[slot].ton ) ||
+           ( _taken[slot].interrupts != _calculated[slot].interrupts ))
+        {
+            wrong++;
+        }
+    }
+    printf("%s: %lu slots taken, %lu preemptions within the PendSV, %lu late slots, %lu not the calculated one\n",
+           handshake ? "handshake" : "no handshake", _takenCount, _preemptionsInPendSV, _lateSlots, wrong);
+
+    return wrong;
+}
+
+int main(void)
+{
+    struct sigaction action;
+    unsigned long wrong;
+
+    HostTarget_Init();
+
+    action.sa_handler = SimulatedInterrupt;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGALRM, &action, 0);
+
+    wrong = Run(true);
+    HostTarget_Check(_motorState == SM_MOTOR_STARTED, "the motor runs");
+    HostTarget_Check(_preemptionsInPendSV > 0, "the Systick Interrupt preempts the PendSV");
+    HostTarget_Check(_lateSlots > 0, "a slot the PendSV didn't finish is replaced by a late one");
+    HostTarget_Check(wrong == 0, "every slot taken is the next one calculated, whole");
+
+    wrong = Run(false);
+    HostTarget_Check(wrong > 0, "the check catches the slots taken without the handshake");
+
+    return HostTarget_Result("SystickHandshakeTest");
+}
@@ -0,0 +1,240 @@
+/*
+ * SystickIsrCycles.c
+ *
+ * Cycle model of the Systick Interrupt of the Systick backend on the
+ *  Cortex-M4F, without and with PWM_ISR_PROFILING. There is no ARM compiler
+ *  nor a target in this folder, so the instructions of each path are the
+ *  Thumb-2 listing that LLVM (llc -O2 -mcpu=cortex-m4) gives for
+ *  SysTick_Handler transcribed one to one, and their cycles are the ones of
+ *  the Cortex-M4 technical reference manual: a load or a store 2, LDRD/STRD 3,
+ *  LDM/STM of four registers 5, a taken branch, BL and BX 1 + 3 (the worst
+ *  pipeline refill), the loads not pipelined with the ones before them. The
+ *  CCS compiler may schedule the handler otherwise, so the figures are the
+ *  model of the code, not a measurement; with PWM_ISR_PROFILING the handler
+ *  measures itself on the target through PwmOuputController_GetSystickWorstCycles.
+ *
+ * The real controller then runs one second of the table mode at 60 Hz on the
+ *  host, sampling the current, and each Systick Interrupt is sorted into its
+ *  path to give the mix of the paths and the average cycles per interrupt.
+ *
+ * Checked: the interrupt that only outputs the pin takes under 40 cycles and
+ *  so do the interrupts on average; every slot is taken whole, samples the
+ *  current once and the longest path, with the exception entry and return,
+ *  fits well into the DEFAULT_RELOAD + 1 cycles between two interrupts; the
+ *  profiling is left out of the normal build.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/systick_isr_cycles.out Tools/SystickIsrCycles.c Tools/HostTarget.c
+ *      Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/systick_isr_cycles.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/PwmOutputController.h"
+#include <stdio.h>
+
+#if PWM_OUTPUT_BACKEND != PWM_BACKEND_SYSTICK
+#error "The model is of the Systick backend"
+#endif
+
+/* The Systick Interrupts of the host run, one second */
+#define TICKS INTERRUPT_FREQ
+/* The exception entry and return of the Cortex-M4, with zero wait state memory */
+#define EXCEPTION_ENTRY_CYCLES 12
+#define EXCEPTION_RETURN_CYCLES 10
+/* The conditional branches, taken and not */
+#define BRANCH_TAKEN 4
+#define BRANCH_NOT_TAKEN 1
+
+/* The internals of the controller under check */
+extern SystickState _systick;
+extern unsigned long _lateSlots;
+void SysTick_Handler(void);
+void PendSV_Handler(void);
+
+/* One instruction and its Cortex-M4 cycles */
+typedef struct
+{
+    const char *name;
+    unsigned int cycles;
+} ModelOperation;
+
+/* The paths of the Systick Interrupt */
+typedef enum {
+    PATH_TICK,              // the pin only
+    PATH_SAMPLE,            // the pin and the current sample
+    PATH_SLOT_END,          // the next slot taken, the pin of its first interrupt
+    PATH_SLOT_END_SAMPLE,   // the same, sampling at the first interrupt
+    PATH_LATE,              // the next slot not ready, a late one instead
+    PATHS
+} TickPath;
+
+static const char *_pathNames[PATHS] = {"pin only", "pin and sample", "slot end", "slot end and sample", "late slot"};
+
+/* The counter and the end of the slot, up to the branch to the output */
+static const ModelOperation _entry[] = {
+    {"PUSH {r7, lr}", 3}, {"MOVW r0, _systick", 1}, {"MOVT r0, _systick", 1},
+    {"LDR r2, [r0, #8]", 2}, {"LDR r1, [r0, #32]", 2}, {"CMP r1, r2", 1}
+};
+/* The same with the profiling: the counter read and the first toggle */
+static const ModelOperation _profiledEntry[] = {
+    {"PUSH {r4, r5, r6, lr}", 5}, {"BL Debug_CycleCounterRead", 4},
+    {"MOVW MOVT r0, DWT_CYCCNT", 2}, {"LDR r0, [r0]", 2}, {"BX lr", 4},
+    {"MOVW r5, _systick", 1}, {"MOVT r5, _systick", 1}, {"LDR r6, [r5, #32]", 2}, {"MOV r4, r0", 1},
+    {"BL Debug_TooglePin_1", 4}, {"MOVW MOVT r0, PB2", 2}, {"LDR r1, [r0]", 2}, {"EOR r1, r1, #4", 1},
+    {"STR r1, [r0]", 2}, {"BX lr", 4}, {"LDR r0, [r5, #8]", 2}, {"CMP r6, r0", 1}
+};
+/* The pin of the ending slot left LOW and the ready flag */
+static const ModelOperation _slotEnd[] = {
+    {"LDR r2, [r0]", 2}, {"MOVS r1, #0", 1}, {"STR r1, [r2]", 2}, {"LDRB.W r2, [r0, #36]", 2}
+};
+/* The next slot copied over the current one, the flag cleared and the PendSV pended */
+static const ModelOperation _take[] = {
+    {"ADD.W lr, r0, #16", 1}, {"LDM.W lr, {r2, r3, r12, lr}", 5}, {"STM.W r0, {r2, r3, r12, lr}", 5},
+    {"MOVW r2, #60676", 1}, {"STRB.W r1, [r0, #36]", 2}, {"MOVT r2, #57344", 1},
+    {"MOV.W r3, #268435456", 1}, {"B", 4}
+};
+/* The late slot */
+static const ModelOperation _late[] = {
+    {"MOVS r2, #1", 1}, {"MOV.W r3, #-1", 1}, {"STRD r2, r3, [r0, #8]", 3}, {"MOVW r2, _lateSlots", 1},
+    {"MOVT r2, _lateSlots", 1}, {"LDR r3, [r2]", 2}, {"STR r1, [r0, #4]", 2}, {"ADDS r3, #1", 1}
+};
+/* The store shared by both, NVIC_INT_CTRL_R or _lateSlots */
+static const ModelOperation _store[] = {
+    {"STR r3, [r2]", 2}
+};
+/* The pin compared and stored, then the sample compared */
+static const ModelOperation _output[] = {
+    {"LDRD r12, r3, [r0]", 3}, {"MOVS r2, #0", 1}, {"CMP r1, r3", 1}, {"IT LO", 1}, {"MOVLO r2, #255", 1},
+    {"STR.W r2, [r12]", 2}, {"LDR r2, [r0, #12]", 2}, {"CMP r1, r2", 1}
+};
+/* The current sample, ADC0_PSSI_R */
+static const ModelOperation _sample[] = {
+    {"MOVW r2, #32808", 1}, {"MOVT r2, #16387", 1}, {"MOVS r3, #8", 1}, {"STR r3, [r2]", 2}
+};
+/* The counter stored and the return */
+static const ModelOperation _done[] = {
+    {"ADDS r1, #1", 1}, {"STR r1, [r0, #32]", 2}, {"POP {r7, pc}", 6}
+};
+/* The same with the profiling: the second toggle, the counter read, the longest and the sum */
+static const ModelOperation _profiledDone[] = {
+    {"ADDS r0, r6, #1", 1}, {"STR r0, [r5, #32]", 2},
+    {"BL Debug_TooglePin_1", 4}, {"MOVW MOVT r0, PB2", 2}, {"LDR r1, [r0]", 2}, {"EOR r1, r1, #4", 1},
+    {"STR r1, [r0]", 2}, {"BX lr", 4}, {"BL Debug_CycleCounterRead", 4}, {"MOVW MOVT r0, DWT_CYCCNT", 2},
+    {"LDR r0, [r0]", 2}, {"BX lr", 4}, {"MOVW MOVT r1, _systickWorstCycles", 2}, {"LDR r2, [r1]", 2},
+    {"SUBS r0, r0, r4", 1}, {"CMP r0, r2", 1}, {"IT HI", 1}, {"STRHI r0, [r1]", 2},
+    {"MOVW MOVT r1, _systickCycles", 2}, {"LDR r2, [r1]", 2}, {"ADD r0, r2", 1}, {"STR r0, [r1]", 2},
+    {"POP {r4, r5, r6, pc}", 8}
+};
+
+#define CYCLES(operations) OperationCycles(operations, sizeof(operations) / sizeof(operations[0]))
+
+static unsigned int OperationCycles(const ModelOperation *operations, unsigned int count)
+{
+    unsigned int cycles = 0;
+    unsigned int i;
+    for(i=0; i<count; i++) cycles += operations[i].cycles;
+    return cycles;
+}
+
+/* The cycles of one path of the handler, without the exception entry and return */
+static unsigned int PathCycles(TickPath path, bool profiled)
+{
+    unsigned int cycles = profiled ? CYCLES(_profiledEntry) : CYCLES(_entry);
+
+    if(( path == PATH_TICK ) || ( path == PATH_SAMPLE ))
+    {
+        cycles += BRANCH_TAKEN;                             // BLO to the output
+    }
+    else
+    {
+        cycles += BRANCH_NOT_TAKEN + CYCLES(_slotEnd);
+        if(path == PATH_LATE) cycles += BRANCH_TAKEN + CYCLES(_late);   // CBZ
+        else cycles += BRANCH_NOT_TAKEN + CYCLES(_take);
+        cycles += CYCLES(_store);
+    }
+    cycles += CYCLES(_output);
+    if(( path == PATH_SAMPLE ) || ( path == PATH_SLOT_END_SAMPLE )) cycles += BRANCH_NOT_TAKEN + CYCLES(_sample);
+    else cycles += BRANCH_TAKEN;                            // BNE over the sample
+    cycles += profiled ? CYCLES(_profiledDone) : CYCLES(_done);
+
+    return cycles;
+}
+
+/* Run the controller for TICKS Systick Interrupts, counting the paths taken. The PendSV
+ *  is run right after the interrupt that pends it, as when nothing delays it */
+static void Run(unsigned long *paths)
+{
+    unsigned long tick;
+    int path;
+
+    for(path=0; path<PATHS; path++) paths[path] = 0;
+    PwmOuputController_Init(60);
+    PwmOuputController_SetCurrentSampling(true, SAMPLE_PHASE_ON_CENTER);
+    PwmOuputController_Start();
+    _lateSlots = 0;
+
+    for(tick=0; tick<TICKS; tick++)
+    {
+        bool end = _systick.counter >= _systick.cycle.interrupts;
+        bool ready = _systick.nextReady;
+        bool sample;
+
+        SysTick_Handler();
+        sample = (_systick.counter - 1) == _systick.cycle.sample;
+        if(!end) path = sample ? PATH_SAMPLE : PATH_TICK;
+        else if(!ready) path = PATH_LATE;
+        else path = sample ? PATH_SLOT_END_SAMPLE : PATH_SLOT_END;
+        paths[path]++;
+
+        if(!_systick.nextReady) PendSV_Handler();
+    }
+}
+
+int main(void)
+{
+    unsigned long paths[PATHS];
+    unsigned long samples, ends;
+    unsigned long long total = 0;
+    unsigned int worst = 0;
+    double average;
+    int path;
+
+    HostTarget_Init();
+    Run(paths);
+
+    printf("path                 cycles  profiled  interrupts of the 60 Hz run\n");
+    for(path=0; path<PATHS; path++)
+    {
+        unsigned int cycles = PathCycles((TickPath)path, false);
+
+        printf("%-20s %6u  %8u  %lu\n", _pathNames[path], cycles, PathCycles((TickPath)path, true), paths[path]);
+        total += (unsigned long long)cycles * paths[path];
+        if(cycles > worst) worst = cycles;
+    }
+    average = (double)total / TICKS;
+    printf("average %.1f cycles per interrupt, %.1f with the exception entry and return, %.1f%% of the %u cycles between two\n",
+           average, average + EXCEPTION_ENTRY_CYCLES + EXCEPTION_RETURN_CYCLES,
+           100.0 * (average + EXCEPTION_ENTRY_CYCLES + EXCEPTION_RETURN_CYCLES) / (DEFAULT_RELOAD + 1), DEFAULT_RELOAD + 1);
+    printf("longest path %u cycles, %u with the exception entry and return\n",
+           worst, worst + EXCEPTION_ENTRY_CYCLES + EXCEPTION_RETURN_CYCLES);
+
+    HostTarget_Check(PathCycles(PATH_TICK, false) < 40, "the interrupt that only outputs the pin takes under 40 cycles");
+    HostTarget_Check(average < 40, "the interrupts take under 40 cycles on average");
+    HostTarget_Check(( paths[PATH_LATE] == 0 ) && ( _lateSlots == 0 ), "every slot is taken whole when the PendSV isn't delayed");
+    /* The slot being output when the run stops may not have reached its sample yet */
+    samples = paths[PATH_SAMPLE] + paths[PATH_SLOT_END_SAMPLE];
+    ends = paths[PATH_SLOT_END] + paths[PATH_SLOT_END_SAMPLE];
+    HostTarget_Check(( samples <= ends ) && ( (samples + 1) >= ends ), "every slot samples the current once");
+    HostTarget_Check((worst + EXCEPTION_ENTRY_CYCLES + EXCEPTION_RETURN_CYCLES) * 3 < (DEFAULT_RELOAD + 1),
+                     "the longest path takes under a third of the cycles between two interrupts");
+    HostTarget_Check(PWM_ISR_PROFILING == 0, "the profiling is left out of the normal build");
+
+    return HostTarget_Result("SystickIsrCycles");
+}
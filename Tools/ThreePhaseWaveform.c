@@ -0,0 +1,311 @@
+/*
+ * ThreePhaseWaveform.c
+ *
+ * Runs the three-phase backend on the host, its PWM0 generator 0 task once
+ *  per pwm cycle, and rebuilds the six gate signals from the LOAD, CMPA and
+ *  GENA registers the task leaves for the global synchronization: up/down
+ *  count, the high side HI while the counter is below CMPA or held LOW or HI
+ *  by the actions of the six-step, and the dead-band generator delaying the
+ *  rising edges of both sides.
+ *
+ * Checked: the three legs share one LOAD and are applied by one global
+ *  synchronization every pwm cycle; the high and the low side of a leg are
+ *  never HI at the same clock and are both LOW for the dead time at every
+ *  edge; the output frequency; the legs have the same fundamental 120 and
+ *  240 degrees apart; the line-to-line voltages U-V, V-W and W-U have the
+ *  same RMS and fundamental, sqrt(3) times the leg one. The legs read the
+ *  nearest point of the 36 points sine table, and at 50 Hz a sine wave lasts
+ *  72.9 pwm cycles, so each leg lands on its own points: they only match to
+ *  the table quantization averaged over the sine waves checked, 0.05 degree
+ *  and 0.1 % over 100 of them. Driven then into the six-step by the
+ *  overmodulation, each side of a leg switches on only once per sine wave,
+ *  without the narrow pulses of a comparator kept off 0 and LOAD.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -DPWM_OUTPUT_BACKEND=3 -I. -ITools -o Tools/three_phase_waveform.out Tools/ThreePhaseWaveform.c
+ *      Tools/HostTarget.c -lm Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/three_phase_waveform.out
+ * With "dump" it prints instead the six gate signals of one sine wave, one
+ *  line per change: the clock and the UH UL VH VL WH WL levels.
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/PwmOutputController.h"
+#include "tm4c123gh6pm.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#if PWM_OUTPUT_BACKEND != PWM_BACKEND_THREE_PHASE
+#error "Build with -DPWM_OUTPUT_BACKEND=3"
+#endif
+
+/* The frequency under check {1/FREQUENCY_FINE_SCALE Hz} and the sine waves checked */
+#define CHECK_FREQUENCY 5000
+#define CHECK_SINE_WAVES 100
+/* More pwm cycles than the sine waves checked can take */
+#define MAX_CYCLES 8192
+/* The global synchronization of the three generators */
+#define GLOBAL_SYNC_LEGS (PWM_CTL_GLOBALSYNC0 | PWM_CTL_GLOBALSYNC1 | PWM_CTL_GLOBALSYNC2)
+/* The generator actions that hold a leg LOW or HI for the six-step, as PWM.c holds them */
+#define GEN_LEG_LOW 0x0000000A
+#define GEN_LEG_HI  0x0000000F
+/* The base frequency that takes the check frequency into the six-step {Hz}, and its sine waves checked */
+#define SIX_STEP_BASE_FREQUENCY 10
+#define SIX_STEP_SINE_WAVES 10
+
+/* The internals of the controller under check */
+extern unsigned long _deadTime;
+void ThreePhaseCycleTask(void);
+
+/* One leg of the dead-band generator, the rising edges of both sides wait for the dead time */
+typedef struct
+{
+    unsigned long hiRun;    // the clocks the comparator output has been HI
+    unsigned long lowRun;   // the clocks the comparator output has been LOW
+    bool high;              // the high side gate
+    bool low;               // the low side gate
+    unsigned long deadRun;  // the clocks both gates have been LOW
+    unsigned long shortestDead; // the shortest time both gates were LOW between two sides {clocks}
+    bool lastHigh;          // the side that was HI last
+} Leg;
+
+static Leg _legs[3];
+static unsigned long _overlaps = 0;
+
+/* The comparator output of a leg at one clock, from its generator actions */
+static bool LegComparator(unsigned long actions, unsigned long counter, unsigned long cmp)
+{
+    if(actions == GEN_LEG_LOW) return false;
+    if(actions == GEN_LEG_HI) return true;
+    return counter < cmp;
+}
+
+/* Advance one leg by one clock, from the level of its comparator output */
+static void StepLeg(Leg *leg, bool comparator)
+{
+    if(comparator) { leg->hiRun++; leg->lowRun = 0; }
+    else { leg->lowRun++; leg->hiRun = 0; }
+
+    leg->high = leg->hiRun > _deadTime;
+    leg->low = leg->lowRun > _deadTime;
+    if(leg->high && leg->low) _overlaps++;
+
+    if(leg->high || leg->low)
+    {
+        /* Both gates were LOW between the two sides, the dead time */
+        if(( leg->deadRun != 0 ) && ( leg->high != leg->lastHigh ) && ( leg->deadRun < leg->shortestDead )) leg->shortestDead = leg->deadRun;
+        leg->deadRun = 0;
+        leg->lastHigh = leg->high;
+    }
+    else
+    {
+        leg->deadRun++;
+    }
+}
+
+/* The pwm cycles output, the pole voltages averaged over each one ignoring the dead time {bus voltage} */
+static unsigned long long _cycleStart[MAX_CYCLES + 1];
+static double _poles[MAX_CYCLES][3];
+static unsigned long _cycles = 0;
+
+/* The voltage of a leg (0 to 2) or of a line (3 to 5, U-V, V-W and W-U) within a pwm cycle */
+static double Voltage(unsigned long cycle, int signal)
+{
+    if(signal < 3) return _poles[cycle][signal];
+    return _poles[cycle][signal - 3] - _poles[cycle][(signal - 2) % 3];
+}
+
+/* The fundamental and the RMS of a voltage within the clocks from..to, the voltage is constant
+ *  within each pwm cycle so the integrals are exact, cutting the pwm cycles at both ends */
+static void Analyze(int signal, double from, double to, double *amplitude, double *angle, double *rms)
+{
+    double omega = 2 * M_PI * CHECK_FREQUENCY / (FREQUENCY_FINE_SCALE * (double)SYSTEM_CLOCK_FREQ);
+    double re = 0;
+    double im = 0;
+    double squares = 0;
+    unsigned long cycle;
+
+    for(cycle=0; cycle<_cycles; cycle++)
+    {
+        double t0 = (double)_cycleStart[cycle];
+        double t1 = (double)_cycleStart[cycle + 1];
+        double v = Voltage(cycle, signal);
+        if(t0 < from) t0 = from;
+        if(t1 > to) t1 = to;
+        if(t1 <= t0) continue;
+        /* The integral of v * e^(-j * omega * t) over the pwm cycle */
+        re += v * (sin(omega * t1) - sin(omega * t0)) / omega;
+        im += v * (cos(omega * t1) - cos(omega * t0)) / omega;
+        squares += v * v * (t1 - t0);
+    }
+    *amplitude = 2 * sqrt((re * re) + (im * im)) / (to - from);
+    *angle = atan2(im, re) * 180 / M_PI;
+    *rms = sqrt(squares / (to - from));
+}
+
+/* Output some sine waves and count the times each side of each leg switches on */
+static void CountSwitchOns(unsigned int sineWaves, unsigned long switchOns[3])
+{
+    volatile unsigned long *cmps[3] = {&PWM0_0_CMPA_R, &PWM0_1_CMPA_R, &PWM0_2_CMPA_R};
+    volatile unsigned long *actions[3] = {&PWM0_0_GENA_R, &PWM0_1_GENA_R, &PWM0_2_GENA_R};
+    double clocks = sineWaves * (double)SYSTEM_CLOCK_FREQ * FREQUENCY_FINE_SCALE / CHECK_FREQUENCY;
+    unsigned long long clock = 0;
+    unsigned long load;
+    unsigned long t;
+    bool high;
+    bool low;
+    int i;
+
+    for(i=0; i<3; i++) switchOns[i] = 0;
+    while(clock < clocks)
+    {
+        PWM0_CTL_R = 0;
+        load = PWM0_0_LOAD_R;
+        for(t=0; t<(2 * load); t++)
+        {
+            unsigned long counter = (t <= load) ? t : ((2 * load) - t);
+            for(i=0; i<3; i++)
+            {
+                high = _legs[i].high;
+                low = _legs[i].low;
+                StepLeg(&_legs[i], LegComparator(*actions[i], counter, *cmps[i]));
+                if(_legs[i].high && !high) switchOns[i]++;
+                if(_legs[i].low && !low) switchOns[i]++;
+            }
+        }
+        clock += 2 * load;
+        ThreePhaseCycleTask();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool dump = ( argc > 1 ) && ( strcmp(argv[1], "dump") == 0 );
+    volatile unsigned long *loads[3] = {&PWM0_0_LOAD_R, &PWM0_1_LOAD_R, &PWM0_2_LOAD_R};
+    volatile unsigned long *cmps[3] = {&PWM0_0_CMPA_R, &PWM0_1_CMPA_R, &PWM0_2_CMPA_R};
+    volatile unsigned long *actions[3] = {&PWM0_0_GENA_R, &PWM0_1_GENA_R, &PWM0_2_GENA_R};
+    /* The clocks of the whole sine waves checked, at the frequency set */
+    double sineWave = (double)SYSTEM_CLOCK_FREQ * FREQUENCY_FINE_SCALE / CHECK_FREQUENCY;
+    double window = sineWave * (dump ? 1 : CHECK_SINE_WAVES);
+    unsigned long load = 0;
+    unsigned long cmp[3];
+    unsigned long gena[3];
+    unsigned long switchOns[3];
+    unsigned long t;
+    unsigned long long clock = 0;
+    unsigned int levels;
+    unsigned int lastLevels = 0xFF;
+    bool sameLoad = true;
+    bool synchronized = true;
+    double amplitude[6];
+    double angle[6];
+    double rms[6];
+    double first;
+    double second;
+    double dummy;
+    double drift;
+    double measured;
+    int i;
+
+    HostTarget_Init();
+    PwmOuputController_Init(0);
+    PwmOuputController_UpdateFrequencyFine(CHECK_FREQUENCY);
+    PwmOuputController_Start();
+    for(i=0; i<3; i++) _legs[i].shortestDead = 0xFFFFFFFF;
+
+    /* The counter = 0 interrupt that starts the motor, it loads the first pwm cycle */
+    ThreePhaseCycleTask();
+    HostTarget_Check(Control_GetMotorState() == SM_MOTOR_STARTED, "the motor starts");
+
+    while(( clock < window ) && ( _cycles < MAX_CYCLES ))
+    {
+        /* The global synchronization applies the values at the counter = 0 */
+        if(PWM0_CTL_R != GLOBAL_SYNC_LEGS) synchronized = false;
+        if(( *loads[1] != *loads[0] ) || ( *loads[2] != *loads[0] )) sameLoad = false;
+        PWM0_CTL_R = 0;
+        load = *loads[0];
+        for(i=0; i<3; i++) { cmp[i] = *cmps[i]; gena[i] = *actions[i]; }
+
+        /* The pwm cycle, clock by clock */
+        _cycleStart[_cycles] = clock;
+        for(t=0; t<(2 * load); t++)
+        {
+            unsigned long counter = (t <= load) ? t : ((2 * load) - t);
+            levels = 0;
+            for(i=0; i<3; i++)
+            {
+                StepLeg(&_legs[i], LegComparator(gena[i], counter, cmp[i]));
+                levels |= (_legs[i].high ? 1 : 0) << (2 * i);
+                levels |= (_legs[i].low ? 2 : 0) << (2 * i);
+            }
+            if(dump && ( levels != lastLevels ))
+            {
+                printf("%llu %u %u %u %u %u %u\n", clock, levels & 1, (levels >> 1) & 1, (levels >> 2) & 1,
+                       (levels >> 3) & 1, (levels >> 4) & 1, (levels >> 5) & 1);
+                lastLevels = levels;
+            }
+            clock++;
+        }
+        for(i=0; i<3; i++) _poles[_cycles][i] = ((double)cmp[i] / load) - 0.5;
+        _cycles++;
+        _cycleStart[_cycles] = clock;
+
+        ThreePhaseCycleTask();
+    }
+    if(dump) return 0;
+
+    HostTarget_Check(synchronized, "every pwm cycle is applied by one global synchronization of the three legs");
+    HostTarget_Check(sameLoad, "the three legs share the same LOAD");
+    HostTarget_Check(_overlaps == 0, "the high and the low side of a leg are never HI together");
+    for(i=0; i<3; i++)
+    {
+        HostTarget_Check(_legs[i].shortestDead >= _deadTime, "both sides of a leg are LOW for the dead time at every edge");
+    }
+
+    /* The frequency from the drift of the fundamental of the leg U between both halves */
+    Analyze(0, 0, window / 2, &dummy, &first, &dummy);
+    Analyze(0, window / 2, window, &dummy, &second, &dummy);
+    drift = fmod(second - first + 540.0, 360.0) - 180.0;
+    measured = (CHECK_FREQUENCY / (double)FREQUENCY_FINE_SCALE) * (1 + (drift / (360.0 * CHECK_SINE_WAVES / 2)));
+    printf("%lu pwm cycles of %lu clocks, output frequency %.7f Hz\n", _cycles, 2 * load, measured);
+    HostTarget_Check(fabs(measured - (CHECK_FREQUENCY / (double)FREQUENCY_FINE_SCALE)) < 1e-4, "the output frequency is the one set");
+
+    for(i=0; i<6; i++) Analyze(i, 0, window, &amplitude[i], &angle[i], &rms[i]);
+    for(i=0; i<3; i++)
+    {
+        printf("leg %c: fundamental %.6f at %8.3f deg, RMS %.6f | line %c%c: fundamental %.6f, RMS %.6f\n",
+               "UVW"[i], amplitude[i], angle[i], rms[i], "UVW"[i], "UVW"[(i + 1) % 3], amplitude[i + 3], rms[i + 3]);
+    }
+    for(i=1; i<3; i++)
+    {
+        double offset = fmod(angle[0] - angle[i] + 720.0, 360.0);
+        HostTarget_Check(fabs(offset - (120.0 * i)) < 0.05, "the legs are 120 and 240 degrees behind the leg U");
+        HostTarget_Check(fabs(amplitude[i] - amplitude[0]) < (1e-3 * amplitude[0]), "the legs have the same fundamental");
+        HostTarget_Check(fabs(rms[i + 3] - rms[3]) < (1e-3 * rms[3]), "the line-to-line voltages have the same RMS");
+        HostTarget_Check(fabs(amplitude[i + 3] - amplitude[3]) < (1e-3 * amplitude[3]), "the line-to-line voltages have the same fundamental");
+    }
+    HostTarget_Check(fabs(amplitude[3] - (sqrt(3) * amplitude[0])) < (1e-3 * amplitude[3]), "the line-to-line fundamental is sqrt(3) times the leg one");
+
+    /* The six-step, once the modulation index settled on it */
+    PwmOuputController_SetOvermodulation(true);
+    PwmOuputController_SetVfCurve(VF_CURVE_LINEAR, SIX_STEP_BASE_FREQUENCY, 0);
+    CountSwitchOns(1, switchOns);
+    CountSwitchOns(SIX_STEP_SINE_WAVES, switchOns);
+    printf("six-step: the sides of the legs switch on %lu, %lu and %lu times in %u sine waves\n",
+           switchOns[0], switchOns[1], switchOns[2], SIX_STEP_SINE_WAVES);
+    for(i=0; i<3; i++)
+    {
+        HostTarget_Check(( switchOns[i] >= ((2 * SIX_STEP_SINE_WAVES) - 1) ) && ( switchOns[i] <= ((2 * SIX_STEP_SINE_WAVES) + 1) ),
+                         "at the six-step each side of a leg switches on once per sine wave");
+    }
+    HostTarget_Check(_overlaps == 0, "at the six-step the high and the low side of a leg are never HI together");
+
+    return HostTarget_Result("ThreePhaseWaveform");
+}
@@ -0,0 +1,190 @@
+/*
+ * TonTableBankGen.c
+ *
+ * Generates Source/Main/TonTableBank.c, the ton tables of every pwm cycle
+ *  length the frequencies of the bank reach, from the half sine wave of
+ *  SineTable.c with the integer math of UpdateTonTable. Run with "check" it
+ *  checks instead that the committed bank holds the generated tables, that
+ *  they are the tables UpdateTonTable calculates at runtime, that every ton
+ *  is within half an interrupt plus the table precision of the exact sine,
+ *  and that every fine frequency within the bank, at the full modulation
+ *  index, is output from a bank table without calculating one.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/ton_table_bank_gen.out Tools/TonTableBankGen.c Tools/HostTarget.c -lm
+ *      Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/ton_table_bank_gen.out > Source/Main/TonTableBank.c
+ *  Tools/ton_table_bank_gen.out check
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/PwmOutputController.h"
+#include "Source/Main/SineTable.h"
+#include "Source/Main/TonTableBank.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* The sources of the repository keep CRLF line endings */
+#define EOL "\r\n"
+
+#define BANK_TABLES (TON_TABLE_BANK_LONGEST - TON_TABLE_BANK_SHORTEST + 1)
+
+/* The internals of the controller under check */
+extern unsigned int _interruptsInPwmCycle;
+extern unsigned long _modulationIndex;
+extern volatile TonTable _tonTables[2];
+extern const volatile TonTable * volatile _pendingTonTable;
+void UpdateTonTable(volatile TonTable *table);
+
+/* The pwm cycle length of a fine frequency, as the drive calculates it */
+static unsigned int PwmCycleLength(unsigned long freq)
+{
+    return ((unsigned long)INTERRUPT_FREQ * FREQUENCY_FINE_SCALE) / (PWM_CYCLE_WITHIN_FULL_SINE * freq);
+}
+
+/* Generate the ton table of one pwm cycle length */
+static void Generate(unsigned int interrupts, TonTable *table)
+{
+    int i;
+
+    for(i=0; i<36; i++)
+    {
+        table->tonTable[i] = ((interrupts * SineTable_HalfWave(i)) + (1 << (SINE_TABLE_FRACTION_BITS - 1))) >> SINE_TABLE_FRACTION_BITS;
+    }
+    table->interruptsInPwmCycle = interrupts;
+}
+
+/* Print the whole TonTableBank.c */
+static void Print(void)
+{
+    TonTable table;
+    unsigned int interrupts;
+    int i;
+
+    printf("/*" EOL
+           " * TonTableBank.c" EOL
+           " *" EOL
+           " * The ton tables of every pwm cycle length within the drive bounds, precalculated into flash." EOL
+           " * Each table was generated with the very same integer math of UpdateTonTable, over the" EOL
+           " *  36 points half sine wave of SineTable.c:" EOL
+           " *      ton[i] = (interruptsInPwmCycle * SineTable_HalfWave(i) + 0x8000) >> 16" EOL
+           " * so selecting a table gives exactly the tons that would be calculated at runtime." EOL
+           " * The lengths go from 233280 / (72 * 90) to 233280 / (72 * 30), so every fine frequency" EOL
+           " *  from 30 to 90 Hz has its table here, not only the whole hertz." EOL
+           " * Flash used: %u tables * %u words = %u bytes." EOL
+           " *" EOL
+           " *  Created on: Oct 17, 2026" EOL
+           " *      Author: GMAGRI" EOL
+           " */" EOL
+           EOL
+           "#include \"TonTableBank.h\"" EOL
+           EOL
+           "#if TON_TABLE_BANK" EOL
+           EOL
+           "static const TonTable _tonTableBank[TON_TABLE_BANK_LONGEST - TON_TABLE_BANK_SHORTEST + 1] = {" EOL,
+           BANK_TABLES, (unsigned int)(sizeof(TonTable) / 4), (unsigned int)(BANK_TABLES * sizeof(TonTable)));
+
+    for(interrupts=TON_TABLE_BANK_SHORTEST; interrupts<=TON_TABLE_BANK_LONGEST; interrupts++)
+    {
+        Generate(interrupts, &table);
+        printf("    /* %u interrupts */" EOL "    {{", interrupts);
+        for(i=0; i<36; i++)
+        {
+            printf("%4u", table.tonTable[i]);
+            if(i == 35) printf(" }, %u}%s" EOL, table.interruptsInPwmCycle, (interrupts == TON_TABLE_BANK_LONGEST) ? "" : ",");
+            else if((i % 12) == 11) printf("," EOL "      ");
+            else printf(",");
+        }
+    }
+
+    printf("};" EOL
+           EOL
+           "/* ***************TonTableBank_Get******************" EOL
+           " * Returns the precalculated ton table of one pwm cycle length" EOL
+           " * Input: interrupts - the pwm cycle length {Systick Interrupts}" EOL
+           " * Output: const TonTable* - the ton table, or 0 when the length is outside of the bank" EOL
+           " */" EOL
+           "const TonTable* TonTableBank_Get(unsigned int interrupts)" EOL
+           "{" EOL
+           "    if((interrupts < TON_TABLE_BANK_SHORTEST) || (interrupts > TON_TABLE_BANK_LONGEST)) return 0;" EOL
+           EOL
+           "    return &_tonTableBank[interrupts - TON_TABLE_BANK_SHORTEST];" EOL
+           "}" EOL
+           EOL
+           "#endif" EOL);
+}
+
+/* Check the committed bank against the generator, UpdateTonTable and the exact sine */
+static int Check(void)
+{
+    TonTable generated;
+    TonTable runtime;
+    const TonTable *bank;
+    unsigned int interrupts;
+    unsigned long freq;
+    unsigned long calculated = 0;
+    char message[80];
+    double error;
+    double worst = 0;
+    int i;
+
+    for(interrupts=TON_TABLE_BANK_SHORTEST; interrupts<=TON_TABLE_BANK_LONGEST; interrupts++)
+    {
+        Generate(interrupts, &generated);
+        _interruptsInPwmCycle = generated.interruptsInPwmCycle;
+        _modulationIndex = MODULATION_FULL;
+        UpdateTonTable(&runtime);
+        bank = TonTableBank_Get(interrupts);
+
+        sprintf(message, "the bank table of %u interrupts is the generated one", interrupts);
+        HostTarget_Check(( bank != 0 ) && ( memcmp(bank, &generated, sizeof(TonTable)) == 0 ), message);
+        sprintf(message, "the bank table of %u interrupts is the one of UpdateTonTable", interrupts);
+        HostTarget_Check(( bank != 0 ) && ( memcmp(bank, &runtime, sizeof(TonTable)) == 0 ), message);
+
+        for(i=0; i<36; i++)
+        {
+            error = fabs(generated.tonTable[i] - (generated.interruptsInPwmCycle * sin((i + 1) * M_PI / 36.0)));
+            if(error > worst) worst = error;
+        }
+        sprintf(message, "the tons of %u interrupts are within the table precision of the exact sine", interrupts);
+        HostTarget_Check(worst <= 0.5 + (generated.interruptsInPwmCycle / 65536.0), message);
+    }
+    HostTarget_Check(TonTableBank_Get(TON_TABLE_BANK_SHORTEST - 1) == 0, "the bank has no table below its shortest pwm cycle");
+    HostTarget_Check(TonTableBank_Get(TON_TABLE_BANK_LONGEST + 1) == 0, "the bank has no table above its longest pwm cycle");
+    printf("largest ton error to the exact sine: %.4f Systick Interrupts\n", worst);
+
+    /* Every fine frequency of the bank, the way the ramp steps through them */
+    HostTarget_Check(( PwmCycleLength(TON_TABLE_BANK_UPPER * FREQUENCY_FINE_SCALE) == TON_TABLE_BANK_SHORTEST ) &&
+                     ( PwmCycleLength(TON_TABLE_BANK_LOWER * FREQUENCY_FINE_SCALE) == TON_TABLE_BANK_LONGEST ),
+                     "the bank lengths are the ones of its frequency bounds");
+    PwmOuputController_Init(TON_TABLE_BANK_LOWER);
+    PwmOuputController_SetVfCurve(VF_CURVE_NONE, TON_TABLE_BANK_UPPER, 0);
+    for(freq=TON_TABLE_BANK_LOWER * FREQUENCY_FINE_SCALE; freq<=TON_TABLE_BANK_UPPER * FREQUENCY_FINE_SCALE; freq++)
+    {
+        PwmOuputController_UpdateFrequencyFine(freq);
+        if(( _pendingTonTable == &_tonTables[0] ) || ( _pendingTonTable == &_tonTables[1] )) calculated++;
+    }
+    printf("fine frequencies from %u to %u Hz that calculate their table: %lu\n", TON_TABLE_BANK_LOWER, TON_TABLE_BANK_UPPER, calculated);
+    HostTarget_Check(calculated == 0, "every fine frequency of the bank takes its table from the bank");
+
+    return HostTarget_Result("TonTableBankGen");
+}
+
+int main(int argc, char **argv)
+{
+    if(( argc > 1 ) && ( strcmp(argv[1], "check") == 0 ))
+    {
+        HostTarget_Init();
+        return Check();
+    }
+    Print();
+
+    return 0;
+}
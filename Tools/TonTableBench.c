@@ -0,0 +1,265 @@
+/*
+ * TonTableBench.c
+ *
+ * Compares the integer ton table of UpdateTonTable with the former double
+ *  math, RoundToNearest(interrupts * sin), over the former 36 points double
+ *  table, and times both on the host.
+ *
+ * Checked: every integer frequency from 1 to 90 Hz gives the former table, and
+ *  which of them a Q15 table would miss. That identity only holds at whole
+ *  hertz: of the other pwm cycle lengths the fine frequency can reach (1 to
+ *  6480 Systick Interrupts) about one in six differs from the former math by
+ *  one interrupt in some ton, so they are compared with the exact sine: every
+ *  ton must be within half an interrupt plus the precision of the 16 bits table
+ *  (interrupts / 65536) of interrupts * sin.
+ *
+ * The host has a double FPU, so its TSC cycles per table build say nothing of
+ *  the Cortex-M4F, where each double operation is a soft-float call. The target
+ *  cost comes from a cycle model instead: the operations of one ton of each
+ *  version times their Cortex-M4 cycles. The integer operations take their
+ *  cycles from the Cortex-M4 technical reference manual; the soft-float calls
+ *  are estimates of the libgcc/RTS routines of the ARM compilers, not
+ *  measurements, so the model is only checked to favor the integer table by
+ *  a wide margin.
+ *
+ * The latency of a ramp step of the table mode is timed too: the 0.2 Hz steps
+ *  of the default ramp from 30 to 90 Hz through PwmOuputController_UpdateFrequencyFine,
+ *  at the full modulation index, where every step takes its table from the bank,
+ *  and under a V/f curve, where every step calculates it.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/ton_table_bench.out Tools/TonTableBench.c Tools/HostTarget.c -lm
+ *      Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/ton_table_bench.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/PwmOutputController.h"
+#include <math.h>
+#include <stdio.h>
+
+/* The builds timed of each version */
+#define BENCH_BUILDS 20000
+/* The integer table must cost under this share of the double one in the cycle model {%} */
+#define MODEL_INTEGER_SHARE 25
+/* The longest pwm cycle of the fine frequency, at FREQUENCY_RANGE_LOWER {Systick Interrupts} */
+#define LONGEST_PWM_CYCLE 6480
+
+/* The internals of the controller under check */
+extern unsigned int _interruptsInPwmCycle;
+extern unsigned long _modulationIndex;
+extern volatile TonTable _tonTables[2];
+extern const volatile TonTable * volatile _pendingTonTable;
+void UpdateTonTable(volatile TonTable *table);
+
+/* The former table, sin(x) for x = 5, 10, 15 ... 180 degrees */
+static const double _formerSinTable[36] = {
+    0.087155743 ,0.173648178 ,0.258819045 ,0.342020143 ,0.422618262 ,0.5 ,0.573576436 ,0.64278761 ,0.707106781 ,
+    0.766044443 ,0.819152044 ,0.866025404 ,0.906307787 ,0.939692621 ,0.965925826 ,0.984807753 ,0.996194698 ,1 ,
+    0.996194698 ,0.984807753 ,0.965925826 ,0.939692621 ,0.906307787 ,0.866025404 ,0.819152044 ,0.766044443 ,
+    0.707106781 ,0.64278761 ,0.573576436 ,0.5 ,0.422618262 ,0.342020143 ,0.258819045 ,0.173648178 ,0.087155743 ,0
+};
+
+/* The former UpdateTonTable */
+static void FormerTonTable(unsigned int interrupts, unsigned int *tons)
+{
+    int i;
+    for(i=0; i<36; i++)
+    {
+        tons[i] = (int)((double)(interrupts * _formerSinTable[i]) + 0.5);
+    }
+}
+
+/* The same round to the nearest with a Q15 table */
+static void Q15TonTable(unsigned int interrupts, unsigned int *tons)
+{
+    int i;
+    for(i=0; i<36; i++)
+    {
+        unsigned long sine = (unsigned long)((_formerSinTable[i] * 32768.0) + 0.5);
+        tons[i] = ((interrupts * sine) + 0x4000) >> 15;
+    }
+}
+
+/* The integer UpdateTonTable, at the full modulation index */
+static void IntegerTonTable(unsigned int interrupts, volatile TonTable *table)
+{
+    _interruptsInPwmCycle = interrupts;
+    _modulationIndex = MODULATION_FULL;
+    UpdateTonTable(table);
+}
+
+/* Compare a table with the exact sine, the ton i is at (i + 1) * 5 degrees. Returns the amount of
+ *  tons beyond half an interrupt plus the table precision, and counts the ones that aren't the nearest */
+static unsigned int BeyondPrecision(unsigned int interrupts, const volatile TonTable *table, unsigned int *notNearest)
+{
+    unsigned int count = 0;
+    int i;
+    for(i=0; i<36; i++)
+    {
+        double exact = interrupts * sin((i + 1) * M_PI / 36.0);
+        double error = fabs(table->tonTable[i] - exact);
+        if(error > 0.5 + (interrupts / 65536.0)) count++;
+        else if(error > 0.5 + 1e-9) (*notNearest)++;
+    }
+    return count;
+}
+
+/* Evaluate if two tables are the same */
+static bool SameTable(const unsigned int *former, const volatile TonTable *table)
+{
+    int i;
+    for(i=0; i<36; i++)
+    {
+        if(former[i] != table->tonTable[i]) return false;
+    }
+    return true;
+}
+
+/* One operation of a ton and its Cortex-M4 cycles */
+typedef struct
+{
+    const char *name;
+    unsigned int cycles;
+} ModelOperation;
+
+/* The former ton: the double sine load, the conversion of the interrupts, the multiply,
+ *  the add of 0.5 and the truncation, each a soft-float call, and the store */
+static const ModelOperation _formerTon[] = {
+    {"LDRD sine", 3}, {"__aeabi_ui2d", 20}, {"__aeabi_dmul", 70}, {"__aeabi_dadd", 60},
+    {"__aeabi_d2iz", 25}, {"STR ton", 2}, {"loop", 3}
+};
+
+/* The integer ton: the calls to SineTable_HalfWave and ShapeSine below the full index,
+ *  the multiply, the round and the store */
+static const ModelOperation _integerTon[] = {
+    {"BL/BX SineTable_HalfWave", 5}, {"ADD CMP IT SUB", 4}, {"LDRH quarter", 2},
+    {"BL/BX ShapeSine", 5}, {"CMP BHI", 2}, {"UMULL LSR", 2},
+    {"MUL ADD LSR", 3}, {"STR ton", 2}, {"loop", 3}
+};
+
+/* The cycles of one table build in the model */
+static unsigned int ModelTableCycles(const ModelOperation *ton, unsigned int count)
+{
+    unsigned int cycles = 0;
+    unsigned int i;
+    for(i=0; i<count; i++) cycles += ton[i].cycles;
+    return cycles * 36;
+}
+
+static unsigned long long ReadTsc(void)
+{
+    return __builtin_ia32_rdtsc();
+}
+
+/* Time the ramp steps from 30 to 90 Hz, returns the host cycles per step and counts the tables calculated */
+static unsigned long long RampSteps(VfCurve curve, unsigned long *calculated)
+{
+    unsigned long long start, cycles = 0;
+    unsigned long freq;
+    int i;
+
+    PwmOuputController_SetVfCurve(curve, 90, 0);
+    *calculated = 0;
+    for(i=0; i<(BENCH_BUILDS / 300); i++)
+    {
+        for(freq=3000; freq<=9000; freq+=20)
+        {
+            start = ReadTsc();
+            PwmOuputController_UpdateFrequencyFine(freq);
+            cycles += ReadTsc() - start;
+            if(( i == 0 ) && (( _pendingTonTable == &_tonTables[0] ) || ( _pendingTonTable == &_tonTables[1] ))) (*calculated)++;
+        }
+    }
+    return cycles / ((BENCH_BUILDS / 300) * 301);
+}
+
+int main(void)
+{
+    static volatile TonTable table;
+    unsigned int former[36];
+    unsigned int q15[36];
+    unsigned int freq, interrupts;
+    unsigned int beyond = 0;
+    unsigned int notNearest = 0;
+    unsigned int formerMismatches = 0;
+    unsigned long long start, formerCycles, integerCycles;
+    unsigned int formerModel, integerModel;
+    unsigned long long bankStep, calculatedStep;
+    unsigned long bankCalculated, curveCalculated;
+    volatile unsigned int sink = 0;
+    int i;
+    char message[96];
+
+    HostTarget_Init();
+
+    /* Every integer frequency of the former drive, 72 pwm cycles per sine wave */
+    printf("Q15 table differs at:");
+    for(freq=1; freq<=90; freq++)
+    {
+        interrupts = INTERRUPT_FREQ / (PWM_CYCLE_WITHIN_FULL_SINE * freq);
+        FormerTonTable(interrupts, former);
+        IntegerTonTable(interrupts, &table);
+        sprintf(message, "the ton table of %u Hz is the former one", freq);
+        HostTarget_Check(SameTable(former, &table), message);
+        Q15TonTable(interrupts, q15);
+        for(i=0; (i<36) && (q15[i] == former[i]); i++);
+        if(i < 36) printf(" %u Hz", freq);
+    }
+    printf("\n");
+
+    /* Every pwm cycle length of the fine frequency, against the exact sine */
+    for(interrupts=1; interrupts<=LONGEST_PWM_CYCLE; interrupts++)
+    {
+        FormerTonTable(interrupts, former);
+        IntegerTonTable(interrupts, &table);
+        if(!SameTable(former, &table)) formerMismatches++;
+        beyond += BeyondPrecision(interrupts, &table, &notNearest);
+    }
+    printf("pwm cycle lengths 1 to %u: %u tons beyond the table precision, %u within it but not the nearest,"
+           " %u tables differ from the former math\n", LONGEST_PWM_CYCLE, beyond, notNearest, formerMismatches);
+    HostTarget_Check(beyond == 0, "every ton of every pwm cycle length is within the table precision");
+
+    /* The ramp steps of the drive bounds, 30 to 90 Hz */
+    start = ReadTsc();
+    for(i=0; i<BENCH_BUILDS; i++)
+    {
+        FormerTonTable(INTERRUPT_FREQ / (PWM_CYCLE_WITHIN_FULL_SINE * (30 + (i % 61))), former);
+        sink += former[17];
+    }
+    formerCycles = ReadTsc() - start;
+    start = ReadTsc();
+    for(i=0; i<BENCH_BUILDS; i++)
+    {
+        IntegerTonTable(INTERRUPT_FREQ / (PWM_CYCLE_WITHIN_FULL_SINE * (30 + (i % 61))), &table);
+        sink += table.tonTable[17];
+    }
+    integerCycles = ReadTsc() - start;
+    printf("host cycles per table build (double FPU, not the target): double %llu, integer %llu\n",
+           formerCycles / BENCH_BUILDS, integerCycles / BENCH_BUILDS);
+
+    /* The Cortex-M4F cycle model */
+    formerModel = ModelTableCycles(_formerTon, sizeof(_formerTon) / sizeof(_formerTon[0]));
+    integerModel = ModelTableCycles(_integerTon, sizeof(_integerTon) / sizeof(_integerTon[0]));
+    printf("Cortex-M4F model cycles per table build: double %u (%.1f us), integer %u (%.1f us) at 80 MHz\n",
+           formerModel, formerModel / 80.0, integerModel, integerModel / 80.0);
+    HostTarget_Check((integerModel * 100) < (formerModel * MODEL_INTEGER_SHARE), "the integer table costs under a quarter of the double one in the model");
+
+    /* The ramp steps of the table mode */
+    PwmOuputController_Init(30);
+    bankStep = RampSteps(VF_CURVE_NONE, &bankCalculated);
+    calculatedStep = RampSteps(VF_CURVE_LINEAR, &curveCalculated);
+    PwmOuputController_SetVfCurve(VF_CURVE_NONE, 90, 0);
+    printf("0.2 Hz ramp steps from 30 to 90 Hz: full index %lu of 301 calculate their table, %llu host cycles per step;"
+           " V/f curve %lu of 301, %llu host cycles per step\n", bankCalculated, bankStep, curveCalculated, calculatedStep);
+    HostTarget_Check(bankCalculated == 0, "every ramp step at the full index takes its table from the bank");
+    HostTarget_Check(bankStep < calculatedStep, "a ramp step from the bank is shorter than one that calculates its table");
+
+    return HostTarget_Result("TonTableBench");
+}
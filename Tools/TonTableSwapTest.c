@@ -0,0 +1,201 @@
+/*
+ * TonTableSwapTest.c
+ *
+ * Hammers PwmOuputController_UpdateFrequencyFine from the main context while
+ *  an interval timer signal plays the pwm output interrupt, and checks that
+ *  every half sine wave output comes entirely from one ton table: its 36 pwm
+ *  cycles have the same length and the tons of that length.
+ *
+ * The signal preempts the main context at any instruction, as the interrupt
+ *  does, and runs a burst of PendSV_Handler calls, each one the calculation
+ *  of the next Systick slot (the Systick Interrupt only copies it). The same
+ *  run is repeated with the former in place update of the active table, so
+ *  the check is shown to catch a torn half sine wave.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/ton_table_swap_test.out Tools/TonTableSwapTest.c Tools/HostTarget.c
+ *      Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/ton_table_swap_test.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/PwmOutputController.h"
+#include <signal.h>
+#include <stdio.h>
+#include <sys/time.h>
+
+/* The preemptions of each run, and the Systick slots calculated at each one */
+#define PREEMPTIONS 20000
+#define SLOTS_PER_PREEMPTION 24
+/* The period of the interval timer {us} */
+#define PREEMPTION_PERIOD 20
+/* The longest pwm cycle of the fine frequency, at FREQUENCY_RANGE_LOWER {Systick Interrupts} */
+#define LONGEST_PWM_CYCLE 6480
+
+/* The internals of the controller under check */
+extern MotorState _motorState;
+extern unsigned int _interruptsInPwmCycle;
+extern unsigned int _tonIndex;
+extern volatile TonTable _tonTables[2];
+extern const volatile TonTable * volatile _activeTonTable;
+extern const volatile TonTable * volatile _pendingTonTable;
+extern SystickState _systick;
+void UpdateTonTable(volatile TonTable *table);
+void PendSV_Handler(void);
+
+/* The ton table of every pwm cycle length */
+static TonTable _references[LONGEST_PWM_CYCLE + 1];
+
+/* The half sine wave being output */
+static unsigned int _halfTons[36];
+static unsigned int _halfInterrupts[36];
+static unsigned int _halfSlots = 0;
+
+/* What the runs have seen */
+static volatile bool _updating = false;
+static volatile unsigned long _preemptions = 0;
+static unsigned long _preemptionsInUpdate = 0;
+static unsigned long _halves = 0;
+static unsigned long _torn = 0;
+
+/* Check the half sine wave just completed against the table of its first pwm cycle length */
+static void CheckHalf(void)
+{
+    unsigned int interrupts = _halfInterrupts[0];
+    int i;
+
+    _halves++;
+    for(i=0; i<36; i++)
+    {
+        if(( _halfInterrupts[i] != interrupts ) || ( _halfTons[i] != _references[interrupts].tonTable[i] ))
+        {
+            _torn++;
+            return;
+        }
+    }
+}
+
+/* Record one Systick slot, the index within the half sine wave is the one it was loaded from */
+static void RecordSlot(unsigned int index, unsigned int interrupts, unsigned int ton)
+{
+    /* Only whole half sine waves are checked */
+    if(index != _halfSlots)
+    {
+        _halfSlots = 0;
+        if(index != 0) return;
+    }
+    _halfInterrupts[index] = interrupts;
+    _halfTons[index] = ton;
+    _halfSlots++;
+    if(_halfSlots == 36)
+    {
+        CheckHalf();
+        _halfSlots = 0;
+    }
+}
+
+/* The pwm output interrupt, preempting the main context */
+static void SimulatedInterrupt(int signal)
+{
+    int slot;
+
+    (void)signal;
+    _preemptions++;
+    if(_updating) _preemptionsInUpdate++;
+    for(slot=0; slot<SLOTS_PER_PREEMPTION; slot++)
+    {
+        PendSV_Handler();
+        if(_motorState == SM_MOTOR_STARTED) RecordSlot(_tonIndex, _systick.next.interrupts, _systick.next.ton);
+    }
+}
+
+/* Start or stop the interval timer that raises the simulated interrupt */
+static void SetPreemption(bool enable)
+{
+    struct itimerval timer;
+
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = enable ? PREEMPTION_PERIOD : 0;
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_REAL, &timer, 0);
+}
+
+/* The former update, writing the ton table being output in place */
+static void UpdateInPlace(unsigned long freq)
+{
+    _interruptsInPwmCycle = ((unsigned long)INTERRUPT_FREQ * FREQUENCY_FINE_SCALE) / (PWM_CYCLE_WITHIN_FULL_SINE * freq);
+    UpdateTonTable((volatile TonTable *)_activeTonTable);
+}
+
+/* Update the frequency over and over until the simulated interrupt ran PREEMPTIONS times */
+static void Run(bool inPlace)
+{
+    unsigned long update = 0;
+    /* The frequencies of the fine range that keep the half sine wave short, some whole Hz within the bank */
+    unsigned long freq;
+
+    _preemptions = 0;
+    _preemptionsInUpdate = 0;
+    _halves = 0;
+    _torn = 0;
+    _halfSlots = 0;
+    SetPreemption(true);
+    while(_preemptions < PREEMPTIONS)
+    {
+        freq = 2000 + ((update * 37) % 6000);
+        _updating = true;
+        if(inPlace) UpdateInPlace(freq);
+        else PwmOuputController_UpdateFrequencyFine(freq);
+        _updating = false;
+        update++;
+    }
+    SetPreemption(false);
+    printf("%s: %lu updates, %lu preemptions (%lu within an update), %lu half sine waves, %lu torn\n",
+           inPlace ? "in place" : "double buffer", update, _preemptions, _preemptionsInUpdate, _halves, _torn);
+}
+
+int main(void)
+{
+    struct sigaction action;
+    TonTable reference;
+    unsigned int interrupts;
+
+    HostTarget_Init();
+
+    /* The references, at the full sine wave as there is no V/f curve */
+    for(interrupts=1; interrupts<=LONGEST_PWM_CYCLE; interrupts++)
+    {
+        _interruptsInPwmCycle = interrupts;
+        UpdateTonTable(&reference);
+        _references[interrupts] = reference;
+    }
+
+    PwmOuputController_Init(60);
+    PwmOuputController_Start();
+    PendSV_Handler();
+    HostTarget_Check(_motorState == SM_MOTOR_STARTED, "the motor starts");
+
+    action.sa_handler = SimulatedInterrupt;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGALRM, &action, 0);
+
+    Run(false);
+    HostTarget_Check(_preemptionsInUpdate > 0, "the interrupt preempts the double buffered update");
+    HostTarget_Check(_halves > 0, "half sine waves are output while updating");
+    HostTarget_Check(_torn == 0, "every half sine wave comes from one ton table");
+
+    /* The former single table, the bank is in flash */
+    _pendingTonTable = 0;
+    _activeTonTable = &_tonTables[0];
+    Run(true);
+    HostTarget_Check(_torn > 0, "the check catches the half sine waves torn by the in place update");
+
+    return HostTarget_Result("TonTableSwapTest");
+}
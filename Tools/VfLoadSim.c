@@ -0,0 +1,153 @@
+/*
+ * VfLoadSim.c
+ *
+ * Drives an RL load with the Systick backend, every Systick Interrupt and
+ *  PendSV run as on the target, and compares the V/f curves at the same
+ *  frequencies (the same shaft speed of the motor the load stands for).
+ * The load voltage is the bus times the difference of the pins PB0 and PB1,
+ *  and the current is integrated at each Systick Interrupt.
+ *
+ * Checked: without a curve the fundamental voltage is the same at every
+ *  frequency; with the linear curve it follows the frequency up to the base
+ *  one, so the flux (V1 / f) is constant, and the RMS current at a third of
+ *  the base frequency drops to about a third; the quadratic curve gives a
+ *  quarter of the voltage at half the base frequency; the boost lifts the
+ *  linear curve by its voltage faded towards the base frequency.
+ *
+ * Build and run from the repository root:
+ *  gcc -m32 -O2 -I. -ITools -o Tools/vf_load_sim.out Tools/VfLoadSim.c Tools/HostTarget.c -lm
+ *      Source/Main/PwmOutputController.c Source/Main/SineTable.c Source/Main/TonTableBank.c
+ *      Source/DeviceDrivers/PWM.c Source/DeviceDrivers/Timer1.c Source/DeviceDrivers/uDMA.c
+ *      Source/DeviceDrivers/Debug.c Source/DeviceDrivers/ADCSWTrigger.c Source/DeviceDrivers/ADCT0ATrigger.c Source/DeviceDrivers/Timer2.c
+ *      Source/Main/DriveAcquisition.c Source/DeviceDrivers/ADCT3ATrigger.c
+ *  Tools/vf_load_sim.out
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: GMAGRI
+ */
+
+#include "HostTarget.h"
+#include "Source/Main/PwmOutputController.h"
+#include "tm4c123gh6pm.h"
+#include <math.h>
+#include <stdio.h>
+
+#if PWM_OUTPUT_BACKEND != PWM_BACKEND_SYSTICK
+#error "The simulation drives the Systick backend"
+#endif
+
+/* The load, the magnetizing branch of a small induction motor seen from the bridge */
+#define BUS_VOLTAGE 300.0   // {V}
+#define LOAD_R 2.0          // {ohm}
+#define LOAD_L 0.1          // {H}
+/* The base frequency of the curves {Hz} */
+#define BASE_FREQUENCY 90
+/* The sine waves left for the current to settle, about 10 L/R, and the ones measured */
+#define SETTLE_SINE_WAVES 20
+#define MEASURE_SINE_WAVES 10
+
+/* The internals of the controller under check */
+void SysTick_Handler(void);
+void PendSV_Handler(void);
+
+/* What one run measured */
+typedef struct
+{
+    double voltage;  // the fundamental of the load voltage {V peak}
+    double current;  // the RMS of the load current {A}
+} Result;
+
+static double _current = 0;
+
+/* One Systick Interrupt, followed by the PendSV when it was pended, and one step of the load */
+static double Tick(void)
+{
+    double voltage;
+
+    SysTick_Handler();
+    if(NVIC_INT_CTRL_R & NVIC_INT_CTRL_PEND_SV)
+    {
+        NVIC_INT_CTRL_R &= ~NVIC_INT_CTRL_PEND_SV;
+        PendSV_Handler();
+    }
+
+    voltage = BUS_VOLTAGE * ((GPIO_PORTB_DATA_BITS_R[0x01] ? 1 : 0) - (GPIO_PORTB_DATA_BITS_R[0x02] ? 1 : 0));
+    _current += (voltage - (LOAD_R * _current)) / (LOAD_L * INTERRUPT_FREQ);
+
+    return voltage;
+}
+
+/* Output one frequency with one curve until the current settles, then measure it */
+static Result Run(VfCurve curve, unsigned short boost, unsigned short freq)
+{
+    /* A sine wave lasts 72 pwm cycles of whole Systick Interrupts */
+    unsigned long sineWave = PWM_CYCLE_WITHIN_FULL_SINE * (INTERRUPT_FREQ / (PWM_CYCLE_WITHIN_FULL_SINE * freq));
+    double omega = 2 * M_PI / sineWave;
+    double re = 0;
+    double im = 0;
+    double squares = 0;
+    double voltage;
+    unsigned long tick;
+    Result result;
+
+    PwmOuputController_SetVfCurve(curve, BASE_FREQUENCY, boost);
+    PwmOuputController_UpdateFrequency(freq);
+    PwmOuputController_Start();
+    _current = 0;
+
+    for(tick=0; tick<(SETTLE_SINE_WAVES * sineWave); tick++) Tick();
+    for(tick=0; tick<(MEASURE_SINE_WAVES * sineWave); tick++)
+    {
+        voltage = Tick();
+        re += voltage * cos(omega * tick);
+        im += voltage * sin(omega * tick);
+        squares += _current * _current;
+    }
+
+    PwmOuputController_Stop();
+    while(Control_GetMotorState() != SM_MOTOR_STOPPED) Tick();
+
+    result.voltage = 2 * sqrt((re * re) + (im * im)) / (MEASURE_SINE_WAVES * sineWave);
+    result.current = sqrt(squares / (MEASURE_SINE_WAVES * sineWave));
+    printf("%-9s boost %3u.%u %%  %2u Hz: V1 %6.1f V, V1/f %5.3f V/Hz, I %6.3f A RMS\n",
+           (curve == VF_CURVE_NONE) ? "none" : (curve == VF_CURVE_LINEAR) ? "linear" : "quadratic",
+           boost / 10, boost % 10, freq, result.voltage, result.voltage / freq, result.current);
+
+    return result;
+}
+
+/* Evaluate if a value is within a relative tolerance of the expected one */
+static bool Near(double value, double expected, double tolerance)
+{
+    return fabs(value - expected) <= (tolerance * fabs(expected));
+}
+
+int main(void)
+{
+    static const unsigned short frequencies[] = {30, 45, 60, 90};
+    Result none[4];
+    Result linear[4];
+    Result quadratic;
+    Result boosted;
+    int i;
+
+    HostTarget_Init();
+    PwmOuputController_Init(0);
+
+    for(i=0; i<4; i++) none[i] = Run(VF_CURVE_NONE, 0, frequencies[i]);
+    for(i=0; i<4; i++) linear[i] = Run(VF_CURVE_LINEAR, 0, frequencies[i]);
+    quadratic = Run(VF_CURVE_QUADRATIC, 0, BASE_FREQUENCY / 2);
+    boosted = Run(VF_CURVE_LINEAR, 50, BASE_FREQUENCY / 3);
+
+    for(i=0; i<4; i++)
+    {
+        HostTarget_Check(Near(none[i].voltage, BUS_VOLTAGE, 0.01), "without a curve the fundamental is the full bus at every frequency");
+        HostTarget_Check(Near(linear[i].voltage / frequencies[i], BUS_VOLTAGE / BASE_FREQUENCY, 0.01), "the linear curve keeps V1 / f constant");
+    }
+    printf("RMS current at %u Hz, linear / none: %.3f\n", frequencies[0], linear[0].current / none[0].current);
+    HostTarget_Check(Near(linear[0].current / none[0].current, 1.0 / 3.0, 0.02), "the linear curve draws a third of the current at a third of the base frequency");
+    HostTarget_Check(Near(quadratic.voltage, BUS_VOLTAGE / 4, 0.01), "the quadratic curve gives a quarter of the voltage at half the base frequency");
+    HostTarget_Check(Near(boosted.voltage, BUS_VOLTAGE * (0.05 + (0.95 / 3)), 0.01), "the boost lifts the linear curve");
+
+    return HostTarget_Result("VfLoadSim");
+}
@@ -0,0 +1,16 @@
+/*
+ * interrupt.h
+ *
+ * The host stand-in of the TivaWare driverlib calls used by this project,
+ *  implemented by HostTarget.c. The target build uses the real driverlib.
+ */
+
+#ifndef TOOLS_DRIVERLIB_INTERRUPT_H_
+#define TOOLS_DRIVERLIB_INTERRUPT_H_
+
+#include <stdbool.h>
+
+extern bool IntMasterEnable(void);
+extern bool IntMasterDisable(void);
+
+#endif /* TOOLS_DRIVERLIB_INTERRUPT_H_ */